@@ -22,7 +22,9 @@
 #include <DirectXMath.h>
 #include <string>
 
+#include "Util.h"
 #include "DPRect.h"
+#include "DPRegion.h"
 
 #include "PixelShader.h"
 #include "PixelShaderCursor.h"
@@ -116,7 +118,7 @@ typedef struct _THREAD_DATA
     INT OffsetY;
     PTR_INFO* PtrInfo;
     DX_RESOURCES DxRes;
-    DPRect* DirtyRegionTotal;
+    DPRegion* DirtyRegionTotal;
     bool WMRIgnoreVScreens;
 } THREAD_DATA;
 
@@ -20,6 +20,8 @@
 #include "WindowManager.h"
 #include "ThreadManager.h"
 #include "InterprocessMessaging.h"
+#include "IPCStats.h"
+#include "IPCRecorder.h"
 #include "ElevatedMode.h"
 #include "Logging.h"
 
@@ -58,6 +60,9 @@ HRESULT EnumOutputsExpectedErrors[] = {
                                           S_OK                                    // Terminate list with zero valued HRESULT
                                       };
 
+//Replays run unattended, so DisplayMsg() only logs while this is set
+bool g_IsReplayingIPC = false;
+
 
 //
 // Forward Declarations
@@ -65,7 +70,7 @@ HRESULT EnumOutputsExpectedErrors[] = {
 DWORD WINAPI CaptureThreadEntry(_In_ void* Param);
 LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
 bool SpawnProcessWithDefaultEnv(LPCWSTR application_name, LPWSTR commandline = nullptr);
-void ProcessCmdline(bool& use_elevated_mode, bool& cancel_startup);
+void ProcessCmdline(bool& use_elevated_mode, bool& cancel_startup, bool& ipc_record, std::string& ipc_replay_path, bool& ipc_ring_benchmark, bool& dirty_region_benchmark);
 bool DisplayInitError(vr::EVRInitError vr_init_error, vr::EVROverlayError vr_overlay_error, bool vr_input_success);
 
 //
@@ -160,7 +165,11 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
 
     bool use_elevated_mode = false;
     bool cancel_startup = false;
-    ProcessCmdline(use_elevated_mode, cancel_startup);
+    bool ipc_record = false;
+    std::string ipc_replay_path;
+    bool ipc_ring_benchmark = false;
+    bool dirty_region_benchmark = false;
+    ProcessCmdline(use_elevated_mode, cancel_startup, ipc_record, ipc_replay_path, ipc_ring_benchmark, dirty_region_benchmark);
 
     if (use_elevated_mode)
     {
@@ -175,6 +184,36 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
 
     DPLog_Init("DesktopPlus");
 
+    if (ipc_ring_benchmark)
+    {
+        //Measure IPC ring buffer throughput and exit
+        LOG_F(INFO, "Running IPC ring buffer benchmark...");
+        LOG_IF_F(WARNING, !IPCManager::RunRingBenchmark("DesktopPlus"), "Failed to run IPC ring buffer benchmark");
+        return 0;
+    }
+
+    if (dirty_region_benchmark)
+    {
+        //Measure and check dirty region merging and exit
+        LOG_F(INFO, "Running dirty region benchmark...");
+        LOG_IF_F(WARNING, !DPRegion::RunBenchmark("DesktopPlus"), "Dirty region benchmark failed");
+        return 0;
+    }
+
+    if ( (ipc_record) && (!IPCRecorder::Get().StartRecording("DesktopPlus")) )
+    {
+        LOG_F(WARNING, "Failed to start IPC recording");
+    }
+
+    //Keep replays from affecting a normally running Desktop+. Nothing is sent to other processes, and config and profile files are left alone
+    //Replaying still needs SteamVR as the overlay can't be set up otherwise, but it works without a headset when using SteamVR's null driver
+    if (!ipc_replay_path.empty())
+    {
+        g_IsReplayingIPC = true;
+        IPCManager::Get().SetIsolatedFromPeers(true);
+        ConfigManager::Get().SetSavingDisabled(true);
+    }
+
     INT SingleOutput = 0;
 
     // Synchronization
@@ -188,8 +227,11 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     // Window
     HWND WindowHandle = nullptr;
 
-    //Make sure only one instance is running
-    StopProcessByWindowClass(g_WindowClassNameDashboardApp);
+    //Make sure only one instance is running (replays run alongside it instead)
+    if (!g_IsReplayingIPC)
+    {
+        StopProcessByWindowClass(g_WindowClassNameDashboardApp);
+    }
 
     // Event used by the threads to signal an unexpected error and we want to quit the app
     UnexpectedErrorEvent = ::CreateEvent(nullptr, TRUE, FALSE, nullptr);
@@ -239,6 +281,14 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
         return 0;
     }
 
+    //Set up shared memory IPC before the window exists so other processes can use it right away
+    //Skipped for replays, which would otherwise take over the ring buffers of the running instance
+    if (!g_IsReplayingIPC)
+    {
+        IPCManager::Get().InitTransport(ipcpeer_dashboard_app);
+    }
+    IPCManager::Get().SetReceiveTimeBudget(g_IPCReceiveFrameBudgetUs);
+
     // Register class
     WNDCLASSEXW Wc;
     Wc.cbSize           = sizeof(WNDCLASSEXW);
@@ -251,7 +301,7 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     Wc.hCursor          = nullptr;
     Wc.hbrBackground    = nullptr;
     Wc.lpszMenuName     = nullptr;
-    Wc.lpszClassName    = g_WindowClassNameDashboardApp;
+    Wc.lpszClassName    = (g_IsReplayingIPC) ? g_WindowClassNameIPCReplay : g_WindowClassNameDashboardApp;
     Wc.hIconSm          = nullptr;
     if (!RegisterClassExW(&Wc))
     {
@@ -260,7 +310,7 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     }
 
     // Create window
-    WindowHandle = ::CreateWindowW(g_WindowClassNameDashboardApp, L"Desktop+ Overlay",
+    WindowHandle = ::CreateWindowW(Wc.lpszClassName, L"Desktop+ Overlay",
                                    0,
                                    0, 0,
                                    1, 1,
@@ -287,8 +337,8 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     RECT DeskBounds;
     UINT OutputCount;
 
-    //Start up UI process unless disabled or already running
-    if ( (!ConfigManager::GetValue(configid_bool_interface_no_ui)) && (!IPCManager::IsUIAppRunning()) )
+    //Start up UI process unless disabled, already running or replaying IPC messages
+    if ( (!ConfigManager::GetValue(configid_bool_interface_no_ui)) && (!IPCManager::IsUIAppRunning()) && (ipc_replay_path.empty()) )
     {
         std::wstring path = WStringConvertFromUTF8(ConfigManager::Get().GetApplicationPath().c_str()) + L"DesktopPlusUI.exe";
         SpawnProcessWithDefaultEnv(path.c_str());
@@ -379,6 +429,7 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                 if (DisplayInitError(std::get<vr::EVRInitError>(init_error), std::get<vr::EVROverlayError>(init_error), std::get<bool>(init_error)))
                 {
                     //An error message was displayed, abort
+                    LOG_IF_F(ERROR, g_IsReplayingIPC, "Failed to set up overlay for IPC replay. Make sure SteamVR is running (its null driver works without a headset)");
                     Ret = DUPL_RETURN_ERROR_UNEXPECTED;
                     break;
                 }
@@ -432,8 +483,31 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             }
 
         }
+        else if (!ipc_replay_path.empty()) //Replay recorded IPC messages once initialized and exit
+        {
+            LOG_F(INFO, "Replaying IPC recording \"%s\"...", ipc_replay_path.c_str());
+
+            if (!IPCRecorder::Replay(ipc_replay_path.c_str(), "DesktopPlus", [&](const MSG& replay_msg){ OutMgr.HandleIPCMessage(replay_msg); }))
+            {
+                LOG_F(ERROR, "Failed to replay IPC recording");
+            }
+
+            ipc_replay_path.clear();
+            ::PostQuitMessage(0);
+        }
         else //Present frame or handle events as fast as needed
         {
+            //Message queue is drained at this point, apply pending config changes and publish them for other threads
+            OutMgr.FlushPendingApplyStages();
+            ConfigManager::Get().PublishSnapshot();
+            OutMgr.PublishConfigMirror();
+
+            //Send messages queued since the last frame, before possibly waiting a while
+            OutMgr.GetInputSimulator().FlushElevatedModeInputBatch();
+            IPCManager::Get().FlushQueuedMessages();
+            IPCManager::Get().ResumeDeferredMessages();
+            DPBrowserAPIClient::Get().FlushQueuedCommands();
+
             if (WaitForSingleObjectEx(NewFrameProcessedEvent, OutMgr.GetMaxRefreshDelay(), FALSE) == WAIT_OBJECT_0)   //New frame
             {
                 ResetEvent(NewFrameProcessedEvent);
@@ -530,6 +604,13 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     //Do other shutdown steps, like undimming the dashboard if needed
     OutMgr.OnExit();
 
+    if (IPCStats::Get().IsEnabled())
+    {
+        IPCStats::Get().WriteDumpFile("DesktopPlus");
+    }
+
+    IPCRecorder::Get().StopRecording();
+
     //Kindly ask elevated mode process to quit if it exists
     if (HWND window = ::FindWindow(g_WindowClassNameElevatedMode, nullptr))
     {
@@ -559,6 +640,9 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
             {
                 bool mirror_reset_required = false;
 
+                //Process messages sent through the ring buffers before this, including ones deferred to the next frame
+                IPCManager::Get().ReceiveAllRingMessages(hWnd, [&](const MSG& ring_msg){ mirror_reset_required |= OutputManager::Get()->HandleIPCMessage(ring_msg); });
+
                 MSG msg;
                 // Process all custom window messages posted before this
                 while (PeekMessage(&msg, nullptr, 0xC000, 0xFFFF, PM_REMOVE))
@@ -639,7 +723,7 @@ bool SpawnProcessWithDefaultEnv(LPCWSTR application_name, LPWSTR commandline)
     return false;
 }
 
-void ProcessCmdline(bool& use_elevated_mode, bool& cancel_startup)
+void ProcessCmdline(bool& use_elevated_mode, bool& cancel_startup, bool& ipc_record, std::string& ipc_replay_path, bool& ipc_ring_benchmark, bool& dirty_region_benchmark)
 {
     //__argv and __argc are global vars set by system
     for (UINT i = 0; i < static_cast<UINT>(__argc); ++i)
@@ -662,6 +746,34 @@ void ProcessCmdline(bool& use_elevated_mode, bool& cancel_startup)
 
             cancel_startup = true;
         }
+        else if ((strcmp(__argv[i], "-IPCRecord")  == 0) ||
+                 (strcmp(__argv[i], "--IPCRecord") == 0) ||
+                 (strcmp(__argv[i], "/IPCRecord")  == 0))
+        {
+            ipc_record = true;
+        }
+        else if ((strcmp(__argv[i], "-IPCReplay")  == 0) ||
+                 (strcmp(__argv[i], "--IPCReplay") == 0) ||
+                 (strcmp(__argv[i], "/IPCReplay")  == 0))
+        {
+            //Take the following argument as path of the recording to replay
+            if (__argc > i + 1)
+            {
+                ipc_replay_path = __argv[i+1];
+            }
+        }
+        else if ((strcmp(__argv[i], "-IPCRingBenchmark")  == 0) ||
+                 (strcmp(__argv[i], "--IPCRingBenchmark") == 0) ||
+                 (strcmp(__argv[i], "/IPCRingBenchmark")  == 0))
+        {
+            ipc_ring_benchmark = true;
+        }
+        else if ((strcmp(__argv[i], "-DirtyRegionBenchmark")  == 0) ||
+                 (strcmp(__argv[i], "--DirtyRegionBenchmark") == 0) ||
+                 (strcmp(__argv[i], "/DirtyRegionBenchmark")  == 0))
+        {
+            dirty_region_benchmark = true;
+        }
     }
 }
 
@@ -994,7 +1106,7 @@ void DisplayMsg(_In_ LPCWSTR str, _In_ LPCWSTR title, HRESULT hr)
     VLOG_F((SUCCEEDED(hr)) ? loguru::Verbosity_INFO : loguru::Verbosity_ERROR, str_u8.c_str());
 
     //While we always try to send error messages to the UI app to have it display in VR, show the message on the desktop if UI is not running or VR isn't loaded
-    if ((!IPCManager::IsUIAppRunning()) || (vr::VROverlay() == nullptr))
+    if ( (!g_IsReplayingIPC) && ((!IPCManager::IsUIAppRunning()) || (vr::VROverlay() == nullptr)) )
     {
         ::MessageBoxW(nullptr, str, title, MB_OK);
     }
@@ -56,7 +56,7 @@ void DISPLAYMANAGER::InitD3D(DX_RESOURCES* Data)
 //
 // Process a given frame and its metadata
 //
-DUPL_RETURN DISPLAYMANAGER::ProcessFrame(_In_ FRAME_DATA* Data, _Inout_ ID3D11Texture2D* SharedSurf, INT OffsetX, INT OffsetY, _In_ DXGI_OUTPUT_DESC* DeskDesc, _Inout_ DPRect& DirtyRectTotal)
+DUPL_RETURN DISPLAYMANAGER::ProcessFrame(_In_ FRAME_DATA* Data, _Inout_ ID3D11Texture2D* SharedSurf, INT OffsetX, INT OffsetY, _In_ DXGI_OUTPUT_DESC* DeskDesc, _Inout_ DPRegion& DirtyRegionTotal)
 {
     DUPL_RETURN Ret = DUPL_RETURN_SUCCESS;
 
@@ -68,7 +68,7 @@ DUPL_RETURN DISPLAYMANAGER::ProcessFrame(_In_ FRAME_DATA* Data, _Inout_ ID3D11Te
 
         if (Data->MoveCount)
         {
-            Ret = CopyMove(SharedSurf, reinterpret_cast<DXGI_OUTDUPL_MOVE_RECT*>(Data->MetaData), Data->MoveCount, OffsetX, OffsetY, DeskDesc, Desc.Width, Desc.Height, DirtyRectTotal);
+            Ret = CopyMove(SharedSurf, reinterpret_cast<DXGI_OUTDUPL_MOVE_RECT*>(Data->MetaData), Data->MoveCount, OffsetX, OffsetY, DeskDesc, Desc.Width, Desc.Height, DirtyRegionTotal);
             if (Ret != DUPL_RETURN_SUCCESS)
             {
                 return Ret;
@@ -78,7 +78,7 @@ DUPL_RETURN DISPLAYMANAGER::ProcessFrame(_In_ FRAME_DATA* Data, _Inout_ ID3D11Te
         if (Data->DirtyCount)
         {
             Ret = CopyDirty(Data->Frame, SharedSurf, reinterpret_cast<RECT*>(Data->MetaData + (Data->MoveCount * sizeof(DXGI_OUTDUPL_MOVE_RECT))), Data->DirtyCount, OffsetX, OffsetY, DeskDesc, 
-                            DirtyRectTotal);
+                            DirtyRegionTotal);
         }
     }
 
@@ -163,7 +163,7 @@ void DISPLAYMANAGER::SetMoveRect(_Out_ RECT* SrcRect, _Out_ RECT* DestRect, _In_
 // Copy move rectangles
 //
 DUPL_RETURN DISPLAYMANAGER::CopyMove(_Inout_ ID3D11Texture2D* SharedSurf, _In_reads_(MoveCount) DXGI_OUTDUPL_MOVE_RECT* MoveBuffer, UINT MoveCount, INT OffsetX, INT OffsetY, _In_ DXGI_OUTPUT_DESC* DeskDesc,
-                                     INT TexWidth, INT TexHeight, _Inout_ DPRect& DirtyRectTotal)
+                                     INT TexWidth, INT TexHeight, _Inout_ DPRegion& DirtyRegionTotal)
 {
     D3D11_TEXTURE2D_DESC FullDesc;
     SharedSurf->GetDesc(&FullDesc);
@@ -215,9 +215,9 @@ DUPL_RETURN DISPLAYMANAGER::CopyMove(_Inout_ ID3D11Texture2D* SharedSurf, _In_re
 
         m_DeviceContext->CopySubresourceRegion(SharedSurf, 0, DestRect.left, DestRect.top, 0, m_MoveSurf, 0, &Box);
     
-        //Add rect to total dirty region rect
-        DPRect drect(DestRect.left, DestRect.top, (int)Box.right, (int)Box.bottom);
-        (DirtyRectTotal.GetTL().x == -1) ? DirtyRectTotal = drect : DirtyRectTotal.Add(drect);
+        //Add rect to total dirty region
+        DPRect drect(DestRect.left, DestRect.top, DestRect.left + int(Box.right - Box.left), DestRect.top + int(Box.bottom - Box.top));
+        DirtyRegionTotal.Add(drect);
         
     }
 
@@ -231,7 +231,7 @@ DUPL_RETURN DISPLAYMANAGER::CopyMove(_Inout_ ID3D11Texture2D* SharedSurf, _In_re
 #pragma warning(disable:__WARNING_USING_UNINIT_VAR) // false positives in SetDirtyVert due to tool bug
 
 void DISPLAYMANAGER::SetDirtyVert(_Out_writes_(NUMVERTICES) VERTEX* Vertices, _In_ RECT* Dirty, INT OffsetX, INT OffsetY, _In_ DXGI_OUTPUT_DESC* DeskDesc, _In_ D3D11_TEXTURE2D_DESC* FullDesc,
-                                  _In_ D3D11_TEXTURE2D_DESC* ThisDesc, _Inout_ DPRect& DirtyRectTotal)
+                                  _In_ D3D11_TEXTURE2D_DESC* ThisDesc, _Inout_ DPRegion& DirtyRegionTotal)
 {
     FLOAT CenterX = FullDesc->Width  / 2.0f;
     FLOAT CenterY = FullDesc->Height / 2.0f;
@@ -316,10 +316,10 @@ void DISPLAYMANAGER::SetDirtyVert(_Out_writes_(NUMVERTICES) VERTEX* Vertices, _I
     Vertices[3].TexCoord = Vertices[2].TexCoord;
     Vertices[4].TexCoord = Vertices[1].TexCoord;
 
-    //Add rect to total dirty region rect
+    //Add rect to total dirty region
     DPRect drect(DestDirty.left, DestDirty.top, DestDirty.right, DestDirty.bottom);
     drect.Translate({DeskDesc->DesktopCoordinates.left - OffsetX, DeskDesc->DesktopCoordinates.top - OffsetY});
-    (DirtyRectTotal.GetTL().x == -1) ? DirtyRectTotal = drect : DirtyRectTotal.Add(drect);
+    DirtyRegionTotal.Add(drect);
 }
 
 #pragma warning(pop) // re-enable __WARNING_USING_UNINIT_VAR
@@ -328,7 +328,7 @@ void DISPLAYMANAGER::SetDirtyVert(_Out_writes_(NUMVERTICES) VERTEX* Vertices, _I
 // Copies dirty rectangles
 //
 DUPL_RETURN DISPLAYMANAGER::CopyDirty(_In_ ID3D11Texture2D* SrcSurface, _Inout_ ID3D11Texture2D* SharedSurf, _In_reads_(DirtyCount) RECT* DirtyBuffer, UINT DirtyCount, INT OffsetX, INT OffsetY, 
-                                      _In_ DXGI_OUTPUT_DESC* DeskDesc, _Inout_ DPRect& DirtyRectTotal)
+                                      _In_ DXGI_OUTPUT_DESC* DeskDesc, _Inout_ DPRegion& DirtyRegionTotal)
 {
     HRESULT hr;
 
@@ -393,7 +393,7 @@ DUPL_RETURN DISPLAYMANAGER::CopyDirty(_In_ ID3D11Texture2D* SrcSurface, _Inout_
     VERTEX* DirtyVertex = reinterpret_cast<VERTEX*>(m_DirtyVertexBufferAlloc);
     for (UINT i = 0; i < DirtyCount; ++i, DirtyVertex += NUMVERTICES)
     {
-        SetDirtyVert(DirtyVertex, &(DirtyBuffer[i]), OffsetX, OffsetY, DeskDesc, &FullDesc, &ThisDesc, DirtyRectTotal);
+        SetDirtyVert(DirtyVertex, &(DirtyBuffer[i]), OffsetX, OffsetY, DeskDesc, &FullDesc, &ThisDesc, DirtyRegionTotal);
     }
 
     // Create vertex buffer
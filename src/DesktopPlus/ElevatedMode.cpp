@@ -31,6 +31,9 @@ int ElevatedModeEnter(HINSTANCE hinstance)
 
     LOG_F(INFO, "Desktop+ running in elevated mode");
 
+    //Set up shared memory IPC. Ring buffers are created by the other processes, so this only opens them
+    IPCManager::Get().InitTransport(ipcpeer_elevated_mode);
+
     //Register class
     WNDCLASSEXW wc;
     wc.cbSize           = sizeof(WNDCLASSEXW);
@@ -73,6 +76,7 @@ int ElevatedModeEnter(HINSTANCE hinstance)
 
     //Wait for callbacks, update or quit message
     MSG msg;
+    UINT_PTR ipc_retry_timer_id = 0;
     while (::GetMessage(&msg, 0, 0, 0))
     {
         //Custom IPC messages
@@ -80,6 +84,21 @@ int ElevatedModeEnter(HINSTANCE hinstance)
         {
             HandleIPCMessage(msg);
         }
+        else if ( (msg.message == WM_TIMER) && (msg.hwnd == nullptr) && (msg.wParam == ipc_retry_timer_id) )
+        {
+            IPCManager::Get().ResumeDeferredMessages();
+        }
+
+        //There's no frame loop here, so retry deferred ring messages on a timer while there are any
+        if ( (IPCManager::Get().HasDeferredMessages()) && (ipc_retry_timer_id == 0) )
+        {
+            ipc_retry_timer_id = ::SetTimer(nullptr, 0, 100, nullptr);
+        }
+        else if ( (!IPCManager::Get().HasDeferredMessages()) && (ipc_retry_timer_id != 0) )
+        {
+            ::KillTimer(nullptr, ipc_retry_timer_id);
+            ipc_retry_timer_id = 0;
+        }
     }
 
     LOG_F(INFO, "Shutting down...");
@@ -106,6 +125,9 @@ LRESULT CALLBACK WndProcElevated(HWND hWnd, UINT message, WPARAM wParam, LPARAM
     {
         case WM_COPYDATA:
         {
+            //Process messages sent through the ring buffers before this
+            IPCManager::Get().ReceiveAllRingMessages(hWnd, [](const MSG& ring_msg){ HandleIPCMessage(ring_msg); });
+
             MSG msg;
             // Process all custom window messages posted before this
             while (::PeekMessage(&msg, nullptr, 0xC000, 0xFFFF, PM_REMOVE))
@@ -140,11 +162,18 @@ bool HandleIPCMessage(MSG msg)
     static std::string action_exe_path;
     static std::string action_exe_arg;
 
+    //Messages sent through the shared memory transport are only announced by the doorbell message
+    if (IPCManager::Get().GetIPCMessageID(msg.message) == ipcmsg_ring_doorbell)
+    {
+        IPCManager::Get().ReceiveRingMessages(msg, [](const MSG& ring_msg){ HandleIPCMessage(ring_msg); });
+        return true;
+    }
+
     //Input strings come as WM_COPYDATA
     if (msg.message == WM_COPYDATA)
     {
         //At least check if the dashboard app is running and the wParam is its window
-        HWND dashboard_app = ::FindWindow(g_WindowClassNameDashboardApp, nullptr);
+        HWND dashboard_app = IPCManager::Get().GetPeerWindow(ipcpeer_dashboard_app);
         if ((dashboard_app == nullptr) || ((HWND)msg.wParam != dashboard_app))
         {
             return false;
@@ -177,6 +206,29 @@ bool HandleIPCMessage(MSG msg)
                     action_exe_arg = copystr;
                     break;
                 }
+                case ipcestrid_input_batch:
+                {
+                    //Handle records like the action messages they stand for, but send all resulting input at once
+                    MSG action_msg = msg;
+                    action_msg.message = IPCManager::Get().GetWin32MessageID(ipcmsg_elevated_action);
+
+                    input_sim.BeginInputBatch();
+
+                    for (size_t pos = 0; pos + sizeof(IPCElevatedInputRecord) <= copystr.size(); pos += sizeof(IPCElevatedInputRecord))
+                    {
+                        IPCElevatedInputRecord record;
+                        memcpy(&record, copystr.data() + pos, sizeof(IPCElevatedInputRecord));
+
+                        action_msg.wParam = record.ActionID;
+                        action_msg.lParam = (LPARAM)record.Value;
+
+                        input_sim.SetInputTime(record.Time);
+                        HandleIPCMessage(action_msg);
+                    }
+
+                    input_sim.EndInputBatch();
+                    break;
+                }
             }
             
         }
@@ -78,17 +78,23 @@ void InputSimulator::SetEventForMouseKeyCode(INPUT& input_event, unsigned char k
 
 bool InputSimulator::SetEventForKeyCode(INPUT& input_event, unsigned char keycode, bool down, bool skip_check)
 {
+    bool key_down = IsKeyDownInBatch(keycode);
+
     //Check if the mouse buttons are swapped as this also affects SendInput
     if ( ((keycode == VK_LBUTTON) || (keycode == VK_RBUTTON)) && (::GetSystemMetrics(SM_SWAPBUTTON) != 0) )
     {
         keycode = (keycode == VK_LBUTTON) ? VK_RBUTTON : VK_LBUTTON;
     }
 
-    bool key_down = (::GetAsyncKeyState(keycode) < 0);
-
     if ( (keycode == 0) || ((key_down == down) && (!skip_check)) )
         return false;
 
+    //Key state isn't updated until the batch is sent, so remember it for following checks
+    if (m_IsBatchingInput)
+    {
+        m_InputBatchKeyState[keycode] = (down) ? 2 : 1;
+    }
+
     if ((keycode <= 6) && (keycode != VK_CANCEL)) //Mouse buttons need to be handled differently
     {
         SetEventForMouseKeyCode(input_event, keycode, down);
@@ -166,11 +172,94 @@ void InputSimulator::CreatePenDeviceIfNeeded()
     }
 }
 
+void InputSimulator::InjectPenInput()
+{
+    //Pen input doesn't go through SendInput(), so send any batched events first to keep the order
+    SendInputBatch();
+
+    s_p_InjectSyntheticPointerInput(m_PenDevice, &m_PenState, 1);
+}
+
+void InputSimulator::SendInputEvents(INPUT* input_events, UINT count)
+{
+    for (UINT i = 0; i < count; ++i)
+    {
+        if (input_events[i].type == INPUT_MOUSE)
+        {
+            input_events[i].mi.time = m_InputTime;
+        }
+        else if (input_events[i].type == INPUT_KEYBOARD)
+        {
+            input_events[i].ki.time = m_InputTime;
+        }
+    }
+
+    if (m_IsBatchingInput)
+    {
+        m_InputBatch.insert(m_InputBatch.end(), input_events, input_events + count);
+    }
+    else if (count != 0)
+    {
+        ::SendInput(count, input_events, sizeof(INPUT));
+    }
+}
+
+void InputSimulator::SendInputBatch()
+{
+    if (!m_InputBatch.empty())
+    {
+        ::SendInput((UINT)m_InputBatch.size(), m_InputBatch.data(), sizeof(INPUT));
+        m_InputBatch.clear();
+    }
+}
+
+void InputSimulator::ForwardToElevatedModeProcess(IPCElevatedActionID action_id, LPARAM l_param)
+{
+    IPCElevatedInputRecord record = {0};
+    record.Time     = ::GetTickCount();
+    record.ActionID = action_id;
+    record.Value    = l_param;
+
+    m_ElevatedModeInputBatch.push_back(record);
+
+    if (m_ElevatedModeInputBatch.size() >= g_IPCElevatedInputBatchRecordMax)
+    {
+        FlushElevatedModeInputBatch();
+    }
+}
+
+bool InputSimulator::IsKeyDownInBatch(unsigned char keycode) const
+{
+    if (m_IsBatchingInput)
+    {
+        //Generic modifier keys are never sent, only their left/right versions
+        switch (keycode)
+        {
+            case VK_SHIFT:   return ( (IsKeyDownInBatch(VK_LSHIFT))   || (IsKeyDownInBatch(VK_RSHIFT)) );
+            case VK_CONTROL: return ( (IsKeyDownInBatch(VK_LCONTROL)) || (IsKeyDownInBatch(VK_RCONTROL)) );
+            case VK_MENU:    return ( (IsKeyDownInBatch(VK_LMENU))    || (IsKeyDownInBatch(VK_RMENU)) );
+            default:         break;
+        }
+
+        //Same swap as in IsKeyDown(), as the batch key state is stored after it
+        unsigned char keycode_swapped = keycode;
+        if ( ((keycode == VK_LBUTTON) || (keycode == VK_RBUTTON)) && (::GetSystemMetrics(SM_SWAPBUTTON) != 0) )
+        {
+            keycode_swapped = (keycode == VK_LBUTTON) ? VK_RBUTTON : VK_LBUTTON;
+        }
+
+        if (m_InputBatchKeyState[keycode_swapped] != 0)
+            return (m_InputBatchKeyState[keycode_swapped] == 2);
+    }
+
+    return IsKeyDown(keycode);
+}
+
 void InputSimulator::RefreshScreenOffsets()
 {
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_refresh);
+        ForwardToElevatedModeProcess(ipceact_refresh);
     }
 
     m_SpaceMaxX = GetSystemMetrics(SM_CXVIRTUALSCREEN);
@@ -187,7 +276,7 @@ void InputSimulator::MouseMove(int x, int y)
 {
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_mouse_move, MAKELPARAM(x, y));
+        ForwardToElevatedModeProcess(ipceact_mouse_move, MAKELPARAM(x, y));
         return;
     }
 
@@ -198,7 +287,7 @@ void InputSimulator::MouseMove(int x, int y)
     input_event.mi.dy      = LONG((y + m_SpaceOffsetY) * m_SpaceMultiplierY);
     input_event.mi.dwFlags = MOUSEEVENTF_MOVE | MOUSEEVENTF_VIRTUALDESK | MOUSEEVENTF_ABSOLUTE;
     
-    ::SendInput(1, &input_event, sizeof(INPUT));
+    SendInputEvents(&input_event, 1);
 }
 
 void InputSimulator::MouseSetLeftDown(bool down)
@@ -220,7 +309,7 @@ void InputSimulator::MouseWheelHorizontal(float delta)
 {
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_mouse_hwheel, pun_cast<LPARAM, float>(delta));
+        ForwardToElevatedModeProcess(ipceact_mouse_hwheel, pun_cast<LPARAM, float>(delta));
         return;
     }
 
@@ -230,14 +319,14 @@ void InputSimulator::MouseWheelHorizontal(float delta)
     input_event.mi.dwFlags   = MOUSEEVENTF_HWHEEL;
     input_event.mi.mouseData = DWORD(WHEEL_DELTA * delta);
 
-    ::SendInput(1, &input_event, sizeof(INPUT));
+    SendInputEvents(&input_event, 1);
 }
 
 void InputSimulator::MouseWheelVertical(float delta)
 {
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_mouse_vwheel, pun_cast<LPARAM, float>(delta));
+        ForwardToElevatedModeProcess(ipceact_mouse_vwheel, pun_cast<LPARAM, float>(delta));
         return;
     }
 
@@ -247,7 +336,7 @@ void InputSimulator::MouseWheelVertical(float delta)
     input_event.mi.dwFlags   = MOUSEEVENTF_WHEEL;
     input_event.mi.mouseData = DWORD(WHEEL_DELTA * delta);
 
-    ::SendInput(1, &input_event, sizeof(INPUT));
+    SendInputEvents(&input_event, 1);
 }
 
 void InputSimulator::PenMove(int x, int y)
@@ -257,7 +346,7 @@ void InputSimulator::PenMove(int x, int y)
 
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_pen_move, MAKELPARAM(x, y));
+        ForwardToElevatedModeProcess(ipceact_pen_move, MAKELPARAM(x, y));
         return;
     }
 
@@ -269,7 +358,7 @@ void InputSimulator::PenMove(int x, int y)
     m_PenState.penInfo.pointerInfo.ptPixelLocation.x = clamp(x + m_SpaceOffsetX, 0, m_SpaceMaxX);
     m_PenState.penInfo.pointerInfo.ptPixelLocation.y = clamp(y + m_SpaceOffsetY, 0, m_SpaceMaxY);
 
-    s_p_InjectSyntheticPointerInput(m_PenDevice, &m_PenState, 1);
+    InjectPenInput();
 }
 
 void InputSimulator::PenSetPrimaryDown(bool down)
@@ -279,7 +368,7 @@ void InputSimulator::PenSetPrimaryDown(bool down)
 
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, (down) ? ipceact_pen_button_down : ipceact_pen_button_up, 0);
+        ForwardToElevatedModeProcess((down) ? ipceact_pen_button_down : ipceact_pen_button_up, 0);
         return;
     }
 
@@ -299,7 +388,7 @@ void InputSimulator::PenSetPrimaryDown(bool down)
 
     m_PenState.penInfo.pointerInfo.pointerFlags &= ~POINTER_FLAG_UPDATE;
 
-    s_p_InjectSyntheticPointerInput(m_PenDevice, &m_PenState, 1);
+    InjectPenInput();
 
     m_PenState.penInfo.pointerInfo.pointerFlags &= ~(POINTER_FLAG_DOWN | POINTER_FLAG_UP);
     m_PenState.penInfo.pointerInfo.ButtonChangeType = POINTER_CHANGE_NONE;
@@ -312,7 +401,7 @@ void InputSimulator::PenSetSecondaryDown(bool down)
 
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, (down) ? ipceact_pen_button_down : ipceact_pen_button_up, 1);
+        ForwardToElevatedModeProcess((down) ? ipceact_pen_button_down : ipceact_pen_button_up, 1);
         return;
     }
 
@@ -334,7 +423,7 @@ void InputSimulator::PenSetSecondaryDown(bool down)
 
     m_PenState.penInfo.pointerInfo.pointerFlags &= ~POINTER_FLAG_UPDATE;
 
-    s_p_InjectSyntheticPointerInput(m_PenDevice, &m_PenState, 1);
+    InjectPenInput();
 
     m_PenState.penInfo.pointerInfo.pointerFlags &= ~(POINTER_FLAG_DOWN | POINTER_FLAG_UP);
     m_PenState.penInfo.pointerInfo.ButtonChangeType = POINTER_CHANGE_NONE;
@@ -347,7 +436,7 @@ void InputSimulator::PenLeave()
 
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_pen_leave);
+        ForwardToElevatedModeProcess(ipceact_pen_leave);
         return;
     }
 
@@ -359,7 +448,7 @@ void InputSimulator::PenLeave()
         m_PenState.penInfo.pointerInfo.ButtonChangeType = POINTER_CHANGE_NONE;
         m_PenState.penInfo.penFlags = 0;
 
-        s_p_InjectSyntheticPointerInput(m_PenDevice, &m_PenState, 1);
+        InjectPenInput();
     }
 }
 
@@ -373,7 +462,7 @@ void InputSimulator::KeyboardSetDown(unsigned char keycode)
         LPARAM elevated_keycodes = 0;
         memcpy(&elevated_keycodes, &keycode, 1);
 
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_key_down, elevated_keycodes);
+        ForwardToElevatedModeProcess(ipceact_key_down, elevated_keycodes);
         return;
     }
 
@@ -381,7 +470,7 @@ void InputSimulator::KeyboardSetDown(unsigned char keycode)
 
     if (SetEventForKeyCode(input_event, keycode, true))
     {
-        ::SendInput(1, &input_event, sizeof(INPUT));
+        SendInputEvents(&input_event, 1);
     }
 }
 
@@ -400,7 +489,7 @@ void InputSimulator::KeyboardSetUp(unsigned char keycode)
         LPARAM elevated_keycodes = 0;
         memcpy(&elevated_keycodes, &keycode, 1);
 
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_key_up, elevated_keycodes);
+        ForwardToElevatedModeProcess(ipceact_key_up, elevated_keycodes);
         return;
     }
 
@@ -408,7 +497,7 @@ void InputSimulator::KeyboardSetUp(unsigned char keycode)
 
     if (SetEventForKeyCode(input_event, keycode, false))
     {
-        ::SendInput(1, &input_event, sizeof(INPUT));
+        SendInputEvents(&input_event, 1);
     }
 }
 
@@ -420,7 +509,7 @@ void InputSimulator::KeyboardSetDown(unsigned char keycodes[3])
         LPARAM elevated_keycodes = 0;
         memcpy(&elevated_keycodes, keycodes, 3);
 
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_key_down, elevated_keycodes);
+        ForwardToElevatedModeProcess(ipceact_key_down, elevated_keycodes);
         return;
     }
 
@@ -434,7 +523,7 @@ void InputSimulator::KeyboardSetDown(unsigned char keycodes[3])
 
     if (used_event_count != 0)
     {
-        ::SendInput(used_event_count, input_event, sizeof(INPUT));
+        SendInputEvents(input_event, used_event_count);
     }
 }
 
@@ -445,7 +534,7 @@ void InputSimulator::KeyboardSetUp(unsigned char keycodes[3])
         LPARAM elevated_keycodes = 0;
         memcpy(&elevated_keycodes, keycodes, 3);
 
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_key_up, elevated_keycodes);
+        ForwardToElevatedModeProcess(ipceact_key_up, elevated_keycodes);
         return;
     }
 
@@ -459,7 +548,7 @@ void InputSimulator::KeyboardSetUp(unsigned char keycodes[3])
 
     if (used_event_count != 0)
     {
-        ::SendInput(used_event_count, input_event, sizeof(INPUT));
+        SendInputEvents(input_event, used_event_count);
     }
 }
 
@@ -474,11 +563,11 @@ void InputSimulator::KeyboardToggleState(unsigned char keycode)
         LPARAM elevated_keycodes = 0;
         memcpy(&elevated_keycodes, &keycode, 1);
 
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_key_toggle, elevated_keycodes);
+        ForwardToElevatedModeProcess(ipceact_key_toggle, elevated_keycodes);
         return;
     }
 
-    if (IsKeyDown(keycode))  //If already pressed, release key
+    if (IsKeyDownInBatch(keycode))  //If already pressed, release key
     {
         KeyboardSetUp(keycode);
     }
@@ -495,7 +584,7 @@ void InputSimulator::KeyboardToggleState(unsigned char keycodes[3])
         LPARAM elevated_keycodes = 0;
         memcpy(&elevated_keycodes, keycodes, 3);
 
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_key_toggle, elevated_keycodes);
+        ForwardToElevatedModeProcess(ipceact_key_toggle, elevated_keycodes);
         return;
     }
 
@@ -504,12 +593,12 @@ void InputSimulator::KeyboardToggleState(unsigned char keycodes[3])
 
     for (int i = 0; i < 3; ++i)
     {
-        used_event_count += SetEventForKeyCode(input_event[used_event_count], keycodes[i], !IsKeyDown(keycodes[i]));
+        used_event_count += SetEventForKeyCode(input_event[used_event_count], keycodes[i], !IsKeyDownInBatch(keycodes[i]));
     }
 
     if (used_event_count != 0)
     {
-        ::SendInput(used_event_count, input_event, sizeof(INPUT));
+        SendInputEvents(input_event, used_event_count);
     }
 }
 
@@ -520,7 +609,7 @@ void InputSimulator::KeyboardPressAndRelease(unsigned char keycode)
 
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_key_press_and_release, keycode);
+        ForwardToElevatedModeProcess(ipceact_key_press_and_release, keycode);
         return;
     }
 
@@ -530,7 +619,7 @@ void InputSimulator::KeyboardPressAndRelease(unsigned char keycode)
     used_event_count += SetEventForKeyCode(input_event[used_event_count], keycode, true);
     used_event_count += SetEventForKeyCode(input_event[used_event_count], keycode, false);
 
-    ::SendInput(used_event_count, input_event, sizeof(INPUT));
+    SendInputEvents(input_event, used_event_count);
 }
 
 void InputSimulator::KeyboardSetToggleKey(unsigned char keycode, bool toggled)
@@ -540,7 +629,7 @@ void InputSimulator::KeyboardSetToggleKey(unsigned char keycode, bool toggled)
 
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_key_togglekey_set, MAKELPARAM(keycode, toggled));
+        ForwardToElevatedModeProcess(ipceact_key_togglekey_set, MAKELPARAM(keycode, toggled));
         return;
     }
 
@@ -556,23 +645,24 @@ void InputSimulator::KeyboardSetToggleKey(unsigned char keycode, bool toggled)
     used_event_count += SetEventForKeyCode(input_event[used_event_count], keycode, true,  true); //Press...
     used_event_count += SetEventForKeyCode(input_event[used_event_count], keycode, false, true); //...and release, even if the state wouldn't change (last arg)
 
-    ::SendInput(used_event_count, input_event, sizeof(INPUT));
+    SendInputEvents(input_event, used_event_count);
 }
 
 void InputSimulator::KeyboardSetFromWin32KeyState(unsigned short keystate, bool down)
 {
-    unsigned char keycode  = LOBYTE(keystate);
-    bool key_down = IsKeyDown(keycode);
-
-    if (key_down == down)
-        return; //Nothing to be done
-
+    //Forward before checking the key state. Forwarded input isn't tracked in this process' batch state, so the elevated mode process has to check it instead
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_keystate_w32_set, MAKELPARAM(keystate, down));
+        ForwardToElevatedModeProcess(ipceact_keystate_w32_set, MAKELPARAM(keystate, down));
         return;
     }
 
+    unsigned char keycode  = LOBYTE(keystate);
+    bool key_down = IsKeyDownInBatch(keycode);
+
+    if (key_down == down)
+        return; //Nothing to be done
+
     unsigned char flags = HIBYTE(keystate);
     bool flag_shift   = (flags & kbd_w32keystate_flag_shift_down);
     bool flag_ctrl    = (flags & kbd_w32keystate_flag_ctrl_down);
@@ -586,39 +676,39 @@ void InputSimulator::KeyboardSetFromWin32KeyState(unsigned short keystate, bool
     if (!flag_shift) 
     {
         //Try releasing both if any is down
-        if (IsKeyDown(VK_SHIFT))
+        if (IsKeyDownInBatch(VK_SHIFT))
         {
             used_event_count += SetEventForKeyCode(input_event[used_event_count], VK_LSHIFT, false);
             used_event_count += SetEventForKeyCode(input_event[used_event_count], VK_RSHIFT, false);
         }
     }
-    else if (!IsKeyDown(VK_SHIFT)) //Only set the left key if none are down
+    else if (!IsKeyDownInBatch(VK_SHIFT)) //Only set the left key if none are down
     {
         used_event_count += SetEventForKeyCode(input_event[used_event_count], VK_LSHIFT, true);
     }
 
     if (!flag_ctrl)
     { 
-        if (IsKeyDown(VK_CONTROL))
+        if (IsKeyDownInBatch(VK_CONTROL))
         {
             used_event_count += SetEventForKeyCode(input_event[used_event_count], VK_LCONTROL, false);
             used_event_count += SetEventForKeyCode(input_event[used_event_count], VK_RCONTROL, false);
         }
     }
-    else if (!IsKeyDown(VK_CONTROL))
+    else if (!IsKeyDownInBatch(VK_CONTROL))
     {
         used_event_count += SetEventForKeyCode(input_event[used_event_count], VK_LCONTROL, true);
     }
 
     if (!flag_alt)
     { 
-        if (IsKeyDown(VK_MENU))
+        if (IsKeyDownInBatch(VK_MENU))
         {
             used_event_count += SetEventForKeyCode(input_event[used_event_count], VK_LMENU, false);
             used_event_count += SetEventForKeyCode(input_event[used_event_count], VK_RMENU, false);
         }
     }
-    else if (!IsKeyDown(VK_MENU))
+    else if (!IsKeyDownInBatch(VK_MENU))
     {
         used_event_count += SetEventForKeyCode(input_event[used_event_count], VK_LMENU, true);
     }
@@ -636,7 +726,7 @@ void InputSimulator::KeyboardSetFromWin32KeyState(unsigned short keystate, bool
 
     if (used_event_count != 0)
     {
-        ::SendInput(used_event_count, input_event, sizeof(INPUT));
+        SendInputEvents(input_event, used_event_count);
     }
 }
 
@@ -644,7 +734,7 @@ void InputSimulator::KeyboardSetKeyState(IPCKeyboardKeystateFlags flags, unsigne
 {
     if (m_ForwardToElevatedModeProcess)
     {
-        IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_keystate_set, MAKELPARAM(flags, keycode));
+        ForwardToElevatedModeProcess(ipceact_keystate_set, MAKELPARAM(flags, keycode));
         return;
     }
 
@@ -693,7 +783,7 @@ void InputSimulator::KeyboardSetKeyState(IPCKeyboardKeystateFlags flags, unsigne
 
     if (used_event_count != 0)
     {
-        ::SendInput(used_event_count, input_event, sizeof(INPUT));
+        SendInputEvents(input_event, used_event_count);
     }
 }
 
@@ -705,6 +795,9 @@ void InputSimulator::KeyboardText(const char* str_utf8, bool always_use_unicode_
 
         if (outmgr != nullptr)
         {
+            //Strings are sent right away, so send input from before it first
+            FlushElevatedModeInputBatch();
+
             IPCElevatedStringID str_id = (always_use_unicode_event) ? ipcestrid_keyboard_text_force_unicode : ipcestrid_keyboard_text;
             IPCManager::Get().SendStringToElevatedModeProcess(str_id, str_utf8, outmgr->GetWindowHandle());
             m_ElevatedModeHasTextQueued = true;
@@ -734,7 +827,7 @@ void InputSimulator::KeyboardText(const char* str_utf8, bool always_use_unicode_
             m_KeyboardTextQueue.push_back(input_event);
         }
 
-        if (::GetAsyncKeyState(VK_SHIFT) < 0) //Release shift if it's down
+        if (IsKeyDownInBatch(VK_SHIFT)) //Release shift if it's down
         {
             input_event.ki.dwFlags = KEYEVENTF_KEYUP;
             input_event.ki.wVk = VK_SHIFT;
@@ -828,7 +921,7 @@ void InputSimulator::KeyboardTextFinish()
         //Only send if we know there is queued text in that process
         if (m_ElevatedModeHasTextQueued)
         {
-            IPCManager::Get().PostMessageToElevatedModeProcess(ipcmsg_elevated_action, ipceact_keyboard_text_finish);
+            ForwardToElevatedModeProcess(ipceact_keyboard_text_finish);
             m_ElevatedModeHasTextQueued = false;
         }
         return;
@@ -836,7 +929,7 @@ void InputSimulator::KeyboardTextFinish()
 
     if (!m_KeyboardTextQueue.empty())
     {
-        ::SendInput((UINT)m_KeyboardTextQueue.size(), m_KeyboardTextQueue.data(), sizeof(INPUT));
+        SendInputEvents(m_KeyboardTextQueue.data(), (UINT)m_KeyboardTextQueue.size());
 
         m_KeyboardTextQueue.clear();
     }
@@ -844,9 +937,47 @@ void InputSimulator::KeyboardTextFinish()
 
 void InputSimulator::SetElevatedModeForwardingActive(bool do_forward)
 {
+    if (!do_forward)
+    {
+        FlushElevatedModeInputBatch();
+    }
+
     m_ForwardToElevatedModeProcess = do_forward;
 }
 
+void InputSimulator::FlushElevatedModeInputBatch()
+{
+    if (m_ElevatedModeInputBatch.empty())
+        return;
+
+    if (OutputManager* outmgr = OutputManager::Get())
+    {
+        IPCManager::Get().SendInputBatchToElevatedModeProcess(m_ElevatedModeInputBatch, outmgr->GetWindowHandle());
+    }
+
+    m_ElevatedModeInputBatch.clear();
+}
+
+void InputSimulator::BeginInputBatch()
+{
+    m_IsBatchingInput = true;
+    m_InputBatch.clear();
+    memset(m_InputBatchKeyState, 0, sizeof(m_InputBatchKeyState));
+}
+
+void InputSimulator::EndInputBatch()
+{
+    SendInputBatch();
+
+    m_IsBatchingInput = false;
+    m_InputTime = 0;
+}
+
+void InputSimulator::SetInputTime(DWORD time)
+{
+    m_InputTime = time;
+}
+
 bool InputSimulator::IsKeyDown(unsigned char keycode)
 {
     //Check if the mouse buttons are swapped
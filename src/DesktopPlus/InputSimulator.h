@@ -6,6 +6,8 @@
 
 #include <vector>
 
+#include "InterprocessMessaging.h"
+
 //Dashboard_Back exists, but not doesn't map to "Go Back" ...okay!
 #define Button_Dashboard_GoHome vr::k_EButton_IndexController_A
 #define Button_Dashboard_GoBack vr::k_EButton_IndexController_B
@@ -42,13 +44,25 @@ class InputSimulator
         std::vector<INPUT> m_KeyboardTextQueue;
         bool m_ForwardToElevatedModeProcess = false;
         bool m_ElevatedModeHasTextQueued    = false;
+        std::vector<IPCElevatedInputRecord> m_ElevatedModeInputBatch;
+
+        //Input batch state, see BeginInputBatch()
+        bool m_IsBatchingInput = false;
+        std::vector<INPUT> m_InputBatch;
+        unsigned char m_InputBatchKeyState[256] = {0};  //0 = not touched by batch, 1 = up, 2 = down
+        DWORD m_InputTime = 0;
 
         void CreatePenDeviceIfNeeded();
+        void InjectPenInput();
+        void SendInputEvents(INPUT* input_events, UINT count);    //Calls SendInput() or adds the events to the batch if there is one
+        void SendInputBatch();
+        void ForwardToElevatedModeProcess(IPCElevatedActionID action_id, LPARAM l_param = 0);
+        bool IsKeyDownInBatch(unsigned char keycode) const;         //Like IsKeyDown(), but takes events in the current input batch into account
 
         static void LoadPenFunctions();
         static void SetEventForMouseKeyCode(INPUT& input_event, unsigned char keycode, bool down);
         //Set the event if it would change key state. Returns if anything was written to input_event
-        static bool SetEventForKeyCode(INPUT& input_event, unsigned char keycode, bool down, bool skip_check = false);
+        bool SetEventForKeyCode(INPUT& input_event, unsigned char keycode, bool down, bool skip_check = false);
 
     public:
         InputSimulator();
@@ -82,6 +96,12 @@ class InputSimulator
         void KeyboardTextFinish();
 
         void SetElevatedModeForwardingActive(bool do_forward);
+        void FlushElevatedModeInputBatch();                         //Sends input collected for the elevated mode process. Should be called once per frame
+
+        //Collects input events until EndInputBatch() and sends them with a single SendInput() call. Used by the elevated mode process to replay input batches
+        void BeginInputBatch();
+        void EndInputBatch();
+        void SetInputTime(DWORD time);                              //Time stamp for following input events, 0 to let the system decide
 
         static bool IsPenSimulationSupported();
         static bool IsKeyDown(unsigned char keycode);
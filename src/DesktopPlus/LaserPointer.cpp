@@ -1009,7 +1009,7 @@ bool LaserPointer::IntersectionMaskHitTest(OverlayTextureSource texsource, vr::H
     {
         Vector2Int point(int(uv.v[0] * m_UIMouseScale.x), int((-uv.v[1] + 1.0f) * m_UIMouseScale.y));
 
-        for (const auto& rect : m_UIIntersectionMaskRects)
+        for (const auto& rect : m_UIIntersectionMask.GetRects())
         {
             if (rect.Contains(point))
             {
@@ -1024,13 +1024,7 @@ bool LaserPointer::IntersectionMaskHitTest(OverlayTextureSource texsource, vr::H
     return true;
 }
 
-void LaserPointer::UIIntersectionMaskAddRect(DPRect& rect)
+bool LaserPointer::UIIntersectionMaskApplyUpdate(const std::string& update)
 {
-    m_UIIntersectionMaskRectsPending.push_back(rect);
-}
-
-void LaserPointer::UIIntersectionMaskFinish()
-{
-    m_UIIntersectionMaskRects = m_UIIntersectionMaskRectsPending;
-    m_UIIntersectionMaskRectsPending.clear();
+    return m_UIIntersectionMask.ApplyUpdate(update);
 }
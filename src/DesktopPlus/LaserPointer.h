@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DPRect.h"
+#include "UIIntersectionMask.h"
 #include "Overlays.h"
 #include "openvr.h"
 
@@ -53,8 +54,7 @@ class LaserPointer
         vr::VROverlayHandle_t m_ForceTargetOverlayHandle;
 
         Vector2Int m_UIMouseScale;
-        std::vector<DPRect> m_UIIntersectionMaskRects;
-        std::vector<DPRect> m_UIIntersectionMaskRectsPending;
+        UIIntersectionMask m_UIIntersectionMask;
 
         void CreateDeviceOverlay(vr::TrackedDeviceIndex_t device_index);
         void UpdateDeviceOverlay(vr::TrackedDeviceIndex_t device_index);
@@ -78,8 +78,7 @@ class LaserPointer
 
         //ComputeOverlayIntersection() does not take intersection masks into account. It's a bit cumbersome, but we track the DDP/UI ones ourselves to get around that.
         bool IntersectionMaskHitTest(OverlayTextureSource texsource, vr::HmdVector2_t& uv) const;
-        void UIIntersectionMaskAddRect(DPRect& rect);
-        void UIIntersectionMaskFinish();
+        bool UIIntersectionMaskApplyUpdate(const std::string& update);     //Returns false if the UI application needs to send the full mask again
 
         LaserPointerActivationOrigin GetActivationOrigin() const;
         bool IsActive() const;
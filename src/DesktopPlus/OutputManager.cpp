@@ -24,9 +24,92 @@ using namespace DirectX;
 
 #include "DesktopPlusWinRT.h"
 #include "DPBrowserAPIClient.h"
+#include "ConfigDelta.h"
+#include "IPCRecorder.h"
 
 static OutputManager* g_OutputManager; //May not always exist, but there also should never be two, so this is fine
 
+//Overlay state values sent on ipcact_sync_config_state
+static const ConfigDeltaFilter g_ConfigDeltaFilterOverlayState =
+{
+    {},
+    {configid_int_overlay_state_content_width, configid_int_overlay_state_content_height},
+    {configid_float_overlay_state_brightness_extra_multiplier},
+    {configid_handle_overlay_state_overlay_handle},
+    {}
+};
+
+static const ConfigDeltaFilter g_ConfigDeltaFilterOverlayStateWinRT =
+{
+    {}, {}, {},
+    {configid_handle_overlay_state_winrt_hwnd},
+    {}
+};
+
+static const ConfigDeltaFilter g_ConfigDeltaFilterOverlayStateBrowser =
+{
+    {configid_bool_overlay_state_browser_nav_can_go_back, configid_bool_overlay_state_browser_nav_can_go_forward, configid_bool_overlay_state_browser_nav_is_loading},
+    {}, {}, {}, {}
+};
+
+//Apply stages depending on config values set by the UI. Values with side effects beyond these are still handled in HandleIPCMessage()
+static const std::pair<ConfigID_Bool, unsigned int> g_ApplyStageDependenciesBool[] =
+{
+    {configid_bool_overlay_enabled,                       apply_stage_transform},
+    {configid_bool_overlay_origin_hmd_floor_use_turning,  apply_stage_transform},
+    {configid_bool_overlay_crop_enabled,                  apply_stage_crop | apply_stage_transform | apply_stage_mouse_scale},
+    {configid_bool_overlay_3D_enabled,                    apply_stage_transform | apply_stage_3D_mode},
+    {configid_bool_overlay_3D_swapped,                    apply_stage_3D_mode},
+    {configid_bool_overlay_gazefade_enabled,              apply_stage_transform},
+    {configid_bool_overlay_input_enabled,                 apply_stage_mouse_input},
+    {configid_bool_overlay_update_invisible,              apply_stage_transform},
+    {configid_bool_input_mouse_render_intersection_blob,  apply_stage_mouse_input},
+    {configid_bool_input_mouse_scroll_smooth,             apply_stage_mouse_input},
+    {configid_bool_state_overlay_dragmode,                apply_stage_input_mode},
+    {configid_bool_state_overlay_selectmode,              apply_stage_input_mode},
+};
+
+static const std::pair<ConfigID_Int, unsigned int> g_ApplyStageDependenciesInt[] =
+{
+    {configid_int_overlay_display_mode,                     apply_stage_transform},
+    {configid_int_overlay_origin,                           apply_stage_transform},
+    {configid_int_overlay_crop_x,                           apply_stage_crop | apply_stage_transform | apply_stage_mouse_scale},
+    {configid_int_overlay_crop_y,                           apply_stage_crop | apply_stage_transform | apply_stage_mouse_scale},
+    {configid_int_overlay_crop_width,                       apply_stage_crop | apply_stage_transform | apply_stage_mouse_scale},
+    {configid_int_overlay_crop_height,                      apply_stage_crop | apply_stage_transform | apply_stage_mouse_scale},
+    {configid_int_overlay_3D_mode,                          apply_stage_transform | apply_stage_3D_mode},
+    {configid_int_overlay_update_limit_override_mode,       apply_stage_update_limiter},
+    {configid_int_overlay_update_limit_override_fps,        apply_stage_update_limiter},
+    {configid_int_input_mouse_dbl_click_assist_duration_ms, apply_stage_mouse_input},
+    {configid_int_performance_update_limit_mode,            apply_stage_update_limiter},
+    {configid_int_performance_update_limit_fps,             apply_stage_update_limiter},
+};
+
+static const std::pair<ConfigID_Float, unsigned int> g_ApplyStageDependenciesFloat[] =
+{
+    {configid_float_overlay_width,                    apply_stage_transform},
+    {configid_float_overlay_curvature,                apply_stage_transform},
+    {configid_float_overlay_opacity,                  apply_stage_transform},
+    {configid_float_overlay_brightness,               apply_stage_transform},
+    {configid_float_overlay_offset_right,             apply_stage_transform},
+    {configid_float_overlay_offset_up,                apply_stage_transform},
+    {configid_float_overlay_offset_forward,           apply_stage_transform},
+    {configid_float_overlay_update_limit_override_ms, apply_stage_update_limiter},
+    {configid_float_performance_update_limit_ms,      apply_stage_update_limiter},
+};
+
+template <typename T, size_t N>
+static unsigned int OutputManagerGetApplyStages(const std::pair<T, unsigned int> (&dependencies)[N], T configid)
+{
+    for (const auto& dependency : dependencies)
+    {
+        if (dependency.first == configid)
+            return dependency.second;
+    }
+
+    return 0;
+}
+
 OutputManager* OutputManager::Get()
 {
     return g_OutputManager;
@@ -68,7 +151,6 @@ OutputManager::OutputManager(HANDLE PauseDuplicationEvent, HANDLE ResumeDuplicat
     m_OutputPendingFullRefresh(false),
     m_OutputHDRAvailable(false),
     m_OutputInvalid(false),
-    m_OutputPendingDirtyRect{-1, -1, -1, -1},
     m_OutputAlphaCheckFailed(false),
     m_OutputAlphaChecksPending(0),
     m_OvrlHandleIcon(vr::k_ulOverlayHandleInvalid),
@@ -84,6 +166,10 @@ OutputManager::OutputManager(HANDLE PauseDuplicationEvent, HANDLE ResumeDuplicat
     m_OvrlTempDragStartTick(0),
     m_PendingDashboardDummyHeight(0.0f),
     m_LastApplyTransformTick(0),
+    m_PendingApplyStagesGlobal(0),
+    m_ConfigTransactionActive(false),
+    m_ConfigTransactionOverrideIDPrev(-1),
+    m_ConfigTransactionStartTick(0),
     m_MouseLastClickTick(0),
     m_MouseIgnoreMoveEvent(false),
     m_MouseCursorNeedsUpdate(false),
@@ -115,6 +201,12 @@ OutputManager::OutputManager(HANDLE PauseDuplicationEvent, HANDLE ResumeDuplicat
     //Initialize ConfigManager and set first launch state based on existence of config file (used to detect first launch in Steam version)
     m_IsFirstLaunch = !ConfigManager::Get().LoadConfigFromFile();
 
+    //Performance state values are only synced through the mirror if it's available
+    if (!m_ConfigMirror.Create(ipcpeer_dashboard_app))
+    {
+        LOG_F(WARNING, "Failed to create shared config mirror, falling back to config messages");
+    }
+
     g_OutputManager = this;
 }
 
@@ -728,7 +820,7 @@ std::tuple<vr::EVRInitError, vr::EVROverlayError, bool> OutputManager::InitOverl
 //
 // Update Overlay and handle events
 //
-DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect& DirtyRectTotal, bool NewFrame, bool SkipFrame)
+DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRegion& DirtyRegionTotal, bool NewFrame, bool SkipFrame)
 {
     if (HandleOpenVREvents())   //If quit event received, quit.
     {
@@ -783,7 +875,7 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
     DPRect mouse_rect = {PointerInfo->Position.x, PointerInfo->Position.y, int(PointerInfo->Position.x + PointerInfo->ShapeInfo.Width),
                          int(PointerInfo->Position.y + PointerInfo->ShapeInfo.Height)};
 
-    //If mouse state got updated, expand dirty rect to include old and new cursor regions
+    //If mouse state got updated, expand dirty region to include old and new cursor regions
     if ( (ConfigManager::GetValue(configid_bool_input_mouse_render_cursor)) && (m_MouseLastInfo.LastTimeStamp.QuadPart < PointerInfo->LastTimeStamp.QuadPart) )
     {
         //Only invalidate if position or shape changed, otherwise it would be a visually identical result
@@ -792,7 +884,7 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
         {
             if ( (PointerInfo->Visible) )
             {
-                (DirtyRectTotal.GetTL().x == -1) ? DirtyRectTotal = mouse_rect : DirtyRectTotal.Add(mouse_rect);
+                DirtyRegionTotal.Add(mouse_rect);
             }
 
             if (m_MouseLastInfo.Visible)
@@ -800,7 +892,7 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
                 DPRect mouse_rect_last(m_MouseLastInfo.Position.x, m_MouseLastInfo.Position.y, int(m_MouseLastInfo.Position.x + m_MouseLastInfo.ShapeInfo.Width),
                                        int(m_MouseLastInfo.Position.y + m_MouseLastInfo.ShapeInfo.Height));
 
-                (DirtyRectTotal.GetTL().x == -1) ? DirtyRectTotal = mouse_rect_last : DirtyRectTotal.Add(mouse_rect_last);
+                DirtyRegionTotal.Add(mouse_rect_last);
             }
         }
     }
@@ -810,7 +902,7 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
     if (SkipFrame)
     {
         //Collect dirty rects for the next time we render
-        (m_OutputPendingDirtyRect.GetTL().x == -1) ? m_OutputPendingDirtyRect = DirtyRectTotal : m_OutputPendingDirtyRect.Add(DirtyRectTotal);
+        m_OutputPendingDirtyRegion.Add(DirtyRegionTotal);
 
         //Remember if the cursor changed so it's updated the next time we actually render it
         if (PointerInfo->CursorShapeChanged)
@@ -823,9 +915,9 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
 
         return DUPL_RETURN_UPD_SUCCESS;
     }
-    else if (m_OutputPendingDirtyRect.GetTL().x != -1) //Add previously collected dirty rects if there are any
+    else if (!m_OutputPendingDirtyRegion.IsEmpty()) //Add previously collected dirty rects if there are any
     {
-        (DirtyRectTotal.GetTL().x == -1) ? DirtyRectTotal = m_OutputPendingDirtyRect : DirtyRectTotal.Add(m_OutputPendingDirtyRect);
+        DirtyRegionTotal.Add(m_OutputPendingDirtyRegion);
     }
 
     bool has_updated_overlay = false;
@@ -835,6 +927,9 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
 
     if (!m_OutputPendingFullRefresh)
     {
+        //Dirty rects are clipped to each cropping region they overlap, so space between separately cropped overlays isn't updated needlessly
+        DPRegion dirty_region_clipped;
+
         for (unsigned int i = 0; i < OverlayManager::Get().GetOverlayCount(); ++i)
         {
             const Overlay& overlay = OverlayManager::Get().GetOverlay(i);
@@ -843,7 +938,7 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
             {
                 const DPRect& cropping_region = overlay.GetValidatedCropRect();
 
-                if (DirtyRectTotal.Overlaps(cropping_region))
+                if (DirtyRegionTotal.Overlaps(cropping_region))
                 {
                     if (clipping_region.GetTL().x != -1)
                     {
@@ -853,16 +948,27 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
                     {
                         clipping_region = cropping_region;
                     }
+
+                    for (const DPRect& dirty_rect : DirtyRegionTotal)
+                    {
+                        if (dirty_rect.Overlaps(cropping_region))
+                        {
+                            DPRect dirty_rect_clipped = dirty_rect;
+                            dirty_rect_clipped.ClipWithFull(cropping_region);
+                            dirty_region_clipped.Add(dirty_rect_clipped);
+                        }
+                    }
                 }
             }
         }
 
-        DirtyRectTotal.ClipWithFull(clipping_region);
+        DirtyRegionTotal = dirty_region_clipped;
     }
     else   //Set dirty & clipping rect to total surface for full refresh
     {
-        DirtyRectTotal = {0, 0, m_DesktopWidth, m_DesktopHeight};
-        clipping_region = DirtyRectTotal;
+        clipping_region = {0, 0, m_DesktopWidth, m_DesktopHeight};
+        DirtyRegionTotal.Clear();
+        DirtyRegionTotal.Add(clipping_region);
         m_OutputPendingFullRefresh = false;
     }
 
@@ -870,17 +976,26 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
 
     if (clipping_region.GetTL().x != -1) //Overlapped with at least one overlay
     {
-        //Set scissor rect for overlay drawing function
-        const D3D11_RECT rect_scissor = { DirtyRectTotal.GetTL().x, DirtyRectTotal.GetTL().y, DirtyRectTotal.GetBR().x, DirtyRectTotal.GetBR().y };
-        m_DeviceContext->RSSetScissorRects(1, &rect_scissor);
+        //Only handle cursor if it's in cropping region
+        DPRect mouse_rect_clipped = mouse_rect;
+        const bool draw_mouse = DirtyRegionTotal.Overlaps(mouse_rect);
+
+        if (draw_mouse)
+        {
+            //Redraw the frame under the whole cursor so it can be drawn with a single scissor rect without blending over parts of itself left from a previous frame
+            mouse_rect_clipped.ClipWithFull(clipping_region);
+            DirtyRegionTotal.Add(mouse_rect_clipped);
+        }
 
         //Draw shared surface to overlay texture to avoid trouble with transparency on some systems
-        bool is_full_texture = DirtyRectTotal.Contains({0, 0, m_DesktopWidth, m_DesktopHeight});
-        DrawFrameToOverlayTex(is_full_texture);
+        bool is_full_texture = DirtyRegionTotal.Contains({0, 0, m_DesktopWidth, m_DesktopHeight});
+        DrawFrameToOverlayTex(is_full_texture, &DirtyRegionTotal);
 
-        //Only handle cursor if it's in cropping region
-        if (mouse_rect.Overlaps(DirtyRectTotal))
+        if (draw_mouse)
         {
+            const D3D11_RECT rect_scissor = { mouse_rect_clipped.GetTL().x, mouse_rect_clipped.GetTL().y, mouse_rect_clipped.GetBR().x, mouse_rect_clipped.GetBR().y };
+            m_DeviceContext->RSSetScissorRects(1, &rect_scissor);
+
             DrawMouseToOverlayTex(PointerInfo);
         }
         else if (PointerInfo->CursorShapeChanged) //But remember if the cursor changed for next time
@@ -889,7 +1004,7 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
         }
 
         //Set Overlay texture
-        ret = RefreshOpenVROverlayTexture(DirtyRectTotal);
+        ret = RefreshOpenVROverlayTexture(DirtyRegionTotal);
 
         //Reset scissor rect
         const D3D11_RECT rect_scissor_full = { 0, 0, m_DesktopWidth, m_DesktopHeight };
@@ -907,8 +1022,8 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
     m_MouseLastInfo.PtrShapeBuffer = nullptr; //Not used or copied properly so remove info to avoid confusion
     m_MouseLastInfo.BufferSize = 0;
 
-    //Reset dirty rect
-    DirtyRectTotal = DPRect(-1, -1, -1, -1);
+    //Reset dirty region
+    DirtyRegionTotal.Clear();
 
     // Release keyed mutex
     hr = m_KeyMutex->ReleaseSync(0);
@@ -924,7 +1039,7 @@ DUPL_RETURN_UPD OutputManager::Update(_In_ PTR_INFO* PointerInfo,  _In_ DPRect&
     }
 
     m_OutputPendingSkippedFrame = false;
-    m_OutputPendingDirtyRect = {-1, -1, -1, -1};
+    m_OutputPendingDirtyRegion.Clear();
 
     return ret;
 }
@@ -940,6 +1055,23 @@ void OutputManager::BusyUpdate()
 
 bool OutputManager::HandleIPCMessage(const MSG& msg)
 {
+    //Messages sent through the shared memory transport are only announced by the doorbell message
+    if (IPCManager::Get().GetIPCMessageID(msg.message) == ipcmsg_ring_doorbell)
+    {
+        bool reset_mirroring = false;
+        IPCManager::Get().ReceiveRingMessages(msg, [&](const MSG& ring_msg){ reset_mirroring |= HandleIPCMessage(ring_msg); });
+
+        return reset_mirroring;
+    }
+
+    IPCRecorder::Scope recorder_scope(msg);
+
+    //Config changes only invalidate apply stages, so apply them before anything that may depend on them or change overlay IDs
+    if (IPCManager::Get().GetIPCMessageID(msg.message) != ipcmsg_set_config)
+    {
+        FlushPendingApplyStages();
+    }
+
     //Handle messages sent by browser process in the APIClient
     if (msg.message == DPBrowserAPIClient::Get().GetRegisteredMessageID())
     {
@@ -1003,6 +1135,14 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                 default: break;
             }
         }
+        else if ( (pcds->dwData == g_IPCCopyDataIDUIMask) && (pcds->cbData <= g_IPCUIMaskSizeMax) )
+        {
+            //Deltas can't be applied if an earlier update was missed (e.g. after a restart), so ask for the full mask instead
+            if (!m_LaserPointer.UIIntersectionMaskApplyUpdate( std::string((char*)pcds->lpData, pcds->cbData) ))
+            {
+                IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_lpointer_ui_mask_resend);
+            }
+        }
 
         //Restore overlay id override
         if (overlay_override_id != -1)
@@ -1027,6 +1167,31 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                     reset_mirroring = true;
                     break;
                 }
+                case ipcact_config_transaction_begin:
+                {
+                    if (!m_ConfigTransactionActive)
+                    {
+                        m_ConfigTransactionOverrideIDPrev = ConfigManager::GetValue(configid_int_state_overlay_current_id_override);
+                    }
+
+                    m_ConfigTransactionActive    = true;
+                    m_ConfigTransactionStartTick = ::GetTickCount64();
+
+                    if (msg.lParam != -1)
+                    {
+                        ConfigManager::SetValue(configid_int_state_overlay_current_id_override, (int)msg.lParam);
+                    }
+                    break;
+                }
+                case ipcact_config_transaction_commit:
+                {
+                    if (m_ConfigTransactionActive)
+                    {
+                        EndConfigTransaction();
+                        FlushPendingApplyStages();
+                    }
+                    break;
+                }
                 case ipcact_overlay_position_reset:
                 {
                     DetachedTransformReset();
@@ -1233,13 +1398,13 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                             OnSetOverlayWinRTCaptureWindow(i);
 
                             //Send to UI
-                            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)i);
+                            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)i);
                             IPCManager::Get().PostConfigMessageToUIApp(configid_handle_overlay_state_winrt_hwnd, msg.lParam);
 
                             if (ConfigManager::GetValue(configid_int_windows_winrt_capture_lost_behavior) == window_caplost_hide_overlay)
                                 IPCManager::Get().PostConfigMessageToUIApp(configid_bool_overlay_enabled, true);
 
-                            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+                            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
                         }
                     }
                     break;
@@ -1273,49 +1438,44 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                 }
                 case ipcact_sync_config_state:
                 {
+                    //Send state differing from what a freshly started UI process has as a single delta instead of one message per value
+                    ConfigDelta delta;
+                    const OverlayConfigData data_default;
+
                     //Overlay state
                     for (unsigned int i = 0; i < OverlayManager::Get().GetOverlayCount(); ++i)
                     {
                         const Overlay& overlay        = OverlayManager::Get().GetOverlay(i);
                         const OverlayConfigData& data = OverlayManager::Get().GetConfigData(i);
 
-                        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)i);
-
-                        IPCManager::Get().PostConfigMessageToUIApp(configid_handle_overlay_state_overlay_handle,  data.ConfigHandle[configid_handle_overlay_state_overlay_handle]);
-
-                        IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_state_content_width,  data.ConfigInt[configid_int_overlay_state_content_width]);
-                        IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_state_content_height, data.ConfigInt[configid_int_overlay_state_content_height]);
+                        delta.AddOverlayDiff(i, data_default, data, &g_ConfigDeltaFilterOverlayState);
 
                         //Send over current HWND if there's an active capture
                         if ( (overlay.GetTextureSource() == ovrl_texsource_winrt_capture) && (data.ConfigHandle[configid_handle_overlay_state_winrt_hwnd] != 0))
                         {
-                            IPCManager::Get().PostConfigMessageToUIApp(configid_handle_overlay_state_winrt_hwnd, data.ConfigHandle[configid_handle_overlay_state_winrt_hwnd]);
+                            delta.AddOverlayDiff(i, data_default, data, &g_ConfigDeltaFilterOverlayStateWinRT);
                         }
                         else if (overlay.GetTextureSource() == ovrl_texsource_browser) //Send browser nav state if it's an active browser overlay
                         {
-                            IPCManager::Get().PostConfigMessageToUIApp(configid_bool_overlay_state_browser_nav_can_go_back,    data.ConfigBool[configid_bool_overlay_state_browser_nav_can_go_back]);
-                            IPCManager::Get().PostConfigMessageToUIApp(configid_bool_overlay_state_browser_nav_can_go_forward, data.ConfigBool[configid_bool_overlay_state_browser_nav_can_go_forward]);
-                            IPCManager::Get().PostConfigMessageToUIApp(configid_bool_overlay_state_browser_nav_is_loading,     data.ConfigBool[configid_bool_overlay_state_browser_nav_is_loading]);
+                            delta.AddOverlayDiff(i, data_default, data, &g_ConfigDeltaFilterOverlayStateBrowser);
                         }
-
-                        IPCManager::Get().PostConfigMessageToUIApp(configid_float_overlay_state_brightness_extra_multiplier, data.ConfigFloat[configid_float_overlay_state_brightness_extra_multiplier]);
-
-                        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
                     }
 
-                    //Global config state
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_interface_desktop_count,               ConfigManager::GetValue(configid_int_state_interface_desktop_count));
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_bool_state_overlay_dragmode,                     ConfigManager::GetValue(configid_bool_state_overlay_dragmode));
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_bool_state_overlay_selectmode,                   ConfigManager::GetValue(configid_bool_state_overlay_selectmode));
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_bool_state_overlay_dragselectmode_show_hidden,   ConfigManager::GetValue(configid_bool_state_overlay_dragselectmode_show_hidden));
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_bool_state_overlay_dragmode_temp,                ConfigManager::GetValue(configid_bool_state_overlay_dragmode_temp));
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_bool_state_pen_simulation_supported,             ConfigManager::GetValue(configid_bool_state_pen_simulation_supported));
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_bool_state_window_focused_process_elevated,      ConfigManager::GetValue(configid_bool_state_window_focused_process_elevated));
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_bool_state_misc_process_elevated,                ConfigManager::GetValue(configid_bool_state_misc_process_elevated));
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_bool_state_misc_process_started_by_steam,        ConfigManager::GetValue(configid_bool_state_misc_process_started_by_steam));
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_dplus_laser_pointer_device,            ConfigManager::GetValue(configid_int_state_dplus_laser_pointer_device));
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_handle_state_dplus_laser_pointer_target_overlay, ConfigManager::GetValue(configid_handle_state_dplus_laser_pointer_target_overlay));
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_handle_state_theater_orig_overlay_handle,        ConfigManager::GetValue(configid_handle_state_theater_orig_overlay_handle));
+                    //Global config state. The UI process' values aren't known here, so they're always sent
+                    delta.Add(configid_int_state_interface_desktop_count,               ConfigManager::GetValue(configid_int_state_interface_desktop_count));
+                    delta.Add(configid_bool_state_overlay_dragmode,                     ConfigManager::GetValue(configid_bool_state_overlay_dragmode));
+                    delta.Add(configid_bool_state_overlay_selectmode,                   ConfigManager::GetValue(configid_bool_state_overlay_selectmode));
+                    delta.Add(configid_bool_state_overlay_dragselectmode_show_hidden,   ConfigManager::GetValue(configid_bool_state_overlay_dragselectmode_show_hidden));
+                    delta.Add(configid_bool_state_overlay_dragmode_temp,                ConfigManager::GetValue(configid_bool_state_overlay_dragmode_temp));
+                    delta.Add(configid_bool_state_pen_simulation_supported,             ConfigManager::GetValue(configid_bool_state_pen_simulation_supported));
+                    delta.Add(configid_bool_state_window_focused_process_elevated,      ConfigManager::GetValue(configid_bool_state_window_focused_process_elevated));
+                    delta.Add(configid_bool_state_misc_process_elevated,                ConfigManager::GetValue(configid_bool_state_misc_process_elevated));
+                    delta.Add(configid_bool_state_misc_process_started_by_steam,        ConfigManager::GetValue(configid_bool_state_misc_process_started_by_steam));
+                    delta.Add(configid_int_state_dplus_laser_pointer_device,            ConfigManager::GetValue(configid_int_state_dplus_laser_pointer_device));
+                    delta.Add(configid_handle_state_dplus_laser_pointer_target_overlay, ConfigManager::GetValue(configid_handle_state_dplus_laser_pointer_target_overlay));
+                    delta.Add(configid_handle_state_theater_orig_overlay_handle,        ConfigManager::GetValue(configid_handle_state_theater_orig_overlay_handle));
+
+                    IPCManager::Get().SendConfigDeltaToUIApp(delta, m_WindowHandle);
 
                     //Sync usually means new UI process, so get new handles
                     m_LaserPointer.RefreshCachedOverlayHandles();
@@ -1378,20 +1538,6 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                     m_LaserPointer.TriggerLaserPointerHaptics((vr::TrackedDeviceIndex_t)msg.lParam);
                     break;
                 }
-                case ipcact_lpointer_ui_mask_rect:
-                {
-                    if (msg.lParam == -1)
-                    {
-                        m_LaserPointer.UIIntersectionMaskFinish();
-                    }
-                    else
-                    {
-                        DPRect rect;
-                        rect.Unpack16(msg.lParam);
-                        m_LaserPointer.UIIntersectionMaskAddRect(rect);
-                    }
-                    break;
-                }
                 case ipcact_app_profile_remove:
                 {
                     const bool loaded_overlay_profile = ConfigManager::Get().GetAppProfileManager().RemoveProfile(ConfigManager::GetValue(configid_str_state_app_profile_key));
@@ -1452,19 +1598,13 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                 bool previous_value = ConfigManager::GetValue(bool_id);
                 ConfigManager::SetValue(bool_id, msg.lParam);
 
+                if (ConfigManager::GetValue(bool_id) != previous_value)
+                {
+                    InvalidateApplyStages(OutputManagerGetApplyStages(g_ApplyStageDependenciesBool, bool_id));
+                }
+
                 switch (bool_id)
                 {
-                    case configid_bool_overlay_3D_enabled:
-                    {
-                        ApplySettingTransform();
-                        ApplySetting3DMode();
-                        break;
-                    }
-                    case configid_bool_overlay_3D_swapped:
-                    {
-                        ApplySetting3DMode();
-                        break;
-                    }
                     case configid_bool_overlay_origin_hmd_floor_use_turning:
                     {
                         const OverlayConfigData& data = OverlayManager::Get().GetCurrentConfigData();
@@ -1475,21 +1615,6 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                         OverlayOrigin origin = (OverlayOrigin)data.ConfigInt[configid_int_overlay_origin];
 
                         DetachedTransformConvertOrigin(OverlayManager::Get().GetCurrentOverlayID(), origin, origin, origin_config_prev, origin_config);
-                        ApplySettingTransform();
-                        break;
-                    }
-                    case configid_bool_overlay_enabled:
-                    case configid_bool_overlay_gazefade_enabled:
-                    case configid_bool_overlay_update_invisible:
-                    {
-                        ApplySettingTransform();
-                        break;
-                    }
-                    case configid_bool_overlay_crop_enabled:
-                    {
-                        ApplySettingCrop();
-                        ApplySettingTransform();
-                        ApplySettingMouseScale();
                         break;
                     }
                     case configid_bool_overlay_winrt_window_matching_strict:
@@ -1525,12 +1650,6 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                         }
                         break;
                     }
-                    case configid_bool_overlay_input_enabled:
-                    case configid_bool_input_mouse_render_intersection_blob:
-                    {
-                        ApplySettingMouseInput();
-                        break;
-                    }
                     case configid_bool_input_mouse_allow_pointer_override:
                     {
                         //Reset Pointer override
@@ -1539,7 +1658,7 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                             m_MouseIgnoreMoveEvent = false;
 
                             ResetMouseLastLaserPointerPos();
-                            ApplySettingMouseInput();
+                            InvalidateApplyStages(apply_stage_mouse_input);
                         }
                         break;
                     }
@@ -1573,11 +1692,6 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
 
                         break;
                     }
-                    case configid_bool_input_mouse_scroll_smooth:
-                    {
-                        ApplySettingMouseInput();
-                        break;
-                    }
                     case configid_bool_input_laser_pointer_block_input:
                     {
                         //Set SteamVR setting to allow global overlay input as we need it for this to work. Messing with user settings is not ideal, but we're not the first to do so
@@ -1610,18 +1724,14 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                         {
                             m_OverlayDragger.UpdateTempStandingPosition();
                         }
-
-                        ApplySettingInputMode();
-                        break;
-                    }
-                    case configid_bool_state_overlay_selectmode:
-                    {
-                        ApplySettingInputMode();
                         break;
                     }
                     case configid_bool_state_misc_elevated_mode_active:
                     {
                         m_InputSim.SetElevatedModeForwardingActive(msg.lParam);
+
+                        //Elevated mode process was started or stopped, don't rely on the cached window from a previous one
+                        IPCManager::Get().InvalidatePeerWindow(ipcpeer_elevated_mode);
                         break;
                     }
                     default: break;
@@ -1634,6 +1744,11 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                 int previous_value = ConfigManager::GetValue(int_id);
                 ConfigManager::SetValue(int_id, msg.lParam);
 
+                if (ConfigManager::GetValue(int_id) != previous_value)
+                {
+                    InvalidateApplyStages(OutputManagerGetApplyStages(g_ApplyStageDependenciesInt, int_id));
+                }
+
                 switch (int_id)
                 {
                     case configid_int_interface_overlay_current_id:
@@ -1657,10 +1772,7 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                         else //Don't touch cropping setting values if it's disabled and just update the validated crop rect instead
                         {
                             OverlayManager::Get().GetCurrentOverlay().UpdateValidatedCropRect();        
-                            ApplySettingCrop();
-                            ApplySettingTransform();
-                            ApplySettingMouseScale();
-                            ApplySettingExtraBrightness();
+                            InvalidateApplyStages(apply_stage_crop | apply_stage_transform | apply_stage_mouse_scale | apply_stage_extra_brightness);
                         }
 
                         reset_mirroring = (ConfigManager::GetValue(configid_bool_performance_single_desktop_mirroring) && (msg.lParam != previous_value));
@@ -1698,14 +1810,14 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                             //Update crop as it depends on user size
                             if ((ConfigManager::GetValue(configid_bool_overlay_crop_enabled)) || (ConfigManager::GetValue(configid_bool_overlay_3D_enabled)))
                             {
-                                ApplySettingCrop();
+                                InvalidateApplyStages(apply_stage_crop);
                             }
 
                             //Send to UI
-                            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)OverlayManager::Get().GetCurrentOverlayID());
+                            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)OverlayManager::Get().GetCurrentOverlayID());
                             IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_state_content_width,  user_width);
                             IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_state_content_height, user_height);
-                            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+                            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
 
                             //Also do it for everything using this as duplication source
                             unsigned int current_overlay_old = OverlayManager::Get().GetCurrentOverlayID();
@@ -1719,47 +1831,25 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                                 ConfigManager::SetValue(configid_int_overlay_state_content_width,  user_width);
                                 ConfigManager::SetValue(configid_int_overlay_state_content_height, user_height);
 
-                                IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)overlay_id);
+                                IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)overlay_id);
                                 IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_state_content_width,  user_width);
                                 IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_state_content_height, user_height);
-                                IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+                                IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
 
                                 if (ConfigManager::GetValue(configid_bool_overlay_crop_enabled))
                                 {
-                                    ApplySettingCrop();
+                                    InvalidateApplyStages(apply_stage_crop);
                                 }
                             }
                             OverlayManager::Get().SetCurrentOverlayID(current_overlay_old);
 
-                            ApplySettingMouseInput();
+                            InvalidateApplyStages(apply_stage_mouse_input);
                         }
                         break;
                     }
-                    case configid_int_overlay_crop_x:
-                    case configid_int_overlay_crop_y:
-                    case configid_int_overlay_crop_width:
-                    case configid_int_overlay_crop_height:
-                    {
-                        ApplySettingCrop();
-                        ApplySettingTransform();
-                        ApplySettingMouseScale();
-                        break;
-                    }
-                    case configid_int_overlay_3D_mode:
-                    {
-                        ApplySettingTransform();
-                        ApplySetting3DMode();
-                        break;
-                    }
-                    case configid_int_overlay_display_mode:
-                    {
-                        ApplySettingTransform();
-                        break;
-                    }
                     case configid_int_overlay_origin:
                     {
                         DetachedTransformConvertOrigin(OverlayManager::Get().GetCurrentOverlayID(), (OverlayOrigin)previous_value, (OverlayOrigin)msg.lParam);
-                        ApplySettingTransform();
                         break;
                     }
                     case configid_int_overlay_browser_max_fps_override:
@@ -1777,11 +1867,6 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                         reset_mirroring = true;
                         break;
                     }
-                    case configid_int_input_mouse_dbl_click_assist_duration_ms:
-                    {
-                        ApplySettingMouseInput();
-                        break;
-                    }
                     case configid_int_input_laser_pointer_hmd_device_keycode_toggle:
                     case configid_int_input_laser_pointer_hmd_device_keycode_left:
                     case configid_int_input_laser_pointer_hmd_device_keycode_right:
@@ -1795,14 +1880,6 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                         WindowManager::Get().UpdateConfigState();
                         break;
                     }
-                    case configid_int_performance_update_limit_mode:
-                    case configid_int_performance_update_limit_fps:
-                    case configid_int_overlay_update_limit_override_mode:
-                    case configid_int_overlay_update_limit_override_fps:
-                    {
-                        ApplySettingUpdateLimiter();
-                        break;
-                    }
                     case configid_int_browser_max_fps:
                     {
                         DPBrowserAPIClient::Get().DPBrowser_GlobalSetFPS(msg.lParam);
@@ -1819,19 +1896,13 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                 float previous_value = ConfigManager::GetValue(float_id);
                 ConfigManager::SetValue(float_id, value);
 
+                if (ConfigManager::GetValue(float_id) != previous_value)
+                {
+                    InvalidateApplyStages(OutputManagerGetApplyStages(g_ApplyStageDependenciesFloat, float_id));
+                }
+
                 switch (float_id)
                 {
-                    case configid_float_overlay_width:
-                    case configid_float_overlay_curvature:
-                    case configid_float_overlay_opacity:
-                    case configid_float_overlay_brightness:
-                    case configid_float_overlay_offset_right:
-                    case configid_float_overlay_offset_up:
-                    case configid_float_overlay_offset_forward:
-                    {
-                        ApplySettingTransform();
-                        break;
-                    }
                     case configid_float_overlay_browser_zoom:
                     {
                         if (OverlayManager::Get().GetCurrentOverlay().GetTextureSource() == ovrl_texsource_browser)
@@ -1840,12 +1911,6 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
                         }
                         break;
                     }
-                    case configid_float_performance_update_limit_ms:
-                    case configid_float_overlay_update_limit_override_ms:
-                    {
-                        ApplySettingUpdateLimiter();
-                        break;
-                    }
                     default: break;
                 }
 
@@ -1886,6 +1951,8 @@ bool OutputManager::HandleIPCMessage(const MSG& msg)
 
 void OutputManager::HandleWinRTMessage(const MSG& msg)
 {
+    FlushPendingApplyStages();
+
     switch (msg.message)
     {
         case WM_DPLUSWINRT_SIZE:
@@ -1923,7 +1990,7 @@ void OutputManager::HandleWinRTMessage(const MSG& msg)
             data.ConfigInt[configid_int_overlay_state_content_height] = content_height;
 
             //Send update to UI
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)overlay_id);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)overlay_id);
 
             IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_state_content_width,  content_width);
             IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_state_content_height, content_height);
@@ -1933,7 +2000,7 @@ void OutputManager::HandleWinRTMessage(const MSG& msg)
                 IPCManager::Get().PostConfigMessageToUIApp(configid_float_overlay_width, data.ConfigFloat[configid_float_overlay_width]);
             }
 
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
 
             //Apply change to overlay
             unsigned int current_overlay_old = OverlayManager::Get().GetCurrentOverlayID();
@@ -1967,9 +2034,9 @@ void OutputManager::HandleWinRTMessage(const MSG& msg)
                 OverlayManager::Get().SetCurrentOverlayID(current_overlay_old);
 
                 //Send to UI
-                IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)overlay_id);
+                IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)overlay_id);
                 IPCManager::Get().PostConfigMessageToUIApp(configid_bool_overlay_enabled, false);
-                IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+                IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
             }
             else if (ConfigManager::GetValue(configid_int_windows_winrt_capture_lost_behavior) == window_caplost_remove_overlay) //Or remove it
             {
@@ -2006,10 +2073,16 @@ void OutputManager::HandleWinRTMessage(const MSG& msg)
             OverlayConfigData& data = OverlayManager::Get().GetConfigData(overlay_id);
             data.ConfigInt[configid_int_overlay_state_fps] = msg.lParam;
 
+            //UI reads it from the config mirror if available
+            if (m_ConfigMirror.IsOpen())
+            {
+                break;
+            }
+
             //Send update to UI
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)overlay_id);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)overlay_id);
             IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_state_fps, msg.lParam);
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
 
             break;
         }
@@ -2018,6 +2091,8 @@ void OutputManager::HandleWinRTMessage(const MSG& msg)
 
 void OutputManager::HandleHotkeyMessage(const MSG& msg)
 {
+    FlushPendingApplyStages();
+
     ConfigHotkeyList& hotkey_list = ConfigManager::Get().GetHotkeys();
     int hotkey_id = msg.wParam;
 
@@ -2502,7 +2577,7 @@ void OutputManager::ShowOverlay(unsigned int id)
     //If the last clipping rect doesn't fully contain the overlay's crop rect, the desktop texture overlay is probably outdated there, so force a full refresh
     if ( (data.ConfigInt[configid_int_overlay_capture_source] == ovrl_capsource_desktop_duplication) && (!m_OutputLastClippingRect.Contains(overlay.GetValidatedCropRect())) )
     {
-        RefreshOpenVROverlayTexture(DPRect(-1, -1, -1, -1), true);
+        RefreshOpenVROverlayTexture(DPRegion(), true);
     }
 
     OverlayManager::Get().SetCurrentOverlayID(current_overlay_old);
@@ -2782,9 +2857,9 @@ void OutputManager::SetOverlayEnabled(unsigned int overlay_id, bool is_enabled)
     OverlayManager::Get().SetCurrentOverlayID(current_overlay_old);
 
     //Sync change
-    IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, overlay_id);
+    IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, overlay_id);
     IPCManager::Get().PostConfigMessageToUIApp(configid_bool_overlay_enabled, data.ConfigBool[configid_bool_overlay_enabled]);
-    IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+    IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
 }
 
 void OutputManager::CropToActiveWindowToggle(unsigned int overlay_id)
@@ -2951,6 +3026,11 @@ InputSimulator& OutputManager::GetInputSimulator()
     return m_InputSim;
 }
 
+void OutputManager::PublishConfigMirror()
+{
+    m_ConfigMirror.Publish();
+}
+
 void OutputManager::UpdatePerformanceStates()
 {
     //Frame counter, the frames themselves are counted in Update()
@@ -2958,7 +3038,12 @@ void OutputManager::UpdatePerformanceStates()
     {
         //A second has passed, reset the value
         ConfigManager::SetValue(configid_int_state_performance_duplication_fps, m_PerformanceFrameCount);
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_performance_duplication_fps, m_PerformanceFrameCount);
+
+        //UI reads it from the config mirror if available
+        if (!m_ConfigMirror.IsOpen())
+        {
+            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_performance_duplication_fps, m_PerformanceFrameCount);
+        }
 
         m_PerformanceFrameCountStartTick = ::GetTickCount64();
         m_PerformanceFrameCount = 0;
@@ -3935,7 +4020,7 @@ DUPL_RETURN OutputManager::CreateTextures(INT SingleOutput, _Out_ UINT* OutCount
     return DUPL_RETURN_SUCCESS;
 }
 
-void OutputManager::DrawFrameToOverlayTex(bool clear_rtv)
+void OutputManager::DrawFrameToOverlayTex(bool clear_rtv, const DPRegion* dirty_region)
 {
     //Do a straight copy if there are no issues with that or do the alpha check if it's still pending
     if ((!m_OutputAlphaCheckFailed) || (m_OutputAlphaChecksPending > 0))
@@ -3976,7 +4061,20 @@ void OutputManager::DrawFrameToOverlayTex(bool clear_rtv)
             m_DeviceContext->ClearRenderTargetView(m_OvrlRTV, bgColor);
         }
 
-        m_DeviceContext->Draw(NUMVERTICES, 0);
+        if (dirty_region != nullptr)
+        {
+            for (const DPRect& dirty_rect : *dirty_region)
+            {
+                const D3D11_RECT rect_scissor = { dirty_rect.GetTL().x, dirty_rect.GetTL().y, dirty_rect.GetBR().x, dirty_rect.GetBR().y };
+                m_DeviceContext->RSSetScissorRects(1, &rect_scissor);
+
+                m_DeviceContext->Draw(NUMVERTICES, 0);
+            }
+        }
+        else
+        {
+            m_DeviceContext->Draw(NUMVERTICES, 0);
+        }
     }
 }
 
@@ -4182,7 +4280,7 @@ DUPL_RETURN OutputManager::DrawMouseToOverlayTex(_In_ PTR_INFO* PtrInfo)
     return DUPL_RETURN_SUCCESS;
 }
 
-DUPL_RETURN_UPD OutputManager::RefreshOpenVROverlayTexture(DPRect& DirtyRectTotal, bool force_full_copy)
+DUPL_RETURN_UPD OutputManager::RefreshOpenVROverlayTexture(const DPRegion& DirtyRegionTotal, bool force_full_copy)
 {
     if ((m_OvrlHandleDesktopTexture != vr::k_ulOverlayHandleInvalid) && (m_OvrlTex))
     {
@@ -4200,7 +4298,8 @@ DUPL_RETURN_UPD OutputManager::RefreshOpenVROverlayTexture(DPRect& DirtyRectTota
             {
                 //Another thread has the keyed mutex so there will be a new frame ready after this.
                 //Bail out and just set the pending dirty region to full so everything gets drawn over on the next update
-                m_OutputPendingDirtyRect = {0, 0, m_DesktopWidth, m_DesktopHeight};
+                m_OutputPendingDirtyRegion.Clear();
+                m_OutputPendingDirtyRegion.Add({0, 0, m_DesktopWidth, m_DesktopHeight});
                 return DUPL_RETURN_UPD_RETRY;
             }
             else if (FAILED(hr))
@@ -4220,10 +4319,12 @@ DUPL_RETURN_UPD OutputManager::RefreshOpenVROverlayTexture(DPRect& DirtyRectTota
             //We don't draw the cursor here as this can lead to tons of issues for little gain. We might not even know what the cursor looks like if it was cropped out previously, etc.
             //We do mark where the cursor has last been seen as pending dirty region, however, so it gets updated at the next best moment even if it didn't move
 
+            m_OutputPendingDirtyRegion.Clear();
+
             if (m_MouseLastInfo.Visible)
             {
-                m_OutputPendingDirtyRect = {    m_MouseLastInfo.Position.x, m_MouseLastInfo.Position.y, int(m_MouseLastInfo.Position.x + m_MouseLastInfo.ShapeInfo.Width),
-                                            int(m_MouseLastInfo.Position.y + m_MouseLastInfo.ShapeInfo.Height) };
+                m_OutputPendingDirtyRegion.Add({m_MouseLastInfo.Position.x, m_MouseLastInfo.Position.y, int(m_MouseLastInfo.Position.x + m_MouseLastInfo.ShapeInfo.Width),
+                                                int(m_MouseLastInfo.Position.y + m_MouseLastInfo.ShapeInfo.Height)});
             }
         }
 
@@ -4259,12 +4360,12 @@ DUPL_RETURN_UPD OutputManager::RefreshOpenVROverlayTexture(DPRect& DirtyRectTota
             vrtex.handle = m_MultiGPUTexTarget;
         }
 
-        //Do a simple full copy (done below) if the rect covers the whole texture (this isn't slower than a full rect copy and works with size changes)
-        force_full_copy = ( (force_full_copy) || (DirtyRectTotal.Contains({0, 0, m_DesktopWidth, m_DesktopHeight})) );
+        //Do a simple full copy (done below) if a rect covers the whole texture (this isn't slower than a full rect copy and works with size changes)
+        force_full_copy = ( (force_full_copy) || (DirtyRegionTotal.Contains({0, 0, m_DesktopWidth, m_DesktopHeight})) );
 
         if (!force_full_copy) //Otherwise do a partial copy
         {
-            //Get overlay texture from OpenVR and copy dirty rect directly into it
+            //Get overlay texture from OpenVR and copy dirty rects directly into it
             ID3D11Texture2D* reference_texture = (ID3D11Texture2D*)vrtex.handle;
             ID3D11ShaderResourceView* ovrl_shader_rsv;
 
@@ -4277,15 +4378,18 @@ DUPL_RETURN_UPD OutputManager::RefreshOpenVROverlayTexture(DPRect& DirtyRectTota
                 Microsoft::WRL::ComPtr<ID3D11Resource> ovrl_tex;
                 ovrl_shader_rsv->GetResource(&ovrl_tex);
 
-                D3D11_BOX box = {0};
-                box.left   = DirtyRectTotal.GetTL().x;
-                box.top    = DirtyRectTotal.GetTL().y;
-                box.front  = 0;
-                box.right  = DirtyRectTotal.GetBR().x;
-                box.bottom = DirtyRectTotal.GetBR().y;
-                box.back   = 1;
+                for (const DPRect& dirty_rect : DirtyRegionTotal)
+                {
+                    D3D11_BOX box = {0};
+                    box.left   = dirty_rect.GetTL().x;
+                    box.top    = dirty_rect.GetTL().y;
+                    box.front  = 0;
+                    box.right  = dirty_rect.GetBR().x;
+                    box.bottom = dirty_rect.GetBR().y;
+                    box.back   = 1;
 
-                device_context->CopySubresourceRegion(ovrl_tex.Get(), 0, box.left, box.top, 0, reference_texture, 0, &box);
+                    device_context->CopySubresourceRegion(ovrl_tex.Get(), 0, box.left, box.top, 0, reference_texture, 0, &box);
+                }
 
                 //RSV is kept around by IVROverlayEx and not released here
             }
@@ -5744,12 +5848,12 @@ void OutputManager::CropToDisplay(int display_id, bool do_not_apply_setting)
     CropToDisplay(display_id, crop_x, crop_y, crop_width, crop_height);
 
     //Send change to UI as well (also set override since this may be called during one)
-    IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, OverlayManager::Get().GetCurrentOverlayID());
+    IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, OverlayManager::Get().GetCurrentOverlayID());
     IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_crop_x,      crop_x);
     IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_crop_y,      crop_y);
     IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_crop_width,  crop_width);
     IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_crop_height, crop_height);
-    IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+    IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
 
     //In single desktop mode, set desktop ID for all overlays
     if (ConfigManager::GetValue(configid_bool_performance_single_desktop_mirroring))
@@ -5758,9 +5862,9 @@ void OutputManager::CropToDisplay(int display_id, bool do_not_apply_setting)
         {
             OverlayManager::Get().GetConfigData(i).ConfigInt[configid_int_overlay_desktop_id] = display_id;
 
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)i);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)i);
             IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_desktop_id, display_id);
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
         }
     }
 
@@ -5857,9 +5961,9 @@ unsigned int OutputManager::AddOverlayDrag(float source_distance, OverlayCapture
     //Adjust width and send it over to UI app
     ConfigManager::SetValue(configid_float_overlay_width, overlay_width);
 
-    IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)new_id);
+    IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)new_id);
     IPCManager::Get().PostConfigMessageToUIApp(configid_float_overlay_width, overlay_width);
-    IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+    IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
 
     //Start drag and apply overlay config
     DetachedTempDragStart(new_id, std::max(source_distance - 0.25f, 0.01f));
@@ -6092,7 +6196,7 @@ void OutputManager::ApplySetting3DMode()
             OverlayManager::Get().GetCurrentOverlay().SetTextureSource(ovrl_texsource_desktop_duplication);
         }
 
-        RefreshOpenVROverlayTexture(DPRect(-1, -1, -1, -1), true);
+        RefreshOpenVROverlayTexture(DPRegion(), true);
     }
     //WinRT OU3D state is set in ApplySettingCrop since it needs cropping values
 
@@ -6407,7 +6511,7 @@ void OutputManager::ApplySettingCrop()
 
         if ((tex_bounds.uMin < tex_bounds_prev.uMin) || (tex_bounds.vMin < tex_bounds_prev.vMin) || (tex_bounds.uMax > tex_bounds_prev.uMax) || (tex_bounds.vMax > tex_bounds_prev.vMax))
         {
-            RefreshOpenVROverlayTexture(DPRect(-1, -1, -1, -1), true);
+            RefreshOpenVROverlayTexture(DPRegion(), true);
         }
     }
 
@@ -6767,12 +6871,128 @@ void OutputManager::ApplySettingExtraBrightness()
         data.ConfigFloat[configid_float_overlay_state_brightness_extra_multiplier] = extra_brightness_mulitplier;
 
         //Send change over to UI
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)overlay.GetID());
+        IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)overlay.GetID());
         IPCManager::Get().PostConfigMessageToUIApp(configid_float_overlay_state_brightness_extra_multiplier, extra_brightness_mulitplier);
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+        IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
+    }
+}
+
+void OutputManager::InvalidateApplyStages(unsigned int stages, unsigned int overlay_id)
+{
+    if (stages == 0)
+        return;
+
+    m_PendingApplyStagesGlobal |= (stages & ~apply_stage_overlay_mask);
+
+    if ((stages & apply_stage_overlay_mask) != 0)
+    {
+        if (overlay_id == k_ulOverlayID_None)
+        {
+            overlay_id = OverlayManager::Get().GetCurrentOverlayID();
+        }
+
+        if (overlay_id >= OverlayManager::Get().GetOverlayCount())
+            return;
+
+        if (m_PendingApplyStages.size() <= overlay_id)
+        {
+            m_PendingApplyStages.resize(overlay_id + 1, 0);
+        }
+
+        m_PendingApplyStages[overlay_id] |= (stages & apply_stage_overlay_mask);
+    }
+}
+
+void OutputManager::SwapPendingApplyStages(unsigned int overlay_id, unsigned int overlay_id2)
+{
+    const unsigned int overlay_id_max = std::max(overlay_id, overlay_id2);
+
+    if (std::min(overlay_id, overlay_id2) >= m_PendingApplyStages.size())
+        return;
+
+    if (m_PendingApplyStages.size() <= overlay_id_max)
+    {
+        m_PendingApplyStages.resize(overlay_id_max + 1, 0);
+    }
+
+    std::swap(m_PendingApplyStages[overlay_id], m_PendingApplyStages[overlay_id2]);
+}
+
+void OutputManager::RemovePendingApplyStages(unsigned int overlay_id)
+{
+    if (overlay_id == k_ulOverlayID_None)
+    {
+        m_PendingApplyStages.clear();
+    }
+    else if (overlay_id < m_PendingApplyStages.size())
+    {
+        m_PendingApplyStages.erase(m_PendingApplyStages.begin() + overlay_id);
     }
 }
 
+void OutputManager::EndConfigTransaction()
+{
+    m_ConfigTransactionActive = false;
+    ConfigManager::SetValue(configid_int_state_overlay_current_id_override, m_ConfigTransactionOverrideIDPrev);
+}
+
+void OutputManager::FlushPendingApplyStages()
+{
+    //Changes of a config transaction are applied together once it's committed, but don't hold them back forever if the sender never does that
+    if (m_ConfigTransactionActive)
+    {
+        if (::GetTickCount64() < m_ConfigTransactionStartTick + 1000)
+            return;
+
+        LOG_F(WARNING, "Config transaction wasn't committed in time, applying changes anyways");
+        EndConfigTransaction();
+    }
+
+    if ( (m_PendingApplyStages.empty()) && (m_PendingApplyStagesGlobal == 0) )
+        return;
+
+    //Swap out the pending state first in case any of the functions below end up invalidating stages again
+    std::vector<unsigned int> pending_stages;
+    pending_stages.swap(m_PendingApplyStages);
+    const unsigned int pending_stages_global = m_PendingApplyStagesGlobal;
+    m_PendingApplyStagesGlobal = 0;
+
+    unsigned int current_overlay_old = OverlayManager::Get().GetCurrentOverlayID();
+
+    //Order matches what the settings depend on, e.g. transform uses the crop rect and mouse scale uses both
+    for (unsigned int i = 0; (i < pending_stages.size()) && (i < OverlayManager::Get().GetOverlayCount()); ++i)
+    {
+        const unsigned int stages = pending_stages[i];
+
+        if (stages == 0)
+            continue;
+
+        OverlayManager::Get().SetCurrentOverlayID(i);
+
+        if (stages & apply_stage_crop)
+            ApplySettingCrop();
+        if (stages & apply_stage_transform)
+            ApplySettingTransform();
+        if (stages & apply_stage_mouse_scale)
+            ApplySettingMouseScale();
+        if (stages & apply_stage_3D_mode)
+            ApplySetting3DMode();
+        if (stages & apply_stage_extra_brightness)
+            ApplySettingExtraBrightness();
+    }
+
+    OverlayManager::Get().SetCurrentOverlayID(current_overlay_old);
+
+    //ApplySettingInputMode() applies mouse input as well
+    if (pending_stages_global & apply_stage_input_mode)
+        ApplySettingInputMode();
+    else if (pending_stages_global & apply_stage_mouse_input)
+        ApplySettingMouseInput();
+
+    if (pending_stages_global & apply_stage_update_limiter)
+        ApplySettingUpdateLimiter();
+}
+
 void OutputManager::DetachedTransformSync(unsigned int overlay_id)
 {
     IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_transform_sync_target_id, (int)overlay_id);
@@ -7009,7 +7229,8 @@ void OutputManager::DetachedTransformAdjust(unsigned int packed_value)
 
     //Unpack
     IPCActionOverlayPosAdjustTarget target = (IPCActionOverlayPosAdjustTarget)(packed_value & 0xF);
-    bool increase = (packed_value >> 4);
+    bool increase = (packed_value & ipcactv_ovrl_pos_adjust_increase);
+    int steps = ((packed_value >> 8) & 0xFF) + 1;
 
     //"To HMD" / LookAt button, seperate code path entirely
     if (target == ipcactv_ovrl_pos_adjust_lookat)
@@ -7083,6 +7304,10 @@ void OutputManager::DetachedTransformAdjust(unsigned int packed_value)
         distance = ConfigManager::GetValue(configid_float_input_drag_snap_position_size);
     }
 
+    //Multiple steps along the same axis are the same as a single larger one
+    distance *= steps;
+    angle *= steps;
+
     if (!increase)
     {
         distance *= -1.0f;
@@ -7473,9 +7698,9 @@ void OutputManager::OnDragFinish()
         }
 
         //Send change over to UI
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)m_OverlayDragger.GetDragOverlayID());
+        IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)m_OverlayDragger.GetDragOverlayID());
         IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_origin, data.ConfigInt[configid_int_overlay_origin]);
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+        IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
     }
 }
 
@@ -17,10 +17,26 @@
 #include "BackgroundOverlay.h"
 #include "OUtoSBSConverter.h"
 #include "InterprocessMessaging.h"
+#include "ConfigMirror.h"
 #include "OverlayDragger.h"
 #include "LaserPointer.h"
 
 class Overlay;
+
+//Stages of applying overlay config state, invalidated by config changes and flushed once per frame
+enum OutputManagerApplyStage : unsigned int
+{
+    apply_stage_crop             = 1 << 0,
+    apply_stage_transform        = 1 << 1,
+    apply_stage_mouse_scale      = 1 << 2,
+    apply_stage_3D_mode          = 1 << 3,
+    apply_stage_extra_brightness = 1 << 4,
+    apply_stage_mouse_input      = 1 << 5,      //Stages from here on apply to all overlays
+    apply_stage_input_mode       = 1 << 6,
+    apply_stage_update_limiter   = 1 << 7,
+    apply_stage_overlay_mask     = apply_stage_mouse_input - 1
+};
+
 //
 // This class evolved into handling almost everything
 // Updates the output texture, sends it to OpenVR, handles OpenVR events, IPC messages...
@@ -36,11 +52,12 @@ class OutputManager
         void CleanRefs();
         DUPL_RETURN InitOutput(HWND Window, _Out_ INT& SingleOutput, _Out_ UINT* OutCount, _Out_ RECT* DeskBounds);
         std::tuple<vr::EVRInitError, vr::EVROverlayError, bool> InitOverlay();  //Returns error state <InitError, OverlayError, VRInputInitSuccess>
-        DUPL_RETURN_UPD Update(_In_ PTR_INFO* PointerInfo, _In_ DPRect& DirtyRegionTotal, bool NewFrame, bool SkipFrame);
+        DUPL_RETURN_UPD Update(_In_ PTR_INFO* PointerInfo, _In_ DPRegion& DirtyRegionTotal, bool NewFrame, bool SkipFrame);
         void BusyUpdate();                        //Updates minimal state (i.e. OverlayDragger) during busy waits (i.e. waiting for browser startup) to appear more responsive
         bool HandleIPCMessage(const MSG& msg);    //Returns true if message caused a duplication reset (i.e. desktop switch)
         void HandleWinRTMessage(const MSG& msg);  //Messages sent by the Desktop+ WinRT library
         void HandleHotkeyMessage(const MSG& msg);
+        void FlushPendingApplyStages();           //Applies stages invalidated by config changes since the last call. Called once per frame and before handling messages that may depend on them
         void OnExit();
 
         HWND GetWindowHandle();
@@ -66,6 +83,9 @@ class OutputManager
         void ShowTheaterOverlay(unsigned int id);
         void HideOverlay(unsigned int id);
         void ResetOverlayActiveCount();     //Called by OverlayManager after removing all overlays, makes sure the active counts are correct
+        //Called by OverlayManager when overlay IDs change, so stages invalidated during a config transaction are still applied to the right overlays
+        void SwapPendingApplyStages(unsigned int overlay_id, unsigned int overlay_id2);
+        void RemovePendingApplyStages(unsigned int overlay_id);     //Shifts stages of overlays past overlay_id down. k_ulOverlayID_None removes all
 
         bool HasDashboardBeenActivatedOnce() const;
         bool IsDashboardTabActive() const;
@@ -86,6 +106,7 @@ class OutputManager
 
         VRInput& GetVRInput();
         InputSimulator& GetInputSimulator();
+        void PublishConfigMirror();             //Publishes config values changed since the last call to the shared memory mirror read by the UI app. Called once per frame
 
         void UpdatePerformanceStates();
         const LARGE_INTEGER& GetUpdateLimiterDelay();
@@ -106,9 +127,9 @@ class OutputManager
         DUPL_RETURN MakeRTV();
         DUPL_RETURN InitShaders();
         DUPL_RETURN CreateTextures(INT SingleOutput, _Out_ UINT* OutCount, _Out_ RECT* DeskBounds);
-        void DrawFrameToOverlayTex(bool clear_rtv = true);
+        void DrawFrameToOverlayTex(bool clear_rtv = true, const DPRegion* dirty_region = nullptr); //Draws once per rect of dirty_region with a matching scissor rect if set
         DUPL_RETURN DrawMouseToOverlayTex(_In_ PTR_INFO* PtrInfo);
-        DUPL_RETURN_UPD RefreshOpenVROverlayTexture(DPRect& DirtyRectTotal, bool force_full_copy = false); //Refreshes the overlay texture of the VR runtime with content of the m_OvrlTex backing texture
+        DUPL_RETURN_UPD RefreshOpenVROverlayTexture(const DPRegion& DirtyRegionTotal, bool force_full_copy = false); //Refreshes the overlay texture of the VR runtime with content of the m_OvrlTex backing texture
         bool DesktopTextureAlphaCheck();
 
         bool HandleOpenVREvents();  //Returns true if quit event happened
@@ -132,6 +153,8 @@ class OutputManager
         void ApplySettingMouseScale();
         void ApplySettingUpdateLimiter();
         void ApplySettingExtraBrightness();
+        void InvalidateApplyStages(unsigned int stages, unsigned int overlay_id = k_ulOverlayID_None);  //Stages are OutputManagerApplyStage flags. Uses current overlay if overlay_id is k_ulOverlayID_None
+        void EndConfigTransaction();                                                                    //Restores overlay ID override, doesn't apply anything on its own
 
         void DetachedTransformSync(unsigned int overlay_id);
         void DetachedTransformSyncAll();
@@ -174,6 +197,7 @@ class OutputManager
         BackgroundOverlay m_BackgroundOverlay;
         OverlayDragger m_OverlayDragger;
         LaserPointer m_LaserPointer;
+        ConfigMirror m_ConfigMirror;
 
     // Vars
         ID3D11Device* m_Device;
@@ -206,7 +230,7 @@ class OutputManager
         bool m_OutputInvalid;
         bool m_OutputPendingSkippedFrame;
         bool m_OutputPendingFullRefresh;
-        DPRect m_OutputPendingDirtyRect;
+        DPRegion m_OutputPendingDirtyRegion;
         DPRect m_OutputLastClippingRect;
         int m_OutputAlphaChecksPending;
         bool m_OutputAlphaCheckFailed;          //Output appears to be translucent and needs its alpha channel stripped during texture copy
@@ -224,6 +248,11 @@ class OutputManager
         ULONGLONG m_OvrlTempDragStartTick;
         float m_PendingDashboardDummyHeight;
         ULONGLONG m_LastApplyTransformTick;
+        std::vector<unsigned int> m_PendingApplyStages;         //OutputManagerApplyStage flags per overlay ID
+        unsigned int m_PendingApplyStagesGlobal;                //OutputManagerApplyStage flags applying to all overlays
+        bool m_ConfigTransactionActive;                         //Pending apply stages are held back until the transaction is committed
+        int m_ConfigTransactionOverrideIDPrev;                  //configid_int_state_overlay_current_id_override before the transaction started
+        ULONGLONG m_ConfigTransactionStartTick;
 
         Microsoft::WRL::ComPtr<ID3D11Texture2D> m_MouseTex;
         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_MouseShaderRes;
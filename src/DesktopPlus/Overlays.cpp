@@ -133,10 +133,10 @@ void Overlay::AssignDesktopDuplicationTexture()
             data.ConfigInt[configid_int_overlay_state_content_height] = dheight;
             UpdateValidatedCropRect();
 
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, m_ID);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, m_ID);
             IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_state_content_width,  dwidth);
             IPCManager::Get().PostConfigMessageToUIApp(configid_int_overlay_state_content_height, dheight);
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
         }
 
         //Exclude indirect desktop duplication sources, like converted Over-Under 3D
@@ -396,9 +396,9 @@ void Overlay::SetTextureSource(OverlayTextureSource tex_source)
         {
             data.ConfigBool[configid_bool_overlay_state_no_output] = has_no_output;
 
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, m_ID);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, m_ID);
             IPCManager::Get().PostConfigMessageToUIApp(configid_bool_overlay_state_no_output, has_no_output);
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
         }
     }
 }
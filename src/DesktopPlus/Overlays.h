@@ -1,6 +1,7 @@
 #pragma once
 
 #include "openvr.h"
+#include "Util.h"
 #include "DPRect.h"
 #include "OUtoSBSConverter.h"
 
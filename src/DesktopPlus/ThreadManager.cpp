@@ -248,7 +248,7 @@ PTR_INFO* THREADMANAGER::GetPointerInfo()
     return &m_PtrInfo;
 }
 
-DPRect& THREADMANAGER::GetDirtyRegionTotal()
+DPRegion& THREADMANAGER::GetDirtyRegionTotal()
 {
     return m_DirtyRegionTotal;
 }
@@ -13,7 +13,7 @@ class THREADMANAGER
                                HANDLE PauseDuplicationEvent, HANDLE ResumeDuplicationEvent, HANDLE TerminateThreadsEvent,
                                HANDLE SharedHandle, _In_ RECT* DesktopDim, IDXGIAdapter* DXGIAdapter, bool WMRIgnoreVScreens);
         PTR_INFO* GetPointerInfo();         //Should only be called when shared surface mutex has be aquired
-        DPRect& GetDirtyRegionTotal();      //Should only be called when shared surface mutex has be aquired
+        DPRegion& GetDirtyRegionTotal();    //Should only be called when shared surface mutex has be aquired
         void WaitForThreadTermination();
 
     private:
@@ -21,7 +21,7 @@ class THREADMANAGER
         void CleanDx(_Inout_ DX_RESOURCES* Data);
 
         PTR_INFO m_PtrInfo;
-        DPRect m_DirtyRegionTotal;
+        DPRegion m_DirtyRegionTotal;
         UINT m_ThreadCount;
         _Field_size_(m_ThreadCount) HANDLE* m_ThreadHandles;
         _Field_size_(m_ThreadCount) THREAD_DATA* m_ThreadData;
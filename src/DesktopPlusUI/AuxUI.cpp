@@ -376,9 +376,9 @@ bool WindowGazeFadeAutoHint::Show()
     UIManager::Get()->GetIdleState().AddActiveTime(5000);
 
     //Deactivate GazeFade during the countdown so the overlay is visible to the user
-    IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, (int)m_TargetOverlay);
+    IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, (int)m_TargetOverlay);
     IPCManager::Get().PostConfigMessageToDashboardApp(configid_bool_overlay_gazefade_enabled, false);
-    IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+    IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
     return AuxUIWindow::Show();
 }
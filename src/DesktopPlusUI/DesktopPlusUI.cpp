@@ -19,6 +19,8 @@
 #include "UIManager.h"
 #include "TextureManager.h"
 #include "InterprocessMessaging.h"
+#include "IPCStats.h"
+#include "IPCRecorder.h"
 #include "WindowSettings.h"
 #include "Util.h"
 #include "OpenVRExt.h"
@@ -46,7 +48,7 @@ void CleanupRenderTarget();
 void RefreshOverlayTextureSharing();
 LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 void InitImGui(HWND hwnd, bool desktop_mode);
-void ProcessCmdline(bool& force_desktop_mode, bool& open_keyboard_editor);
+void ProcessCmdline(bool& force_desktop_mode, bool& open_keyboard_editor, bool& ipc_record, std::string& ipc_replay_path);
 
 // Main code
 int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPSTR lpCmdLine, _In_ INT nCmdShow)
@@ -55,20 +57,44 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
 
     bool force_desktop_mode = false;
     bool open_keyboard_editor = false;
-    ProcessCmdline(force_desktop_mode, open_keyboard_editor);
+    bool ipc_record = false;
+    std::string ipc_replay_path;
+    ProcessCmdline(force_desktop_mode, open_keyboard_editor, ipc_record, ipc_replay_path);
+
+    if ( (ipc_record) && (!IPCRecorder::Get().StartRecording("DesktopPlusUI")) )
+    {
+        LOG_F(WARNING, "Failed to start IPC recording");
+    }
+
+    //Keep replays from affecting a normally running Desktop+. Nothing is sent to other processes, and config and profile files are left alone
+    //As the dashboard app then counts as not running, replays also always run in desktop mode without OpenVR
+    const bool is_replaying_ipc = !ipc_replay_path.empty();
+
+    if (is_replaying_ipc)
+    {
+        IPCManager::Get().SetIsolatedFromPeers(true);
+        ConfigManager::Get().SetSavingDisabled(true);
+    }
 
     //Automatically use desktop mode if dashboard app isn't running
     bool desktop_mode = ( (force_desktop_mode) || (!IPCManager::IsDashboardAppRunning()) );
     LOG_F(INFO, "Desktop+ UI running in %s", (desktop_mode) ? ((open_keyboard_editor) ? "desktop mode (keyboard editor)" : "desktop mode") : "VR mode");
 
-    //Make sure only one instance is running
-    StopProcessByWindowClass(g_WindowClassNameUIApp);
+    //Make sure only one instance is running (replays run alongside it instead)
+    //Shared memory IPC is set up before the window exists so other processes can use it right away. Replays would take over the running instance's ring buffers
+    if (!is_replaying_ipc)
+    {
+        StopProcessByWindowClass(g_WindowClassNameUIApp);
+        IPCManager::Get().InitTransport(ipcpeer_ui_app);
+    }
+
+    IPCManager::Get().SetReceiveTimeBudget(g_IPCReceiveFrameBudgetUs);
 
     //Enable DPI support for desktop mode
     ImGui_ImplWin32_EnableDpiAwareness();
 
     //Register application class
-    WNDCLASSEX wc = { sizeof(WNDCLASSEX), CS_CLASSDC, WndProc, 0L, 0L, hInstance, nullptr, nullptr, nullptr, nullptr, g_WindowClassNameUIApp, nullptr };
+    WNDCLASSEX wc = { sizeof(WNDCLASSEX), CS_CLASSDC, WndProc, 0L, 0L, hInstance, nullptr, nullptr, nullptr, nullptr, (is_replaying_ipc) ? g_WindowClassNameIPCReplay : g_WindowClassNameUIApp, nullptr };
     wc.hIcon   = (HICON)::LoadImage(hInstance, MAKEINTRESOURCE(IDI_DPLUS), IMAGE_ICON, GetSystemMetrics(SM_CXICON),   GetSystemMetrics(SM_CYICON),   LR_DEFAULTCOLOR);
     wc.hIconSm = (HICON)::LoadImage(hInstance, MAKEINTRESOURCE(IDI_DPLUS), IMAGE_ICON, GetSystemMetrics(SM_CXSMICON), GetSystemMetrics(SM_CYSMICON), LR_DEFAULTCOLOR);
     ::RegisterClassEx(&wc);
@@ -178,6 +204,19 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     ui_manager.OnInitDone();
     LOG_F(INFO, "Finished startup");
 
+    //Replay recorded IPC messages and exit
+    if (!ipc_replay_path.empty())
+    {
+        LOG_F(INFO, "Replaying IPC recording \"%s\"...", ipc_replay_path.c_str());
+
+        if (!IPCRecorder::Replay(ipc_replay_path.c_str(), "DesktopPlusUI", [&](const MSG& replay_msg){ ui_manager.HandleIPCMessage(replay_msg); }))
+        {
+            LOG_F(ERROR, "Failed to replay IPC recording");
+        }
+
+        ::PostQuitMessage(0);
+    }
+
     //Main loop
     MSG msg;
     ZeroMemory(&msg, sizeof(msg));
@@ -200,6 +239,10 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             continue;
         }
 
+        //Message queue is drained at this point, publish config changes made while handling the messages and the last frame for other threads
+        ConfigManager::Get().PublishSnapshot();
+        ui_manager.UpdateFromConfigMirror();
+
         if (!desktop_mode)
         {
             vr::VREvent_t vr_event;
@@ -365,6 +408,11 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             TextureManager::Get().LoadAllTexturesAndBuildFonts();
         }
 
+        //Send messages queued while handling events and continue with received ones deferred to this frame
+        IPCManager::Get().FlushQueuedMessages();
+        IPCManager::Get().ResumeDeferredMessages();
+        DPBrowserAPIClient::Get().FlushQueuedCommands();
+
         //While we still need to poll, greatly reduce the rate and don't do any ImGui stuff to not waste resources (hopefully this does not mess up ImGui input state)
         if ((idle_state.ShouldIdle()) && (!ui_manager.HasDelayedIPCMessages()))
         {
@@ -472,6 +520,10 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             }
         }
 
+        //Send messages queued by widgets this frame before waiting for frame sync
+        IPCManager::Get().FlushQueuedMessages();
+        DPBrowserAPIClient::Get().FlushQueuedCommands();
+
         // Rendering
         if (ui_manager.GetRepeatFrame()) //If frame repeat is enabled, don't actually render and skip vsync
         {
@@ -561,6 +613,14 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
 
     // Cleanup
     ui_manager.OnExit();
+
+    if (IPCStats::Get().IsEnabled())
+    {
+        IPCStats::Get().WriteDumpFile("DesktopPlusUI");
+    }
+
+    IPCRecorder::Get().StopRecording();
+
     ImGui_ImplDX11_Shutdown();
     ImGui_ImplWin32_Shutdown();
     ImPlot::DestroyContext();
@@ -774,6 +834,9 @@ LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
         {
             if (UIManager::Get())
             {
+                //Process messages sent through the ring buffers before this, including ones deferred to the next frame
+                IPCManager::Get().ReceiveAllRingMessages(hWnd, [&](const MSG& ring_msg){ UIManager::Get()->HandleIPCMessage(ring_msg); });
+
                 MSG pmsg;
                 //Process all custom window messages posted before this
                 while (PeekMessage(&pmsg, nullptr, 0xC000, 0xFFFF, PM_REMOVE))
@@ -853,5 +916,21 @@ void ProcessCmdline(bool& force_desktop_mode, bool& open_keyboard_editor)
             open_keyboard_editor = true;
             force_desktop_mode   = true;
         }
+        else if ((strcmp(__argv[i], "-IPCRecord")  == 0) ||
+                 (strcmp(__argv[i], "--IPCRecord") == 0) ||
+                 (strcmp(__argv[i], "/IPCRecord")  == 0))
+        {
+            ipc_record = true;
+        }
+        else if ((strcmp(__argv[i], "-IPCReplay")  == 0) ||
+                 (strcmp(__argv[i], "--IPCReplay") == 0) ||
+                 (strcmp(__argv[i], "/IPCReplay")  == 0))
+        {
+            //Take the following argument as path of the recording to replay
+            if (__argc > i + 1)
+            {
+                ipc_replay_path = __argv[i+1];
+            }
+        }
     }
 }
\ No newline at end of file
@@ -16,6 +16,7 @@ namespace Gdiplus
 #include <gdipluspixelformats.h>
 
 #include "ConfigManager.h"
+#include "OverlayProfileCatalog.h"
 #include "Util.h"
 #include "UIManager.h"
 #include "OverlayManager.h"
@@ -129,10 +130,7 @@ bool TextureManager::LoadAllTexturesAndBuildFonts()
         }
     }
 
-    for (const std::string& str : ConfigManager::Get().GetOverlayProfileList()) //Also from overlay profiles
-    {
-        builder.AddText(str.c_str());
-    }
+    builder.AddText(ConfigManager::Get().GetOverlayProfileCatalog().GetGlyphString().c_str()); //Also from overlay profiles
 
     for (unsigned int i = 0; i < OverlayManager::Get().GetOverlayCount(); ++i) //And overlay names
     {
@@ -6,6 +6,8 @@
 #include "Logging.h"
 
 #include <clocale>
+#include <unordered_map>
+#include <algorithm>
 
 const char* TranslationManager::s_StringIDNames[tstr_MAX] =
 {
@@ -802,15 +804,46 @@ void TranslationManager::LoadTranslationFromFile(const std::string& filename)
         m_StringsDesktopID.clear();
         m_StringsFPSLimit.clear();
 
-        //Try loading all possible strings
-        for (size_t i = 0; i < tstr_MAX; ++i)
+        //Lowercase ID name to string ID lookup, as keys are matched case-insensitively
+        static const std::unordered_map<std::string, TRMGRStrID> string_id_lookup = []()
         {
-            if (lang_file.KeyExists("Strings", s_StringIDNames[i]))
+            std::unordered_map<std::string, TRMGRStrID> lookup;
+            lookup.reserve(tstr_MAX);
+
+            for (size_t i = 0; i < tstr_MAX; ++i)
             {
-                m_Strings[i] = lang_file.ReadString("Strings", s_StringIDNames[i]);
-                StringReplaceAll(m_Strings[i], "\\n", "\n");    //Replace new line placeholder
+                std::string name_lower = s_StringIDNames[i];
+                std::transform(name_lower.begin(), name_lower.end(), name_lower.begin(), [](char c){ return (char)::tolower((unsigned char)c); });
+                lookup.emplace(std::move(name_lower), (TRMGRStrID)i);
             }
-            else
+
+            return lookup;
+        }();
+
+        //Walk the strings section once instead of looking up every possible string
+        bool string_loaded[tstr_MAX] = {false};
+        std::string key_lower;
+
+        for (IniSectionCursor cursor = lang_file.GetSectionCursor("Strings"); cursor.Next();)
+        {
+            const std::string_view key = cursor.GetKey();
+            key_lower.assign(key.begin(), key.end());
+            std::transform(key_lower.begin(), key_lower.end(), key_lower.begin(), [](char c){ return (char)::tolower((unsigned char)c); });
+
+            const auto it = string_id_lookup.find(key_lower);
+
+            //Skip unknown and duplicate keys (first one wins, same as regular lookups)
+            if ( (it == string_id_lookup.end()) || (string_loaded[it->second]) )
+                continue;
+
+            string_loaded[it->second] = true;
+            m_Strings[it->second] = cursor.GetValue();
+            StringReplaceAll(m_Strings[it->second], "\\n", "\n");    //Replace new line placeholder
+        }
+
+        for (size_t i = 0; i < tstr_MAX; ++i)
+        {
+            if (!string_loaded[i])
             {
                 m_IsCurrentTranslationComplete = false;
 
@@ -16,6 +16,7 @@
 
 #include "DesktopPlusWinRT.h"
 #include "DPBrowserAPIClient.h"
+#include "IPCRecorder.h"
 
 //This one holds mostly constant data, but depends on how the application was launched
 static UITextureSpaces g_UITextureSpaces;
@@ -271,6 +272,9 @@ UIManager::UIManager(bool desktop_mode, bool keyboard_editor_mode) :
     m_OvrlPixelWidth(1),
     m_OvrlPixelHeight(1),
     m_TransformSyncValueCount(0),
+    m_ConfigTransactionOverrideIDPrev(-2),
+    m_UIIntersectionMaskSendFull(false),
+    m_ConfigMirrorOpenTick(0),
     m_TransformSyncValues{0}
 {
     g_UIManagerPtr = this;
@@ -612,6 +616,16 @@ vr::EVRInitError UIManager::InitOverlay()
 
 void UIManager::HandleIPCMessage(const MSG& msg, bool handle_delayed)
 {
+    //Messages sent through the shared memory transport are only announced by the doorbell message
+    if (IPCManager::Get().GetIPCMessageID(msg.message) == ipcmsg_ring_doorbell)
+    {
+        IPCManager::Get().ReceiveRingMessages(msg, [&](const MSG& ring_msg){ HandleIPCMessage(ring_msg, handle_delayed); });
+        return;
+    }
+
+    //Delayed messages were already recorded when they first arrived
+    IPCRecorder::Scope recorder_scope(msg, !handle_delayed);
+
     //Handle messages sent by browser process in the APIClient
     if (msg.message == DPBrowserAPIClient::Get().GetRegisteredMessageID())
     {
@@ -659,6 +673,18 @@ void UIManager::HandleIPCMessage(const MSG& msg, bool handle_delayed)
         {
             DPBrowserAPIClient::Get().HandleIPCMessage(msg);
         }
+        else if (pcds->dwData == g_IPCCopyDataIDConfigDelta)
+        {
+            ConfigDelta delta;
+
+            if (pcds->cbData <= g_IPCConfigDeltaSizeMax)
+            {
+                delta.Deserialize( std::string((char*)pcds->lpData, pcds->cbData) );
+            }
+
+            //Queue even if invalid so the apply message doesn't pick up the wrong delta
+            m_PendingConfigDeltas.push_back(std::move(delta));
+        }
 
         //Restore overlay id override
         if (overlay_override_id != -1)
@@ -681,6 +707,9 @@ void UIManager::HandleIPCMessage(const MSG& msg, bool handle_delayed)
                 {
                     UpdateDesktopOverlayPixelSize();
                     m_WindowPerformance.ScheduleOverlaySharedTextureUpdate();
+
+                    //Dashboard app may have been restarted and lost the mask
+                    m_UIIntersectionMaskSendFull = true;
                     break;
                 }
                 case ipcact_overlays_ui_reset:
@@ -693,6 +722,45 @@ void UIManager::HandleIPCMessage(const MSG& msg, bool handle_delayed)
                     HandleOverlayProfileLoadMessage(msg.lParam);
                     break;
                 }
+                case ipcact_config_transaction_begin:
+                {
+                    //Config changes are applied right away here, so transactions only set the overlay ID override
+                    if (m_ConfigTransactionOverrideIDPrev == -2)
+                    {
+                        m_ConfigTransactionOverrideIDPrev = ConfigManager::GetValue(configid_int_state_overlay_current_id_override);
+                    }
+
+                    if (msg.lParam != -1)
+                    {
+                        ConfigManager::SetValue(configid_int_state_overlay_current_id_override, (int)msg.lParam);
+                    }
+                    break;
+                }
+                case ipcact_config_transaction_commit:
+                {
+                    if (m_ConfigTransactionOverrideIDPrev != -2)
+                    {
+                        ConfigManager::SetValue(configid_int_state_overlay_current_id_override, m_ConfigTransactionOverrideIDPrev);
+                        m_ConfigTransactionOverrideIDPrev = -2;
+                    }
+                    break;
+                }
+                case ipcact_lpointer_ui_mask_resend:
+                {
+                    m_UIIntersectionMaskSendFull = true;
+                    break;
+                }
+                case ipcact_config_delta_apply:
+                {
+                    if (!m_PendingConfigDeltas.empty())
+                    {
+                        ConfigDelta delta = std::move(m_PendingConfigDeltas.front());
+                        m_PendingConfigDeltas.pop_front();
+
+                        delta.Replay([&](const MSG& delta_msg){ HandleIPCMessage(delta_msg, handle_delayed); });
+                    }
+                    break;
+                }
                 case ipcact_overlay_new_drag:
                 {
                     int desktop_id = GET_X_LPARAM(msg.lParam); //(No need to extract pointer distance)
@@ -1072,6 +1140,57 @@ bool UIManager::HasDelayedIPCMessages() const
     return !m_DelayedICPMessages.empty();
 }
 
+void UIManager::UpdateFromConfigMirror()
+{
+    //Dashboard app may not be running yet, don't try opening the mirror every frame
+    if (!m_ConfigMirrorDashboard.IsOpen())
+    {
+        if (m_ConfigMirrorOpenTick + 1000 > ::GetTickCount64())
+            return;
+
+        m_ConfigMirrorOpenTick = ::GetTickCount64();
+
+        if (!m_ConfigMirrorDashboard.Open(ipcpeer_dashboard_app))
+            return;
+    }
+
+    const ConfigMirrorData* data = m_ConfigMirrorDashboard.Read();
+
+    if (data == nullptr)
+        return;
+
+    //Only values the dashboard app no longer sends messages for are taken from the mirror. The rest is still synced through messages, which also handle changes
+    bool has_changed = false;
+
+    int& duplication_fps = ConfigManager::GetRef(configid_int_state_performance_duplication_fps);
+
+    if (duplication_fps != data->ConfigInt[configid_int_state_performance_duplication_fps])
+    {
+        duplication_fps = data->ConfigInt[configid_int_state_performance_duplication_fps];
+        has_changed = true;
+    }
+
+    //Overlay IDs only match while the overlay lists are in sync, skip overlays until they are
+    if (data->OverlayCount == OverlayManager::Get().GetOverlayCount())
+    {
+        for (unsigned int i = 0; i < data->GetMirroredOverlayCount(); ++i)
+        {
+            int& overlay_fps = OverlayManager::Get().GetConfigData(i).ConfigInt[configid_int_overlay_state_fps];
+
+            if (overlay_fps != data->OverlayStateFPS[i])
+            {
+                overlay_fps = data->OverlayStateFPS[i];
+                has_changed = true;
+            }
+        }
+    }
+
+    if ( (has_changed) && (ConfigManager::GetValue(configid_bool_performance_show_fps)) )
+    {
+        m_IdleState.AddActiveTime(50);
+    }
+}
+
 void UIManager::OnInitDone()
 {
     //Re-apply active overlay ID since the first time config load couldn't apply it properly with the overlay not yet existing
@@ -1270,7 +1389,7 @@ bool UIManager::IsDummyOverlayTransformUnstable() const
     return m_IsDummyOverlayTransformUnstable;
 }
 
-void UIManager::SendUIIntersectionMaskToDashboardApp(std::vector<vr::VROverlayIntersectionMaskPrimitive_t>& primitives) const
+void UIManager::SendUIIntersectionMaskToDashboardApp(std::vector<vr::VROverlayIntersectionMaskPrimitive_t>& primitives)
 {
     static ULONGLONG last_tick = 0;
 
@@ -1278,15 +1397,23 @@ void UIManager::SendUIIntersectionMaskToDashboardApp(std::vector<vr::VROverlayIn
     if ( (ConfigManager::GetValue(configid_int_state_dplus_laser_pointer_device) != vr::k_unTrackedDeviceIndexInvalid) && (last_tick + 100 > ::GetTickCount64()) )
         return;
 
+    std::vector<DPRect> rects;
+    rects.reserve(primitives.size());
+
     for (const auto& rect : primitives)
     {
-        DPRect dp_rect((int)rect.m_Primitive.m_Rectangle.m_flTopLeftX,  (int)rect.m_Primitive.m_Rectangle.m_flTopLeftY, 
-                       (int)rect.m_Primitive.m_Rectangle.m_flTopLeftX + (int)rect.m_Primitive.m_Rectangle.m_flWidth, (int)rect.m_Primitive.m_Rectangle.m_flTopLeftY + (int)rect.m_Primitive.m_Rectangle.m_flHeight);
-
-        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_lpointer_ui_mask_rect, (LPARAM)dp_rect.Pack16());
+        rects.emplace_back((int)rect.m_Primitive.m_Rectangle.m_flTopLeftX,  (int)rect.m_Primitive.m_Rectangle.m_flTopLeftY, 
+                           (int)rect.m_Primitive.m_Rectangle.m_flTopLeftX + (int)rect.m_Primitive.m_Rectangle.m_flWidth, (int)rect.m_Primitive.m_Rectangle.m_flTopLeftY + (int)rect.m_Primitive.m_Rectangle.m_flHeight);
     }
 
-    IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_lpointer_ui_mask_rect, -1); //Mark end of mask
+    //Only sends something if the mask changed, and then only the changed rects if possible
+    const std::string update = m_UIIntersectionMask.Update(rects, m_UIIntersectionMaskSendFull);
+
+    if (!update.empty())
+    {
+        IPCManager::Get().SendUIIntersectionMaskUpdateToDashboardApp(update, m_WindowHandle);
+        m_UIIntersectionMaskSendFull = false;
+    }
 
     last_tick = ::GetTickCount64();
 }
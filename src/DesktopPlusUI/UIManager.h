@@ -10,10 +10,15 @@
 #include <wrl/client.h>
 
 #include <array>
+#include <deque>
 
 #include "openvr.h"
 #include "Matrices.h"
+#include "Util.h"
 #include "DPRect.h"
+#include "ConfigDelta.h"
+#include "UIIntersectionMask.h"
+#include "ConfigMirror.h"
 
 #include "Logging.h"
 #include "NotificationIcon.h"
@@ -155,6 +160,12 @@ class UIManager
         float m_TransformSyncValues[16];        //Stores transform sync values until all are set for a full Matrix4
 
         std::vector<MSG> m_DelayedICPMessages;  //Stores ICP messages that need to be delayed for processing within an ImGui frame
+        std::deque<ConfigDelta> m_PendingConfigDeltas;  //ConfigDeltas received as WM_COPYDATA, applied once their ipcact_config_delta_apply message arrives
+        int m_ConfigTransactionOverrideIDPrev;          //configid_int_state_overlay_current_id_override before ipcact_config_transaction_begin, -2 if no transaction is active
+        UIIntersectionMask m_UIIntersectionMask;        //Last mask sent to the dashboard application
+        bool m_UIIntersectionMaskSendFull;              //Set when the dashboard application doesn't have the last mask, so the next update isn't a delta
+        ConfigMirror m_ConfigMirrorDashboard;           //Config values of the dashboard application, see UpdateFromConfigMirror()
+        ULONGLONG m_ConfigMirrorOpenTick;               //Last attempt at opening m_ConfigMirrorDashboard
 
         void DisplayDashboardAppError(const std::string& str);
         void DisplayInitialSetupNotification();
@@ -174,6 +185,7 @@ class UIManager
         void HandleIPCMessage(const MSG& msg, bool handle_delayed = false); //Messages that need processing within an ImGui frame are stored in m_DelayedICPMessages when handle_delayed is false
         void HandleDelayedIPCMessages();                                    //Calls HandleIPCMessage() for messages in m_DelayedICPMessages and clears it
         bool HasDelayedIPCMessages() const;
+        void UpdateFromConfigMirror();                                      //Applies performance state values published by the dashboard application. Called once per frame
 
         void OnInitDone();                                                  //Finishes up applying things that can only be applied after everything has finished loading
         void OnExit();
@@ -205,7 +217,7 @@ class UIManager
         vr::VROverlayHandle_t GetOverlayHandleSystemUI()           const;
         std::array<vr::VROverlayHandle_t, 6> GetUIOverlayHandles() const;
         bool IsDummyOverlayTransformUnstable() const;
-        void SendUIIntersectionMaskToDashboardApp(std::vector<vr::VROverlayIntersectionMaskPrimitive_t>& primitives) const;
+        void SendUIIntersectionMaskToDashboardApp(std::vector<vr::VROverlayIntersectionMaskPrimitive_t>& primitives);
 
         IdleState& GetIdleState();
         DPRect CalcRectForActiveTexspace();
@@ -99,9 +99,10 @@ void VRKeyboard::LoadLayoutFromFile(const std::string& filename)
         unsigned int row_id = 0;
         unsigned int key_id = 0;
 
-        std::string key_type_str;
-        std::string key_cluster_str;
-        std::string key_sublayout_toggle_str;
+        //Views into layout_file, valid as long as it's not modified
+        std::string_view key_type_str;
+        std::string_view key_cluster_str;
+        std::string_view key_sublayout_toggle_str;
         m_KeyLabels = "";
 
         while (true)
@@ -109,10 +110,12 @@ void VRKeyboard::LoadLayoutFromFile(const std::string& filename)
             std::stringstream key_section;
             key_section << "Key_" << g_KeyboardSublayoutNames[sublayout_id] << "_Row_" << row_id << "_ID_" << key_id;
 
-            if (layout_file.SectionExists(key_section.str().c_str()))
+            const std::string key_section_str = key_section.str();
+
+            if (layout_file.SectionExists(key_section_str.c_str()))
             {
                 //Key cluster
-                key_cluster_str = layout_file.ReadString(key_section.str().c_str(), "Cluster", "Base");
+                key_cluster_str = layout_file.ReadStringView(key_section_str.c_str(), "Cluster", "Base");
 
                 //Match cluster string and skip if the cluster has been disabled
                 bool skip_key = false;
@@ -141,7 +144,7 @@ void VRKeyboard::LoadLayoutFromFile(const std::string& filename)
                 key.KeyCluster = (KeyboardLayoutCluster)key_cluster_i;
 
                 //Key type
-                key_type_str = layout_file.ReadString(key_section.str().c_str(), "Type", "Blank");
+                key_type_str = layout_file.ReadStringView(key_section_str.c_str(), "Type", "Blank");
 
                 if (key_type_str == "Blank")
                 {
@@ -150,29 +153,29 @@ void VRKeyboard::LoadLayoutFromFile(const std::string& filename)
                 else if (key_type_str == "VirtualKey")
                 {
                     key.KeyType = kbdlayout_key_virtual_key;
-                    key.KeyCode = layout_file.ReadInt(key_section.str().c_str(), "KeyCode", 0);
-                    key.BlockModifiers = layout_file.ReadBool(key_section.str().c_str(), "BlockModifiers", false);
+                    key.KeyCode = layout_file.ReadInt(key_section_str.c_str(), "KeyCode", 0);
+                    key.BlockModifiers = layout_file.ReadBool(key_section_str.c_str(), "BlockModifiers", false);
                 }
                 else if (key_type_str == "VirtualKeyToggle")
                 {
                     key.KeyType = kbdlayout_key_virtual_key_toggle;
-                    key.KeyCode = layout_file.ReadInt(key_section.str().c_str(), "KeyCode", 0);
+                    key.KeyCode = layout_file.ReadInt(key_section_str.c_str(), "KeyCode", 0);
                 }
                 else if (key_type_str == "VirtualKeyIsoEnter")
                 {
                     key.KeyType = kbdlayout_key_virtual_key_iso_enter;
-                    key.KeyCode = layout_file.ReadInt(key_section.str().c_str(), "KeyCode", 0);
+                    key.KeyCode = layout_file.ReadInt(key_section_str.c_str(), "KeyCode", 0);
                 }
                 else if (key_type_str == "String")
                 {
                     key.KeyType   = kbdlayout_key_string;
-                    key.KeyString = layout_file.ReadString(key_section.str().c_str(), "String");
+                    key.KeyString = layout_file.ReadStringView(key_section_str.c_str(), "String");
                 }
                 else if (key_type_str == "SubLayoutToggle")
                 {
                     key.KeyType = kbdlayout_key_sublayout_toggle;
 
-                    key_sublayout_toggle_str = layout_file.ReadString(key_section.str().c_str(), "SubLayout", "Base");
+                    key_sublayout_toggle_str = layout_file.ReadStringView(key_section_str.c_str(), "SubLayout", "Base");
 
                     //Match sublayout string
                     for (size_t i = 0; i < kbdlayout_sub_MAX; ++i)
@@ -187,14 +190,14 @@ void VRKeyboard::LoadLayoutFromFile(const std::string& filename)
                 else if (key_type_str == "Action")
                 {
                     key.KeyType = kbdlayout_key_action;
-                    key.KeyActionUID = std::strtoull(layout_file.ReadString(key_section.str().c_str(), "ActionUID", "0").c_str(), nullptr, 10);
+                    key.KeyActionUID = std::strtoull(layout_file.ReadString(key_section_str.c_str(), "ActionUID", "0").c_str(), nullptr, 10);
                 }
 
                 //General
-                key.Width    = layout_file.ReadInt(key_section.str().c_str(), "Width",  100) / 100.0f;
-                key.Height   = layout_file.ReadInt(key_section.str().c_str(), "Height", 100) / 100.0f;
-                key.Label    = layout_file.ReadString(key_section.str().c_str(), "Label");
-                key.NoRepeat = layout_file.ReadBool(key_section.str().c_str(), "NoRepeat", false);
+                key.Width    = layout_file.ReadInt(key_section_str.c_str(), "Width",  100) / 100.0f;
+                key.Height   = layout_file.ReadInt(key_section_str.c_str(), "Height", 100) / 100.0f;
+                key.Label    = layout_file.ReadStringView(key_section_str.c_str(), "Label");
+                key.NoRepeat = layout_file.ReadBool(key_section_str.c_str(), "NoRepeat", false);
 
                 StringReplaceAll(key.Label, "\\n", "\n");
                 m_KeyLabels += key.Label;
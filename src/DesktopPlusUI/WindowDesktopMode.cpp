@@ -605,9 +605,9 @@ void WindowDesktopMode::MenuOverlayList(unsigned int overlay_id)
         {
             is_enabled = !is_enabled;
 
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, (int)overlay_id);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, (int)overlay_id);
             IPCManager::Get().PostConfigMessageToDashboardApp(configid_bool_overlay_enabled, is_enabled);
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
             HideMenus();
         }
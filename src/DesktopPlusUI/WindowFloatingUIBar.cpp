@@ -207,9 +207,9 @@ void WindowFloatingUIMainBar::Update(float actionbar_height, unsigned int overla
         {
             is_overlay_transform_locked = !is_overlay_transform_locked;
 
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, (int)overlay_id);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, (int)overlay_id);
             IPCManager::Get().PostConfigMessageToDashboardApp(configid_bool_overlay_transform_locked, is_overlay_transform_locked);
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
             io.MouseDown[ImGuiMouseButton_Left] = false;    //Release mouse button so actual button won't get toggled
         }
@@ -242,9 +242,9 @@ void WindowFloatingUIMainBar::Update(float actionbar_height, unsigned int overla
         {
             overlay_data.ConfigBool[configid_bool_overlay_enabled] = false;
 
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, (int)overlay_id);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, (int)overlay_id);
             IPCManager::Get().PostConfigMessageToDashboardApp(configid_bool_overlay_enabled, false);
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
         }
     }
 
@@ -603,7 +603,7 @@ void WindowFloatingUIActionBar::UpdateDesktopButtons(unsigned int overlay_id)
     {
         current_desktop = current_desktop_new;
 
-        IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, (int)overlay_id);
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, (int)overlay_id);
 
         //Reset window selection when switching to a desktop
         if (current_configid == configid_int_overlay_winrt_desktop_id)
@@ -614,7 +614,7 @@ void WindowFloatingUIActionBar::UpdateDesktopButtons(unsigned int overlay_id)
 
         IPCManager::Get().PostConfigMessageToDashboardApp(current_configid, current_desktop);
 
-        IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
         //Update overlay name
         OverlayManager::Get().SetOverlayNameAuto(overlay_id);
@@ -193,9 +193,9 @@ void WindowOverlayBar::UpdateOverlayButtons()
 
                 is_enabled = !is_enabled;
 
-                IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, i);
+                IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, i);
                 IPCManager::Get().PostConfigMessageToDashboardApp(configid_bool_overlay_enabled, is_enabled);
-                IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+                IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
             }
 
             //Quick switch properties via right-click
@@ -346,9 +346,9 @@ void WindowOverlayBar::MenuOverlayButton(unsigned int overlay_id, ImVec2 pos, bo
         {
             is_enabled = !is_enabled;
 
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, (int)overlay_id);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, (int)overlay_id);
             IPCManager::Get().PostConfigMessageToDashboardApp(configid_bool_overlay_enabled, is_enabled);
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
             HideMenus();
         }
@@ -138,7 +138,7 @@ void WindowOverlayProperties::SetActiveOverlayID(unsigned int overlay_id, bool s
         }
 
         //Update tags buffer
-        size_t copied_length = data.ConfigStr[configid_str_overlay_tags].copy(m_BufferOverlayTags, IM_ARRAYSIZE(m_BufferOverlayTags) - 1);
+        size_t copied_length = data.ConfigStr[configid_str_overlay_tags].str().copy(m_BufferOverlayTags, IM_ARRAYSIZE(m_BufferOverlayTags) - 1);
         m_BufferOverlayTags[copied_length] = '\0';
 
         bool has_win32_window_icon = false;
@@ -1189,10 +1189,10 @@ void WindowOverlayProperties::UpdatePageMainCatBrowser()
         if (ImGui::Button(TranslationManager::GetString(tstr_OvrlPropsBrowserClonedConvert)))
         {
             //Send string over to dashboard app so it uses the right URLs during conversion (it doesn't get or need updated URLs during runtime in most other cases)
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, config_overlay_id);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, config_overlay_id);
             IPCManager::Get().SendStringToDashboardApp(configid_str_overlay_browser_url,           data.ConfigStr[configid_str_overlay_browser_url],           UIManager::Get()->GetWindowHandle());
             IPCManager::Get().SendStringToDashboardApp(configid_str_overlay_browser_url_user_last, data.ConfigStr[configid_str_overlay_browser_url_user_last], UIManager::Get()->GetWindowHandle());
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
             OverlayManager::Get().ConvertDuplicatedOverlayToStandalone(m_ActiveOverlayID);
             IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_overlay_make_standalone, (int)m_ActiveOverlayID);
@@ -1232,7 +1232,7 @@ void WindowOverlayProperties::UpdatePageMainCatBrowser()
         else if ( ((m_IsBrowserURLChanged) || (m_PageAppearing == wndovrlprop_page_main)) && (!ImGui::IsItemActive()) )
         {
             //Update buffer if URL changed externally or window/page is appearing while text input isn't active
-            size_t copied_length = data.ConfigStr[configid_str_overlay_browser_url].copy(buffer_url, IM_ARRAYSIZE(buffer_url) - 1);
+            size_t copied_length = data.ConfigStr[configid_str_overlay_browser_url].str().copy(buffer_url, IM_ARRAYSIZE(buffer_url) - 1);
             buffer_url[copied_length] = '\0';
 
             //Enable "Restore Last Input" only when they're actually different
@@ -1253,9 +1253,9 @@ void WindowOverlayProperties::UpdatePageMainCatBrowser()
                 data.ConfigStr[configid_str_overlay_browser_url_user_last] = data.ConfigStr[configid_str_overlay_browser_url];
 
                 //Send string over to dashboard app so it can call SetURL()
-                IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, config_overlay_id);
+                IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, config_overlay_id);
                 IPCManager::Get().SendStringToDashboardApp(configid_str_overlay_browser_url, data.ConfigStr[configid_str_overlay_browser_url], UIManager::Get()->GetWindowHandle());
-                IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+                IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
                 IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_browser_navigate_to_url, config_overlay_id);
 
@@ -1278,7 +1278,7 @@ void WindowOverlayProperties::UpdatePageMainCatBrowser()
         if (ImGui::Button(TranslationManager::GetString(tstr_OvrlPropsBrowserRestore)))
         {
             //This button only changes the input buffer. It doesn't set the url or navigates anywhere.
-            size_t copied_length = data.ConfigStr[configid_str_overlay_browser_url_user_last].copy(buffer_url, IM_ARRAYSIZE(buffer_url) - 1);
+            size_t copied_length = data.ConfigStr[configid_str_overlay_browser_url_user_last].str().copy(buffer_url, IM_ARRAYSIZE(buffer_url) - 1);
             buffer_url[copied_length] = '\0';
 
             can_restore_last_user_input = false;
@@ -1343,9 +1343,9 @@ void WindowOverlayProperties::UpdatePageMainCatBrowser()
 
         if (changed_width)
         {
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, config_overlay_id);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, config_overlay_id);
             IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_user_width, user_width);
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
             //Also set for all overlays using this as duplication source (so reading code doesn't need to care about it being duplicated)
             for (unsigned int overlay_id : OverlayManager::Get().FindDuplicatedOverlaysForOverlay(config_overlay_id))
@@ -1357,9 +1357,9 @@ void WindowOverlayProperties::UpdatePageMainCatBrowser()
         }
         else if (changed_height)
         {
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, config_overlay_id);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, config_overlay_id);
             IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_user_height, user_height);
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
             for (unsigned int overlay_id : OverlayManager::Get().FindDuplicatedOverlaysForOverlay(config_overlay_id))
             {
@@ -1383,9 +1383,9 @@ void WindowOverlayProperties::UpdatePageMainCatBrowser()
         {
             zoom_level = clamp(zoom_level, 0.01f, 8.0f);
 
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, config_overlay_id);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, config_overlay_id);
             IPCManager::Get().PostConfigMessageToDashboardApp(configid_float_overlay_browser_zoom, zoom_level);
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
         }
         vr_keyboard.VRKeyboardInputEnd();
 
@@ -1400,9 +1400,9 @@ void WindowOverlayProperties::UpdatePageMainCatBrowser()
 
         if (ImGui::Checkbox(TranslationManager::GetString(tstr_OvrlPropsBrowserAllowTransparency), &allow_transparency))
         {
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, config_overlay_id);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, config_overlay_id);
             IPCManager::Get().PostConfigMessageToDashboardApp(configid_bool_overlay_browser_allow_transparency, allow_transparency);
-            IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
             is_allow_transparency_pending = !is_allow_transparency_pending; //If it was already pending, then the value is back to what's already applied
         }
@@ -2507,11 +2507,13 @@ void WindowOverlayProperties::UpdatePageCropChange(bool only_restore_settings)
 
         SetActiveOverlayID(m_ActiveOverlayID);
 
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, -1);
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_bool_overlay_crop_enabled, crop_enabled);
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_crop_width,    crop_width);
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_crop_height,   crop_height);
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_crop_x,        crop_x);
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_crop_y,        crop_y);
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
         m_IsConfigDataModified = false;
         return;
@@ -2634,10 +2636,12 @@ void WindowOverlayProperties::UpdatePageCropChange(bool only_restore_settings)
             crop_height = -1;
         }
 
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, -1);
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_crop_width,  crop_width);
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_crop_height, crop_height);
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_crop_x,      crop_x);
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_crop_y,      crop_y);
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
         draggable_rect_base_rect = {(float)crop_x, (float)crop_y, (float)crop_width, (float)crop_height};
     }
@@ -2684,6 +2688,8 @@ void WindowOverlayProperties::UpdatePageCropChange(bool only_restore_settings)
         //Note that we need to clamp the new value as neither the buttons nor the slider on direct input do so (they could, but this is in line with the rest of ImGui)
         crop_x = clamp(crop_x, 0, ovrl_width - 1);
 
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, -1);
+
         if (crop_x + crop_width_before_edit > ovrl_width)
         {
             crop_width = ovrl_width - crop_x;
@@ -2696,6 +2702,7 @@ void WindowOverlayProperties::UpdatePageCropChange(bool only_restore_settings)
         }
 
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_crop_x, crop_x);
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
     }
 
     ImGui::NextColumn();
@@ -2717,6 +2724,8 @@ void WindowOverlayProperties::UpdatePageCropChange(bool only_restore_settings)
     {
         crop_y = clamp(crop_y, 0, ovrl_height - 1);
 
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, -1);
+
         if (crop_y + crop_height_before_edit > ovrl_height)
         {
             crop_height = ovrl_height - crop_y;
@@ -2729,6 +2738,7 @@ void WindowOverlayProperties::UpdatePageCropChange(bool only_restore_settings)
         }
 
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_crop_y, crop_y);
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
     }
 
     ImGui::NextColumn();
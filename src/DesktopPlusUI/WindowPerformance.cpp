@@ -7,6 +7,7 @@
 #include "ImGuiExt.h"
 #include "TextureManager.h"
 #include "InterprocessMessaging.h"
+#include "IPCStats.h"
 #include "Util.h"
 #include "OpenVRExt.h"
 #include "UIManager.h"
@@ -33,6 +34,7 @@ WindowPerformance::WindowPerformance() :
     m_FrameTimeLastIndex(0),
     m_ViveWirelessTemp(-1),
     m_ViveWirelessLogFileLastLine(0),
+    m_IPCStatsTickLast(0),
     m_IsOverlaySharedTextureUpdateNeeded(false)
 {
     ResetCumulativeValues();
@@ -549,6 +551,58 @@ void WindowPerformance::DisplayStatsLarge()
         }
     }
 
+    //--Table IPC (only shown if IPC stats are enabled, debugging aid so not translated)
+    if ( (IPCStats::Get().IsEnabled()) && (!m_IPCStatsRows.empty()) )
+    {
+        //Start at a new row if the previous table ended mid-row
+        while (ImGui::GetColumnIndex() != 0)
+        {
+            ImGui::NextColumn();
+        }
+
+        ImGui::TextColoredUnformatted(ImGui::GetStyleColorVec4(ImGuiCol_ButtonHovered), "IPC Messages");
+        ImGui::NextColumn();
+        ImGui::NextColumn();
+        ImGui::TextUnformatted("Avg / P95:");
+        ImGui::NextColumn();
+        ImGui::NextColumn();
+
+        for (const IPCStatsRow& row : m_IPCStatsRows)
+        {
+            ImGui::Text("%s %u", IPCStats::GetChannelName(row.Channel), row.ID);
+            ImGui::NextColumn();
+
+            ImGui::TextRight(0.0f, "%llu", std::max(row.SendCount, row.LatencyCount));
+            ImGui::NextColumn();
+            ImGui::NextColumn();
+
+            if (row.LatencyCount != 0)
+            {
+                ImGui::TextRight(text_ms_width + right_border_offset, "%.2f / %.2f", row.GetLatencyAverageMs(), row.GetLatencyPercentileMs(0.95f));
+                ImGui::SameLine(0.0f, 0.0f);
+                ImGui::TextUnformatted(" ms");
+            }
+            else
+            {
+                ImGui::PushItemDisabled();
+                ImGui::TextRightUnformatted(right_border_offset, "-");
+                ImGui::PopItemDisabled();
+            }
+            ImGui::NextColumn();
+        }
+
+        //Peer window cache hits and FindWindow() lookups
+        ImGui::TextUnformatted("Window Cache");
+        ImGui::NextColumn();
+
+        ImGui::TextRight(0.0f, "%llu", m_IPCPeerWindowCacheStats.Hits);
+        ImGui::NextColumn();
+        ImGui::NextColumn();
+
+        ImGui::TextRight(right_border_offset, "%llu lookups", m_IPCPeerWindowCacheStats.Lookups);
+        ImGui::NextColumn();
+    }
+
     //Last item rect height is the padding dummy == empty window
     if (ImGui::GetItemRectSize().y == 0.0f)
     {
@@ -941,6 +995,7 @@ void WindowPerformance::UpdateStatValues()
 
     UpdateStatValuesSteamVR();
     UpdateStatValuesViveWireless();
+    UpdateStatValuesIPC();
 }
 
 void WindowPerformance::UpdateStatValuesSteamVR()
@@ -1203,6 +1258,30 @@ void WindowPerformance::UpdateStatValuesViveWireless()
     }
 }
 
+void WindowPerformance::UpdateStatValuesIPC()
+{
+    if (!IPCStats::Get().IsEnabled())
+    {
+        m_IPCStatsRows.clear();
+        return;
+    }
+
+    //Collecting the rows walks all message IDs, so only do it once per second
+    if (m_IPCStatsTickLast + 1000 <= ::GetTickCount64())
+    {
+        m_IPCStatsTickLast = ::GetTickCount64();
+
+        m_IPCStatsRows = IPCStats::Get().GetRows();
+        m_IPCPeerWindowCacheStats = IPCManager::Get().GetPeerWindowCacheStats();
+
+        //Only show the busiest message types, the full list can be found in the dump file written on exit
+        if (m_IPCStatsRows.size() > 5)
+        {
+            m_IPCStatsRows.resize(5);
+        }
+    }
+}
+
 void WindowPerformance::DrawFrameTimeGraphCPU(const ImVec2& graph_size, double plot_xmin, double plot_xmax, double plot_ymax)
 {
     float frame_offset = 1.0f + ImGui::GetStyle().FrameBorderSize;
@@ -6,6 +6,7 @@
 #include "openvr.h"
 
 #include "Win32PerformanceData.h"
+#include "IPCStats.h"
 
 //Taken from ImPlot
 struct ScrollingBufferFrameTime
@@ -111,6 +112,11 @@ class WindowPerformance
         std::wstring m_ViveWirelessLogFileLast;
         int m_ViveWirelessLogFileLastLine;
 
+        //IPC stats
+        std::vector<IPCStatsRow> m_IPCStatsRows;
+        IPCPeerWindowCacheStats m_IPCPeerWindowCacheStats;
+        ULONGLONG m_IPCStatsTickLast;
+
         //Overlay state
         bool m_IsOverlaySharedTextureUpdateNeeded;
 
@@ -119,6 +125,7 @@ class WindowPerformance
         void UpdateStatValues();
         void UpdateStatValuesSteamVR();
         void UpdateStatValuesViveWireless();
+        void UpdateStatValuesIPC();
         void DrawFrameTimeGraphCPU(const ImVec2& graph_size, double plot_xmin, double plot_xmax, double plot_ymax);
         void DrawFrameTimeGraphGPU(const ImVec2& graph_size, double plot_xmin, double plot_xmax, double plot_ymax);
 
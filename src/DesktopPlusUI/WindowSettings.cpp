@@ -56,7 +56,7 @@ void WindowSettings::Hide(bool skip_fade)
 {
     FloatingWindow::Hide();
 
-    ConfigManager::Get().SaveConfigToFile();
+    ConfigManager::Get().SaveConfigToFile(true);
 }
 
 void WindowSettings::ResetTransform(FloatingWindowOverlayStateID state_id)
@@ -0,0 +1,21 @@
+//Standalone runner for IPCRingBenchmark, so the ring buffer can be checked and measured without the rest of Desktop+ (see Makefile)
+//Returns 1 if a check failed or the benchmark couldn't be run
+
+#include <iostream>
+
+#include "../Shared/IPCRingBenchmark.h"
+
+int main()
+{
+    //Same capacity and message sizes as IPCManager uses (IPCRingMessage, IPCRingCopyData with short strings and larger data)
+    const uint32_t capacity = 256 * 1024;
+    const uint32_t payload_sizes[] = {24, 32 + 64, 32 + 4096};
+
+    std::cout << "IPC ring buffer checks\n";
+    const bool checks_passed = IPCRingBenchmark::RunChecks(std::cout);
+
+    std::cout << "\nIPC ring buffer throughput, " << capacity / 1024 << " KB capacity\n";
+    const bool benchmark_done = IPCRingBenchmark::Run(std::cout, capacity, payload_sizes, sizeof(payload_sizes) / sizeof(payload_sizes[0]));
+
+    return ( (checks_passed) && (benchmark_done) ) ? 0 : 1;
+}
@@ -583,7 +583,7 @@ bool ActionManager::LoadActionsFromFile(const char* filename)
     if (!existed)
         return false;
 
-    Ini afile(wpath.c_str());
+    Ini afile(wpath.c_str(), false, true);
 
     for (const auto& uid_str : afile.GetSectionList())
     {
@@ -643,20 +643,22 @@ bool ActionManager::LoadActionsFromFile(const char* filename)
 void ActionManager::SaveActionsToFile()
 {
     std::wstring wpath = WStringConvertFromUTF8( std::string(ConfigManager::Get().GetApplicationPath() + "actions.ini").c_str() );
+    ConfigFileWriter& file_writer = ConfigManager::Get().GetConfigFileWriter();
 
     //Don't write if no actions
     if (m_Actions.empty())
     {
-        //Delete actions file instead of leaving an empty one behind
-        if (FileExists(wpath.c_str()))
+        //Delete actions file instead of leaving an empty one behind (also checking for a queued write that would create it)
+        if ( (file_writer.TakeQueuedWrite(wpath) != nullptr) || (FileExists(wpath.c_str())) )
         {
-            ::DeleteFileW(wpath.c_str());
+            file_writer.QueueDelete(wpath);
         }
 
         return;
     }
 
-    Ini afile(wpath.c_str(), true);
+    std::unique_ptr<Ini> afile_ptr = std::make_unique<Ini>(wpath, true, true);
+    Ini& afile = *afile_ptr;
 
     for (const auto& action_pair : m_Actions)
     {
@@ -696,7 +698,7 @@ void ActionManager::SaveActionsToFile()
         afile.WriteString(uid_str.c_str(), "IconFilename",  action.IconFilename.c_str());
     }
 
-    afile.Save();
+    file_writer.QueueWrite(std::move(afile_ptr));
 }
 
 void ActionManager::RestoreActionsFromDefault()
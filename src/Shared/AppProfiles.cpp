@@ -43,7 +43,7 @@ bool AppProfileManager::LoadProfilesFromFile()
     if (!existed)
         return false;
 
-    Ini pfile(wpath.c_str());
+    Ini pfile(wpath.c_str(), false, true);
 
     for (const auto& section_name : pfile.GetSectionList())
     {
@@ -66,20 +66,29 @@ bool AppProfileManager::LoadProfilesFromFile()
 void AppProfileManager::SaveProfilesToFile()
 {
     std::wstring wpath = WStringConvertFromUTF8( std::string(ConfigManager::Get().GetApplicationPath() + "app_profiles.ini").c_str() );
+    ConfigFileWriter& file_writer = ConfigManager::Get().GetConfigFileWriter();
+
+    //Continue from a still queued write if there is one, as the file on disk is outdated then
+    std::unique_ptr<Ini> pfile_ptr = file_writer.TakeQueuedWrite(wpath);
 
     //Don't write if no profiles
     if (m_Profiles.empty())
     {
         //Delete application profile file instead of leaving an empty one behind
-        if (FileExists(wpath.c_str()))
+        if ( (pfile_ptr != nullptr) || (FileExists(wpath.c_str())) )
         {
-            ::DeleteFileW(wpath.c_str());
+            file_writer.QueueDelete(wpath);
         }
 
         return;
     }
 
-    Ini pfile(wpath.c_str());
+    if (pfile_ptr == nullptr)
+    {
+        pfile_ptr = std::make_unique<Ini>(wpath, false, true);
+    }
+
+    Ini& pfile = *pfile_ptr;
 
     char app_name_buffer[vr::k_unMaxPropertyStringSize]  = "";
 
@@ -115,7 +124,7 @@ void AppProfileManager::SaveProfilesToFile()
         pfile.WriteString(app_key.c_str(), "ActionLeave",    std::to_string(profile.ActionUIDLeave).c_str());
     }
 
-    pfile.Save();
+    file_writer.QueueWrite(std::move(pfile_ptr));
 }
 
 const AppProfile& AppProfileManager::GetProfile(const std::string& app_key)
@@ -252,7 +261,7 @@ bool AppProfileManager::ActivateProfile(const std::string& app_key)
             //If there's no app profile overlay config already active, make sure to save the current normal config first so we can restore it properly later
             if (!m_IsProfileActiveWithOverlayProfile)
             {
-                ConfigManager::Get().SaveConfigToFile();
+                ConfigManager::Get().SaveConfigToFile(true);
             }
         #endif
 
@@ -265,6 +274,7 @@ bool AppProfileManager::ActivateProfile(const std::string& app_key)
 
     if ((!loaded_overlay_profile) && (m_IsProfileActiveWithOverlayProfile))  //Restore normal overlay config if previous profile loaded an overlay profile
     {
+        ConfigManager::Get().GetConfigFileWriter().Flush();     //Make sure the config saved when entering the profile is written
         ConfigManager::Get().LoadMultiOverlayProfileFromFile("../config.ini");
         loaded_overlay_profile = true;
 
@@ -0,0 +1,293 @@
+#include "ConfigDelta.h"
+
+#include <cstring>
+
+#include "InterprocessMessaging.h"
+#include "Util.h"
+
+static const uint32_t k_ConfigDeltaBinaryMagic   = 0x44435044;    //"DPCD"
+static const uint32_t k_ConfigDeltaBinaryVersion = 1;
+
+template <typename T>
+static void ConfigDeltaWriteValue(std::string& str, const T& value)
+{
+    str.append((const char*)&value, sizeof(T));
+}
+
+template <typename T>
+static bool ConfigDeltaReadValue(const std::string& str, size_t& pos, T& value)
+{
+    if (str.size() - pos < sizeof(T))
+        return false;
+
+    memcpy(&value, str.data() + pos, sizeof(T));
+    pos += sizeof(T);
+
+    return true;
+}
+
+void ConfigDelta::Add(ConfigID_Bool configid, bool value, int overlay_id)
+{
+    Entry entry;
+    entry.OverlayID = overlay_id;
+    entry.ConfigID  = ConfigManager::GetWParamForConfigID(configid);
+    entry.Value     = value;
+
+    m_Entries.push_back(std::move(entry));
+}
+
+void ConfigDelta::Add(ConfigID_Int configid, int value, int overlay_id)
+{
+    Entry entry;
+    entry.OverlayID = overlay_id;
+    entry.ConfigID  = ConfigManager::GetWParamForConfigID(configid);
+    entry.Value     = value;
+
+    m_Entries.push_back(std::move(entry));
+}
+
+void ConfigDelta::Add(ConfigID_Float configid, float value, int overlay_id)
+{
+    Entry entry;
+    entry.OverlayID = overlay_id;
+    entry.ConfigID  = ConfigManager::GetWParamForConfigID(configid);
+    entry.Value     = pun_cast<LPARAM, float>(value);
+
+    m_Entries.push_back(std::move(entry));
+}
+
+void ConfigDelta::Add(ConfigID_Handle configid, uint64_t value, int overlay_id)
+{
+    Entry entry;
+    entry.OverlayID = overlay_id;
+    entry.ConfigID  = ConfigManager::GetWParamForConfigID(configid);
+    entry.Value     = (LPARAM)value;
+
+    m_Entries.push_back(std::move(entry));
+}
+
+void ConfigDelta::Add(ConfigID_String configid, const std::string& value, int overlay_id)
+{
+    Entry entry;
+    entry.OverlayID = overlay_id;
+    entry.IsString  = true;
+    entry.ConfigID  = configid;
+    entry.Str       = value;
+
+    m_Entries.push_back(std::move(entry));
+}
+
+void ConfigDelta::AddOverlayDiff(unsigned int overlay_id, const OverlayConfigData& data_old, const OverlayConfigData& data_new, const ConfigDeltaFilter* filter)
+{
+    const int id = (int)overlay_id;
+
+    if (filter != nullptr)
+    {
+        for (ConfigID_Bool configid : filter->BoolIDs)
+        {
+            if (data_old.ConfigBool[configid] != data_new.ConfigBool[configid])
+                Add(configid, data_new.ConfigBool[configid], id);
+        }
+
+        for (ConfigID_Int configid : filter->IntIDs)
+        {
+            if (data_old.ConfigInt[configid] != data_new.ConfigInt[configid])
+                Add(configid, data_new.ConfigInt[configid], id);
+        }
+
+        for (ConfigID_Float configid : filter->FloatIDs)
+        {
+            if (data_old.ConfigFloat[configid] != data_new.ConfigFloat[configid])
+                Add(configid, data_new.ConfigFloat[configid], id);
+        }
+
+        for (ConfigID_Handle configid : filter->HandleIDs)
+        {
+            if (data_old.ConfigHandle[configid] != data_new.ConfigHandle[configid])
+                Add(configid, data_new.ConfigHandle[configid], id);
+        }
+
+        //InternedString comparison is a pointer comparison, so this stays cheap even for long strings
+        for (ConfigID_String configid : filter->StringIDs)
+        {
+            if (data_old.ConfigStr[configid] != data_new.ConfigStr[configid])
+                Add(configid, data_new.ConfigStr[configid], id);
+        }
+
+        return;
+    }
+
+    for (int i = 0; i < configid_bool_overlay_MAX; ++i)
+    {
+        if (data_old.ConfigBool[i] != data_new.ConfigBool[i])
+            Add((ConfigID_Bool)i, data_new.ConfigBool[i], id);
+    }
+
+    for (int i = 0; i < configid_int_overlay_MAX; ++i)
+    {
+        if (data_old.ConfigInt[i] != data_new.ConfigInt[i])
+            Add((ConfigID_Int)i, data_new.ConfigInt[i], id);
+    }
+
+    for (int i = 0; i < configid_float_overlay_MAX; ++i)
+    {
+        if (data_old.ConfigFloat[i] != data_new.ConfigFloat[i])
+            Add((ConfigID_Float)i, data_new.ConfigFloat[i], id);
+    }
+
+    for (int i = 0; i < configid_handle_overlay_MAX; ++i)
+    {
+        if (data_old.ConfigHandle[i] != data_new.ConfigHandle[i])
+            Add((ConfigID_Handle)i, data_new.ConfigHandle[i], id);
+    }
+
+    for (int i = 0; i < configid_str_overlay_MAX; ++i)
+    {
+        if (data_old.ConfigStr[i] != data_new.ConfigStr[i])
+            Add((ConfigID_String)i, data_new.ConfigStr[i], id);
+    }
+}
+
+bool ConfigDelta::IsEmpty() const
+{
+    return m_Entries.empty();
+}
+
+size_t ConfigDelta::GetEntryCount() const
+{
+    return m_Entries.size();
+}
+
+const std::vector<ConfigDelta::Entry>& ConfigDelta::GetEntries() const
+{
+    return m_Entries;
+}
+
+void ConfigDelta::Clear()
+{
+    m_Entries.clear();
+}
+
+std::string ConfigDelta::Serialize() const
+{
+    std::string str;
+
+    ConfigDeltaWriteValue(str, k_ConfigDeltaBinaryMagic);
+    ConfigDeltaWriteValue(str, k_ConfigDeltaBinaryVersion);
+    ConfigDeltaWriteValue(str, (uint32_t)m_Entries.size());
+
+    for (const Entry& entry : m_Entries)
+    {
+        ConfigDeltaWriteValue(str, (int32_t)entry.OverlayID);
+        ConfigDeltaWriteValue(str, (uint8_t)entry.IsString);
+        ConfigDeltaWriteValue(str, (uint32_t)entry.ConfigID);
+
+        if (entry.IsString)
+        {
+            ConfigDeltaWriteValue(str, (uint32_t)entry.Str.size());
+            str.append(entry.Str);
+        }
+        else
+        {
+            ConfigDeltaWriteValue(str, (int64_t)entry.Value);
+        }
+    }
+
+    return str;
+}
+
+bool ConfigDelta::Deserialize(const std::string& str)
+{
+    m_Entries.clear();
+
+    size_t pos = 0;
+    uint32_t magic = 0, version = 0, entry_count = 0;
+
+    if ( (!ConfigDeltaReadValue(str, pos, magic)) || (!ConfigDeltaReadValue(str, pos, version)) || (!ConfigDeltaReadValue(str, pos, entry_count)) )
+        return false;
+
+    if ( (magic != k_ConfigDeltaBinaryMagic) || (version != k_ConfigDeltaBinaryVersion) )
+        return false;
+
+    const uint32_t generic_id_max = configid_bool_MAX + configid_int_MAX + configid_float_MAX + configid_handle_MAX;
+    std::vector<Entry> entries;
+
+    for (uint32_t i = 0; i < entry_count; ++i)
+    {
+        int32_t overlay_id = -1;
+        uint8_t is_string  = 0;
+        uint32_t config_id = 0;
+
+        if ( (!ConfigDeltaReadValue(str, pos, overlay_id)) || (!ConfigDeltaReadValue(str, pos, is_string)) || (!ConfigDeltaReadValue(str, pos, config_id)) )
+            return false;
+
+        if ( (overlay_id < -1) || (config_id >= ((is_string != 0) ? (uint32_t)configid_str_MAX : generic_id_max)) )
+            return false;
+
+        Entry entry;
+        entry.OverlayID = overlay_id;
+        entry.IsString  = (is_string != 0);
+        entry.ConfigID  = config_id;
+
+        if (entry.IsString)
+        {
+            uint32_t length = 0;
+
+            if ( (!ConfigDeltaReadValue(str, pos, length)) || (str.size() - pos < length) )
+                return false;
+
+            entry.Str.assign(str.data() + pos, length);
+            pos += length;
+        }
+        else
+        {
+            int64_t value = 0;
+
+            if (!ConfigDeltaReadValue(str, pos, value))
+                return false;
+
+            entry.Value = (LPARAM)value;
+        }
+
+        entries.push_back(std::move(entry));
+    }
+
+    m_Entries = std::move(entries);
+
+    return true;
+}
+
+void ConfigDelta::Replay(const std::function<void(const MSG&)>& handler) const
+{
+    const int override_id_old = ConfigManager::GetValue(configid_int_state_overlay_current_id_override);
+
+    for (const Entry& entry : m_Entries)
+    {
+        ConfigManager::SetValue(configid_int_state_overlay_current_id_override, entry.OverlayID);
+
+        MSG msg = {0};
+
+        if (entry.IsString)
+        {
+            COPYDATASTRUCT cds;
+            cds.dwData = entry.ConfigID;
+            cds.cbData = (DWORD)entry.Str.length();
+            cds.lpData = (void*)entry.Str.c_str();
+
+            msg.message = WM_COPYDATA;
+            msg.lParam  = (LPARAM)&cds;
+
+            handler(msg);
+        }
+        else
+        {
+            msg.message = IPCManager::Get().GetWin32MessageID(ipcmsg_set_config);
+            msg.wParam  = entry.ConfigID;
+            msg.lParam  = entry.Value;
+
+            handler(msg);
+        }
+    }
+
+    ConfigManager::SetValue(configid_int_state_overlay_current_id_override, override_id_old);
+}
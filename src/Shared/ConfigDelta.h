@@ -0,0 +1,63 @@
+//Compact set of config value changes to send to the other process in a single message instead of one message per value
+//Change sets are built by diffing two config states and are applied by replaying them as regular config messages, so receiving code handles them like any other value change
+//Only values addressable by ConfigIDs are supported. Replay happens in the order the values were added
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#define NOMINMAX
+#include <windows.h>
+
+#include "ConfigManager.h"
+
+//Lists of ConfigIDs to compare when diffing. Overlay IDs only, as global values are not part of OverlayConfigData
+struct ConfigDeltaFilter
+{
+    std::vector<ConfigID_Bool>   BoolIDs;
+    std::vector<ConfigID_Int>    IntIDs;
+    std::vector<ConfigID_Float>  FloatIDs;
+    std::vector<ConfigID_Handle> HandleIDs;
+    std::vector<ConfigID_String> StringIDs;
+};
+
+class ConfigDelta
+{
+    public:
+        struct Entry
+        {
+            int OverlayID = -1;         //-1 for global values
+            bool IsString = false;
+            WPARAM ConfigID = 0;        //Generic ConfigID as used by ipcmsg_set_config, or ConfigID_String if IsString is set
+            LPARAM Value = 0;           //Value as used by ipcmsg_set_config
+            std::string Str;
+        };
+
+    private:
+        std::vector<Entry> m_Entries;
+
+    public:
+        void Add(ConfigID_Bool   configid, bool               value, int overlay_id = -1);
+        void Add(ConfigID_Int    configid, int                value, int overlay_id = -1);
+        void Add(ConfigID_Float  configid, float              value, int overlay_id = -1);
+        void Add(ConfigID_Handle configid, uint64_t           value, int overlay_id = -1);
+        void Add(ConfigID_String configid, const std::string& value, int overlay_id = -1);
+
+        //Adds all overlay values which differ between data_old and data_new. Compares all overlay values addressable by ConfigIDs if filter is nullptr
+        void AddOverlayDiff(unsigned int overlay_id, const OverlayConfigData& data_old, const OverlayConfigData& data_new, const ConfigDeltaFilter* filter = nullptr);
+
+        bool IsEmpty() const;
+        size_t GetEntryCount() const;
+        const std::vector<Entry>& GetEntries() const;
+        void Clear();
+
+        //Serializes into binary data stored as string (contains NUL bytes)
+        std::string Serialize() const;
+        //Deserializes from strings created by above function. Returns false and leaves the delta empty if the data is malformed
+        bool Deserialize(const std::string& str);
+
+        //Calls handler with an ipcmsg_set_config or WM_COPYDATA message for each entry, in the order they were added
+        //configid_int_state_overlay_current_id_override is set for the entry's overlay while calling and restored afterwards
+        void Replay(const std::function<void(const MSG&)>& handler) const;
+};
@@ -0,0 +1,267 @@
+#include "ConfigFileWriter.h"
+
+#include <algorithm>
+#include <iterator>
+#define NOMINMAX
+#include <windows.h>
+
+#include "Util.h"
+#include "Logging.h"
+
+//Time without new writes being queued before the queue is written out
+static const std::chrono::milliseconds k_ConfigFileWriterDelay(500);
+
+static bool ConfigFileWriterGetWriteTime(const std::wstring& filename, uint64_t& write_time)
+{
+    WIN32_FILE_ATTRIBUTE_DATA attr_data;
+    if (::GetFileAttributesExW(filename.c_str(), GetFileExInfoStandard, &attr_data) == 0)
+        return false;
+
+    write_time = ((uint64_t)attr_data.ftLastWriteTime.dwHighDateTime << 32) | attr_data.ftLastWriteTime.dwLowDateTime;
+    return true;
+}
+
+ConfigFileWriter::~ConfigFileWriter()
+{
+    if (m_Thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_ExitRequested = true;
+        }
+
+        m_QueueCV.notify_all();
+        m_Thread.join();        //Writer thread finishes remaining operations before exiting
+    }
+}
+
+void ConfigFileWriter::QueueOperation(QueuedOperation op)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (m_IsDisabled)
+            return;
+
+        auto it = std::find_if(m_Queue.begin(), m_Queue.end(), [&](const QueuedOperation& queued_op){ return (queued_op.FileName == op.FileName); });
+
+        if (it != m_Queue.end())
+        {
+            *it = std::move(op);
+        }
+        else
+        {
+            m_Queue.push_back(std::move(op));
+        }
+
+        m_LastQueueTime = std::chrono::steady_clock::now();
+
+        //Create writer thread on first use
+        if (!m_Thread.joinable())
+        {
+            m_Thread = std::thread(&ConfigFileWriter::WriterThreadMain, this);
+        }
+    }
+
+    m_QueueCV.notify_all();
+}
+
+bool ConfigFileWriter::BuildFile(const std::wstring& filename, const BuildFunction& build_func)
+{
+    auto it = std::find_if(m_Cache.begin(), m_Cache.end(), [&](const CachedFile& file){ return (file.FileName == filename); });
+
+    if (it == m_Cache.end())
+    {
+        m_Cache.emplace_back();
+        it = std::prev(m_Cache.end());
+        it->FileName = filename;
+    }
+
+    CachedFile& file = *it;
+
+    //Read the file (again) if there's nothing cached yet or it was changed or deleted from elsewhere since the last write
+    uint64_t write_time = 0;
+    const bool file_exists = ConfigFileWriterGetWriteTime(filename, write_time);
+
+    if ( (file.IniData == nullptr) || (!file_exists) || (write_time != file.LastWriteTime) )
+    {
+        file.IniData       = std::make_unique<Ini>(filename, false, true);
+        file.LastContents  = (file_exists) ? file.IniData->GetContents() : std::string();
+        file.LastWriteTime = write_time;
+    }
+
+    build_func(*file.IniData);
+
+    if (!file.IniData->SaveIfChanged(file.LastContents))
+    {
+        //Start over from the file on disk next time
+        m_Cache.erase(it);
+        return false;
+    }
+
+    if (!ConfigFileWriterGetWriteTime(filename, file.LastWriteTime))
+    {
+        file.LastWriteTime = 0;
+    }
+
+    return true;
+}
+
+void ConfigFileWriter::QueueWrite(std::unique_ptr<Ini> ini)
+{
+    if (ini == nullptr)
+        return;
+
+    QueuedOperation op;
+    op.FileName = ini->GetFileName();
+    op.IniData  = std::move(ini);
+
+    QueueOperation(std::move(op));
+}
+
+void ConfigFileWriter::QueueBuild(const std::wstring& filename, BuildFunction build_func)
+{
+    if (!build_func)
+        return;
+
+    QueuedOperation op;
+    op.FileName  = filename;
+    op.BuildFunc = std::move(build_func);
+
+    QueueOperation(std::move(op));
+}
+
+void ConfigFileWriter::QueueDelete(const std::wstring& filename)
+{
+    QueuedOperation op;
+    op.FileName = filename;
+
+    QueueOperation(std::move(op));
+}
+
+std::unique_ptr<Ini> ConfigFileWriter::TakeQueuedWrite(const std::wstring& filename)
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    //File on disk is about to change if it's being written right now
+    m_DoneCV.wait(lock, [&](){ return (m_InFlightFileName != filename); });
+
+    auto it = std::find_if(m_Queue.begin(), m_Queue.end(), [&](const QueuedOperation& op){ return (op.FileName == filename); });
+
+    if ( (it == m_Queue.end()) || (it->BuildFunc) )
+        return nullptr;
+
+    std::unique_ptr<Ini> ini = std::move(it->IniData);
+    m_Queue.erase(it);
+
+    //Queued delete, continue with an empty file instead of what's still on disk
+    if (ini == nullptr)
+    {
+        ini = std::make_unique<Ini>(filename, true, true);
+    }
+
+    return ini;
+}
+
+bool ConfigFileWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    if ( (!m_Queue.empty()) || (!m_InFlightFileName.empty()) )
+    {
+        m_FlushRequested = true;
+        m_QueueCV.notify_all();
+
+        m_DoneCV.wait(lock, [&](){ return ( (m_Queue.empty()) && (m_InFlightFileName.empty()) ); });
+    }
+
+    const bool write_failed = m_WriteFailed;
+    m_WriteFailed = false;
+
+    return !write_failed;
+}
+
+void ConfigFileWriter::DiscardCache()
+{
+    Flush();
+
+    //Writer thread doesn't touch the cache while nothing is queued
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Cache.clear();
+}
+
+void ConfigFileWriter::SetDisabled(bool is_disabled)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_IsDisabled = is_disabled;
+}
+
+void ConfigFileWriter::WriterThreadMain()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    for (;;)
+    {
+        m_QueueCV.wait(lock, [&](){ return ( (!m_Queue.empty()) || (m_ExitRequested) ); });
+
+        //Wait until no new writes have been queued for a while
+        while ( (!m_Queue.empty()) && (!m_FlushRequested) && (!m_ExitRequested) )
+        {
+            const auto write_time = m_LastQueueTime + k_ConfigFileWriterDelay;
+
+            if (std::chrono::steady_clock::now() >= write_time)
+                break;
+
+            m_QueueCV.wait_until(lock, write_time);
+        }
+
+        while ( (!m_Queue.empty()) && ( (m_FlushRequested) || (m_ExitRequested) || (std::chrono::steady_clock::now() >= m_LastQueueTime + k_ConfigFileWriterDelay) ) )
+        {
+            QueuedOperation op = std::move(m_Queue.front());
+            m_Queue.erase(m_Queue.begin());
+            m_InFlightFileName = op.FileName;
+
+            lock.unlock();
+
+            bool write_ok = true;
+
+            if (op.BuildFunc)
+            {
+                write_ok = BuildFile(op.FileName, op.BuildFunc);
+            }
+            else
+            {
+                //File is replaced as a whole, so any cached contents are outdated
+                m_Cache.erase(std::remove_if(m_Cache.begin(), m_Cache.end(), [&](const CachedFile& file){ return (file.FileName == op.FileName); }), m_Cache.end());
+
+                if (op.IniData != nullptr)
+                {
+                    write_ok = op.IniData->Save();
+                }
+                else
+                {
+                    ::DeleteFileW(op.FileName.c_str());
+                    Ini::DeleteSnapshot(op.FileName);
+                }
+            }
+
+            LOG_IF_F(ERROR, !write_ok, "Failed to write \"%s\"", StringConvertFromUTF16(op.FileName.c_str()).c_str());
+
+            lock.lock();
+
+            m_WriteFailed |= !write_ok;
+
+            m_InFlightFileName.clear();
+            m_DoneCV.notify_all();
+        }
+
+        if (m_Queue.empty())
+        {
+            m_FlushRequested = false;
+            m_DoneCV.notify_all();
+
+            if (m_ExitRequested)
+                break;
+        }
+    }
+}
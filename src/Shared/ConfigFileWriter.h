@@ -0,0 +1,74 @@
+//Writes config files from a background thread so saving doesn't stall the UI
+//Queued writes are only carried out once nothing new has been queued for a short while, so bursts of saves result in a single write
+//Writes of the same file replace each other while they're still queued. Ini::Save() swaps in the written file, so it's never left truncated
+//Files can also be queued as build functions, which fill in the file's contents on the writer thread. The writer keeps the contents of those files
+//in memory, so they're only read from disk again when changed from elsewhere, and skips writing them when the result didn't change
+
+#pragma once
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "Ini.h"
+
+class ConfigFileWriter
+{
+    public:
+        typedef std::function<void(Ini&)> BuildFunction;
+
+    private:
+        struct QueuedOperation
+        {
+            std::wstring FileName;
+            std::unique_ptr<Ini> IniData;                                       //Written as is if not nullptr
+            BuildFunction BuildFunc;                                            //Otherwise applied to the cached file if set, otherwise the file is deleted
+        };
+
+        struct CachedFile
+        {
+            std::wstring FileName;
+            std::unique_ptr<Ini> IniData;
+            std::string LastContents;                                           //What was last read or written, used to skip writes without changes
+            uint64_t LastWriteTime = 0;                                         //File time after the last write, to notice changes from elsewhere
+        };
+
+        //- Protected by m_Mutex
+        std::mutex m_Mutex;
+        std::vector<QueuedOperation> m_Queue;
+        std::chrono::steady_clock::time_point m_LastQueueTime;
+        std::wstring m_InFlightFileName;
+        bool m_FlushRequested = false;
+        bool m_ExitRequested  = false;
+        bool m_WriteFailed    = false;
+        bool m_IsDisabled     = false;
+
+        std::condition_variable m_QueueCV;                                      //Wakes up the writer thread
+        std::condition_variable m_DoneCV;                                       //Wakes up threads waiting for writes to finish
+
+        std::thread m_Thread;
+
+        //- Only accessed by the writer thread, or while nothing is queued or in flight
+        std::vector<CachedFile> m_Cache;
+
+        void QueueOperation(QueuedOperation op);
+        bool BuildFile(const std::wstring& filename, const BuildFunction& build_func);
+        void WriterThreadMain();
+
+    public:
+        ~ConfigFileWriter();
+
+        void QueueWrite(std::unique_ptr<Ini> ini);                              //Saves the Ini to its file name
+        void QueueBuild(const std::wstring& filename, BuildFunction build_func); //Calls build_func on the writer thread with the file's cached Ini and saves it if it changed
+        void QueueDelete(const std::wstring& filename);                         //Deletes the file (and its snapshot)
+        std::unique_ptr<Ini> TakeQueuedWrite(const std::wstring& filename);     //Removes a queued write and returns it for further changes. Returns nullptr if there is none (or a build is queued instead)
+        bool Flush();                                                           //Carries out all queued operations right away and waits for them to finish. Returns false if any write since the last flush failed
+        void DiscardCache();                                                    //Flushes and drops cached files, so the next build reads them from disk again
+        void SetDisabled(bool is_disabled);                                     //Operations queued while disabled are dropped
+};
@@ -3,13 +3,22 @@
 #include <algorithm>
 #include <sstream>
 #include <fstream>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstring>
 
 #include "Util.h"
 #include "OpenVRExt.h"
 #include "Logging.h"
 #include "Ini.h"
+#include "OverlayConfigSchema.h"
+#include "ConfigDelta.h"
 #include "OverlayManager.h"
 #include "InterprocessMessaging.h"
+#include "IPCStats.h"
 #include "WindowManager.h"
 #include "DesktopPlusWinRT.h"
 #include "DPBrowserAPIClient.h"
@@ -17,8 +26,14 @@
 #ifdef DPLUS_UI
     #include "UIManager.h"
     #include "TranslationManager.h"
+    #include "OverlayProfileCatalog.h"
 #else
     #include "WindowManager.h"
+    #include "OutputManager.h"
+#endif
+
+#ifdef DPLUS_UI
+    static OverlayProfileCatalog g_OverlayProfileCatalog;   //Defined before g_ConfigManager as its constructor sets the directory
 #endif
 
 static ConfigManager g_ConfigManager;
@@ -76,6 +91,32 @@ void ConfigHotkey::Deserialize(const std::string& str)
 }
 
 
+bool ConfigSnapshot::GetValue(ConfigID_Bool configid) const
+{
+    return ConfigBool[configid];
+}
+
+int ConfigSnapshot::GetValue(ConfigID_Int configid) const
+{
+    return ConfigInt[configid];
+}
+
+float ConfigSnapshot::GetValue(ConfigID_Float configid) const
+{
+    return ConfigFloat[configid];
+}
+
+uint64_t ConfigSnapshot::GetValue(ConfigID_Handle configid) const
+{
+    return ConfigHandle[configid];
+}
+
+const std::string& ConfigSnapshot::GetValue(ConfigID_String configid) const
+{
+    return (*ConfigString)[configid];
+}
+
+
 OverlayConfigData::OverlayConfigData()
 {
     std::fill(std::begin(ConfigBool),   std::end(ConfigBool),   false);
@@ -145,10 +186,17 @@ ConfigManager::ConfigManager() : m_IsSteamInstall(false)
         m_IsSteamInstall = (path_wstr.find(L"\\steamapps\\common\\desktopplus\\desktopplus") != std::wstring::npos); 
     }
 
+    #ifdef DPLUS_UI
+        g_OverlayProfileCatalog.SetDirectory( WStringConvertFromUTF8(std::string(m_ApplicationPath + "profiles/").c_str()) );
+    #endif
+
     delete[] buffer;
 
     //Check if UIAccess is enabled
     m_ConfigBool[configid_bool_state_misc_uiaccess_enabled] = IsUIAccessEnabled();
+
+    //Publish initial snapshot so there always is one
+    PublishSnapshot();
 }
 
 ConfigManager& ConfigManager::Get()
@@ -156,75 +204,143 @@ ConfigManager& ConfigManager::Get()
     return g_ConfigManager;
 }
 
-void ConfigManager::LoadOverlayProfile(const Ini& config, unsigned int overlay_id)
+//Worker threads for ConfigManagerParallelFor(). They're started on first use and then wait for further jobs instead of being started for every call
+class ConfigManagerWorkerPool
 {
-    OverlayConfigData& data = OverlayManager::Get().GetCurrentConfigData();
-    unsigned int current_id = OverlayManager::Get().GetCurrentOverlayID();
+    private:
+        std::vector<std::thread> m_Threads;
+        std::mutex m_Mutex;
+        std::condition_variable m_JobCV;
+        std::condition_variable m_DoneCV;
+        const std::function<void(size_t)>* m_Func = nullptr;
+        size_t m_Count = 0;
+        std::atomic<size_t> m_NextIndex {0};
+        unsigned int m_JobID = 0;
+        size_t m_BusyCount = 0;
+        bool m_ExitRequested = false;
+
+        void RunJob(const std::function<void(size_t)>& func, size_t count)
+        {
+            for (size_t i = m_NextIndex++; i < count; i = m_NextIndex++)
+            {
+                func(i);
+            }
+        }
+
+        void WorkerThreadMain()
+        {
+            unsigned int job_id_last = 0;
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            for (;;)
+            {
+                m_JobCV.wait(lock, [&]{ return ( (m_ExitRequested) || (m_JobID != job_id_last) ); });
+
+                if (m_ExitRequested)
+                    return;
+
+                job_id_last = m_JobID;
+                const std::function<void(size_t)>& func = *m_Func;
+                const size_t count = m_Count;
 
+                lock.unlock();
+                RunJob(func, count);
+                lock.lock();
+
+                if (--m_BusyCount == 0)
+                {
+                    m_DoneCV.notify_all();
+                }
+            }
+        }
+
+    public:
+        ConfigManagerWorkerPool(size_t thread_count)
+        {
+            for (size_t i = 0; i < thread_count; ++i)
+            {
+                m_Threads.emplace_back(&ConfigManagerWorkerPool::WorkerThreadMain, this);
+            }
+        }
+
+        ~ConfigManagerWorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_ExitRequested = true;
+            }
+
+            m_JobCV.notify_all();
+
+            for (std::thread& thread : m_Threads)
+            {
+                thread.join();
+            }
+        }
+
+        //Not reentrant, only one thread may run jobs at a time
+        void Run(size_t count, const std::function<void(size_t)>& func)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Func  = &func;
+                m_Count = count;
+                m_NextIndex = 0;
+                m_BusyCount = m_Threads.size();
+                m_JobID++;
+            }
+
+            m_JobCV.notify_all();
+
+            RunJob(func, count);
+
+            //Workers still reference func until they're done
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_DoneCV.wait(lock, [&]{ return (m_BusyCount == 0); });
+            m_Func = nullptr;
+        }
+};
+
+//Calls func(i) for every i in [0, count), spread over the worker threads if count is large enough to be worth it
+//The calling thread takes part and the function returns once all calls have finished
+//Decoding a section only takes a few microseconds, so typical profiles are faster to decode on the calling thread than waking up workers for them
+static void ConfigManagerParallelFor(size_t count, const std::function<void(size_t)>& func)
+{
+    const size_t min_items_parallel = 64;
+    const size_t max_threads = 4;
+
+    const size_t thread_count = std::min(max_threads, (size_t)std::max(std::thread::hardware_concurrency(), 1u));
+
+    if ( (count < min_items_parallel) || (thread_count <= 1) )
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            func(i);
+        }
+
+        return;
+    }
+
+    static ConfigManagerWorkerPool worker_pool(thread_count - 1);
+    worker_pool.Run(count, func);
+}
+
+void ConfigManager::LoadOverlayProfile(const Ini& config, unsigned int overlay_id)
+{
     std::stringstream ss;
     ss << "Overlay" << overlay_id;
 
     std::string section = ss.str();
 
-    data.ConfigNameStr = config.ReadString(section.c_str(), "Name");
-
-    data.ConfigBool[configid_bool_overlay_name_custom]                  = config.ReadBool(section.c_str(),   "NameIsCustom", false);
-    data.ConfigBool[configid_bool_overlay_enabled]                      = config.ReadBool(section.c_str(),   "Enabled", true);
-    data.ConfigInt[configid_int_overlay_desktop_id]                     = config.ReadInt(section.c_str(),    "DesktopID", 0);
-    data.ConfigInt[configid_int_overlay_capture_source]                 = config.ReadInt(section.c_str(),    "CaptureSource", ovrl_capsource_desktop_duplication);
-    data.ConfigInt[configid_int_overlay_duplication_id]                 = config.ReadInt(section.c_str(),    "DuplicationID", -1);
-    data.ConfigInt[configid_int_overlay_winrt_desktop_id]               = config.ReadInt(section.c_str(),    "WinRTDesktopID", -2);
-    data.ConfigBool[configid_bool_overlay_winrt_window_matching_strict] = config.ReadBool(section.c_str(),   "WinRTWindowMatchingStrict", false);
-    data.ConfigStr[configid_str_overlay_winrt_last_window_title]        = config.ReadString(section.c_str(), "WinRTLastWindowTitle");
-    data.ConfigStr[configid_str_overlay_winrt_last_window_class_name]   = config.ReadString(section.c_str(), "WinRTLastWindowClassName");
-    data.ConfigStr[configid_str_overlay_winrt_last_window_exe_name]     = config.ReadString(section.c_str(), "WinRTLastWindowExeName");
-    data.ConfigStr[configid_str_overlay_browser_url]                    = config.ReadString(section.c_str(), "BrowserURL");
-    data.ConfigStr[configid_str_overlay_browser_url_user_last]          = config.ReadString(section.c_str(), "BrowserURLUserLast");
-    data.ConfigStr[configid_str_overlay_browser_title]                  = config.ReadString(section.c_str(), "BrowserTitle");
-    data.ConfigBool[configid_bool_overlay_browser_allow_transparency]   = config.ReadBool(section.c_str(),   "BrowserAllowTransparency", false);
-    data.ConfigFloat[configid_float_overlay_width]                      = clamp(config.ReadInt(section.c_str(), "Width", 165)    / 100.0f, 0.00001f, 1000.0f);
-    data.ConfigFloat[configid_float_overlay_curvature]                  = clamp(config.ReadInt(section.c_str(), "Curvature", 17) / 100.0f, 0.0f,     1.0f);
-    data.ConfigFloat[configid_float_overlay_opacity]                    = config.ReadInt(section.c_str(),    "Opacity", 100) / 100.0f;
-    data.ConfigFloat[configid_float_overlay_brightness]                 = config.ReadInt(section.c_str(),    "Brightness", 100) / 100.0f;
-    data.ConfigFloat[configid_float_overlay_browser_zoom]               = config.ReadInt(section.c_str(),    "BrowserZoom", 100) / 100.0f;
-    data.ConfigFloat[configid_float_overlay_offset_right]               = config.ReadInt(section.c_str(),    "OffsetRight", 0) / 100.0f;
-    data.ConfigFloat[configid_float_overlay_offset_up]                  = config.ReadInt(section.c_str(),    "OffsetUp", 0) / 100.0f;
-    data.ConfigFloat[configid_float_overlay_offset_forward]             = config.ReadInt(section.c_str(),    "OffsetForward", 0) / 100.0f;
-    data.ConfigInt[configid_int_overlay_user_width]                     = config.ReadInt(section.c_str(),    "UserWidth", 1280);
-    data.ConfigInt[configid_int_overlay_user_height]                    = config.ReadInt(section.c_str(),    "UserHeight", 720);
-    data.ConfigInt[configid_int_overlay_display_mode]                   = config.ReadInt(section.c_str(),    "DisplayMode", ovrl_dispmode_always);
-    data.ConfigInt[configid_int_overlay_origin]                         = GetOverlayOriginFromConfigString(config.ReadString(section.c_str(), "Origin"));
-    data.ConfigBool[configid_bool_overlay_origin_hmd_floor_use_turning] = config.ReadBool(section.c_str(),   "OriginHMDFloorTurning", false);
-    data.ConfigBool[configid_bool_overlay_transform_locked]             = config.ReadBool(section.c_str(),   "TransformLocked", false);
-
-    data.ConfigBool[configid_bool_overlay_crop_enabled]                 = config.ReadBool(section.c_str(), "CroppingEnabled", false);
-    data.ConfigInt[configid_int_overlay_crop_x]                         = config.ReadInt(section.c_str(),  "CroppingX", 0);
-    data.ConfigInt[configid_int_overlay_crop_y]                         = config.ReadInt(section.c_str(),  "CroppingY", 0);
-    data.ConfigInt[configid_int_overlay_crop_width]                     = config.ReadInt(section.c_str(),  "CroppingWidth", -1);
-    data.ConfigInt[configid_int_overlay_crop_height]                    = config.ReadInt(section.c_str(),  "CroppingHeight", -1);
-
-    data.ConfigBool[configid_bool_overlay_3D_enabled]                   = config.ReadBool(section.c_str(),   "3DEnabled", false);
-    data.ConfigInt[configid_int_overlay_3D_mode]                        = config.ReadInt(section.c_str(),    "3DMode", ovrl_3Dmode_hsbs);
-    data.ConfigBool[configid_bool_overlay_3D_swapped]                   = config.ReadBool(section.c_str(),   "3DSwapped", false);
-    data.ConfigBool[configid_bool_overlay_gazefade_enabled]             = config.ReadBool(section.c_str(),   "GazeFade", false);
-    data.ConfigFloat[configid_float_overlay_gazefade_distance]          = config.ReadInt(section.c_str(),    "GazeFadeDistance", 0) / 100.0f;
-    data.ConfigFloat[configid_float_overlay_gazefade_rate]              = config.ReadInt(section.c_str(),    "GazeFadeRate", 100) / 100.0f;
-    data.ConfigFloat[configid_float_overlay_gazefade_opacity]           = config.ReadInt(section.c_str(),    "GazeFadeOpacity", 0) / 100.0f;
-    data.ConfigInt[configid_int_overlay_update_limit_override_mode]     = config.ReadInt(section.c_str(),    "UpdateLimitModeOverride", update_limit_mode_off);
-    data.ConfigFloat[configid_float_overlay_update_limit_override_ms]   = config.ReadInt(section.c_str(),    "UpdateLimitMS", 0) / 100.0f;
-    data.ConfigInt[configid_int_overlay_update_limit_override_fps]      = config.ReadInt(section.c_str(),    "UpdateLimitFPS", update_limit_fps_30);
-    data.ConfigInt[configid_int_overlay_browser_max_fps_override]       = config.ReadInt(section.c_str(),    "BrowserMaxFPSOverride", -1);
-    data.ConfigBool[configid_bool_overlay_input_enabled]                = config.ReadBool(section.c_str(),   "InputEnabled", true);
-    data.ConfigBool[configid_bool_overlay_input_dplus_lp_enabled]       = config.ReadBool(section.c_str(),   "InputDPlusLPEnabled", true);
-    data.ConfigStr[configid_str_overlay_tags]                           = config.ReadString(section.c_str(), "Tags");
-    data.ConfigBool[configid_bool_overlay_update_invisible]             = config.ReadBool(section.c_str(),   "UpdateInvisible", false);
-
-    data.ConfigBool[configid_bool_overlay_floatingui_enabled]           = config.ReadBool(section.c_str(), "ShowFloatingUI", true);
-    data.ConfigBool[configid_bool_overlay_floatingui_desktops_enabled]  = config.ReadBool(section.c_str(), "ShowDesktopButtons", false);
-    data.ConfigBool[configid_bool_overlay_floatingui_extras_enabled]    = config.ReadBool(section.c_str(), "ShowExtraButtons", true);
-    data.ConfigBool[configid_bool_overlay_actionbar_enabled]            = config.ReadBool(section.c_str(), "ShowActionBar", false);
-    data.ConfigBool[configid_bool_overlay_actionbar_order_use_global]   = config.ReadBool(section.c_str(), "ActionBarOrderUseGlobal", true);
-    data.ConfigActionBarOrder                                           = m_ActionManager.ActionOrderListFromString( config.ReadString(section.c_str(), "ActionBarOrderCustom") );
+    OverlayConfigSchema::LoadSection(OverlayManager::Get().GetCurrentConfigData(), config, section.c_str());
+
+    FinishOverlayProfileLoad(overlay_id);
+}
+
+void ConfigManager::FinishOverlayProfileLoad(unsigned int overlay_id)
+{
+    OverlayConfigData& data = OverlayManager::Get().GetCurrentConfigData();
+    unsigned int current_id = OverlayManager::Get().GetCurrentOverlayID();
 
     bool do_set_auto_name = ( (!data.ConfigBool[configid_bool_overlay_name_custom]) && (data.ConfigNameStr.empty()) );
 
@@ -258,22 +374,13 @@ void ConfigManager::LoadOverlayProfile(const Ini& config, unsigned int overlay_i
         data.ConfigInt[configid_int_overlay_desktop_id] = OverlayManager::Get().GetConfigData(0).ConfigInt[configid_int_overlay_desktop_id];
     }
 
-    //Default the transform matrix to zero
-    float matrix_zero[16] = { 0.0f };
-    data.ConfigTransform = matrix_zero;
-
-    std::string transform_str; //Only set these when it's really present in the file, or else it defaults to identity instead of zero
-    transform_str = config.ReadString(section.c_str(), "Transform");
-    if (!transform_str.empty())
-        data.ConfigTransform = transform_str;
-
     #ifdef DPLUS_UI
     //When loading an UI overlay, send config state over to ensure the correct process has rendering access even if the UI was restarted at some point
     if (data.ConfigInt[configid_int_overlay_capture_source] == ovrl_capsource_ui)
     {
-        IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, (int)overlay_id);
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_begin, (int)overlay_id);
         IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_overlay_capture_source, ovrl_capsource_ui);
-        IPCManager::Get().PostConfigMessageToDashboardApp(configid_int_state_overlay_current_id_override, -1);
+        IPCManager::Get().PostMessageToDashboardApp(ipcmsg_action, ipcact_config_transaction_commit);
 
         UIManager::Get()->GetPerformanceWindow().ScheduleOverlaySharedTextureUpdate();
     }
@@ -293,105 +400,25 @@ void ConfigManager::LoadOverlayProfile(const Ini& config, unsigned int overlay_i
     #endif //DPLUS_UI
 }
 
-void ConfigManager::SaveOverlayProfile(Ini& config, unsigned int overlay_id)
+void ConfigManager::SaveOverlayProfile(Ini& config, const OverlayConfigData& data, unsigned int overlay_id)
 {
-    const OverlayConfigData& data = OverlayManager::Get().GetCurrentConfigData();
-
     std::stringstream ss;
     ss << "Overlay" << overlay_id;
 
-    std::string section = ss.str();
-
-    config.WriteString(section.c_str(), "Name", data.ConfigNameStr.c_str());
-
-    config.WriteBool(section.c_str(),   "NameIsCustom",           data.ConfigBool[configid_bool_overlay_name_custom]);
-    config.WriteBool(section.c_str(),   "Enabled",                data.ConfigBool[configid_bool_overlay_enabled]);
-    config.WriteInt( section.c_str(),   "DesktopID",              data.ConfigInt[configid_int_overlay_desktop_id]);
-    config.WriteInt( section.c_str(),   "CaptureSource",          data.ConfigInt[configid_int_overlay_capture_source]);
-    config.WriteInt( section.c_str(),   "DuplicationID",          data.ConfigInt[configid_int_overlay_duplication_id]);
-    config.WriteInt( section.c_str(),   "Width",              int(data.ConfigFloat[configid_float_overlay_width]           * 100.0f));
-    config.WriteInt( section.c_str(),   "Curvature",          int(data.ConfigFloat[configid_float_overlay_curvature]       * 100.0f));
-    config.WriteInt( section.c_str(),   "Opacity",            int(data.ConfigFloat[configid_float_overlay_opacity]         * 100.0f));
-    config.WriteInt( section.c_str(),   "Brightness",         int(data.ConfigFloat[configid_float_overlay_brightness]      * 100.0f));
-    config.WriteInt( section.c_str(),   "BrowserZoom",        int(data.ConfigFloat[configid_float_overlay_browser_zoom]    * 100.0f));
-    config.WriteInt( section.c_str(),   "OffsetRight",        int(data.ConfigFloat[configid_float_overlay_offset_right]    * 100.0f));
-    config.WriteInt( section.c_str(),   "OffsetUp",           int(data.ConfigFloat[configid_float_overlay_offset_up]       * 100.0f));
-    config.WriteInt( section.c_str(),   "OffsetForward",      int(data.ConfigFloat[configid_float_overlay_offset_forward]  * 100.0f));
-    config.WriteInt( section.c_str(),   "UserWidth",              data.ConfigInt[configid_int_overlay_user_width]);
-    config.WriteInt( section.c_str(),   "UserHeight",             data.ConfigInt[configid_int_overlay_user_height]);
-    config.WriteInt( section.c_str(),   "DisplayMode",            data.ConfigInt[configid_int_overlay_display_mode]);
-    config.WriteString(section.c_str(), "Origin",                 GetConfigStringForOverlayOrigin((OverlayOrigin)data.ConfigInt[configid_int_overlay_origin]));
-    config.WriteBool(section.c_str(),   "OriginHMDFloorTurning",  data.ConfigBool[configid_bool_overlay_origin_hmd_floor_use_turning]);
-    config.WriteBool(section.c_str(),   "TransformLocked",        data.ConfigBool[configid_bool_overlay_transform_locked]);
-
-    config.WriteBool(section.c_str(), "CroppingEnabled",        data.ConfigBool[configid_bool_overlay_crop_enabled]);
-    config.WriteInt( section.c_str(), "CroppingX",              data.ConfigInt[configid_int_overlay_crop_x]);
-    config.WriteInt( section.c_str(), "CroppingY",              data.ConfigInt[configid_int_overlay_crop_y]);
-    config.WriteInt( section.c_str(), "CroppingWidth",          data.ConfigInt[configid_int_overlay_crop_width]);
-    config.WriteInt( section.c_str(), "CroppingHeight",         data.ConfigInt[configid_int_overlay_crop_height]);
-
-    config.WriteBool(section.c_str(),   "3DEnabled",              data.ConfigBool[configid_bool_overlay_3D_enabled]);
-    config.WriteInt( section.c_str(),   "3DMode",                 data.ConfigInt[configid_int_overlay_3D_mode]);
-    config.WriteBool(section.c_str(),   "3DSwapped",              data.ConfigBool[configid_bool_overlay_3D_swapped]);
-    config.WriteBool(section.c_str(),   "GazeFade",               data.ConfigBool[configid_bool_overlay_gazefade_enabled]);
-    config.WriteInt( section.c_str(),   "GazeFadeDistance",   int(data.ConfigFloat[configid_float_overlay_gazefade_distance] * 100.0f));
-    config.WriteInt( section.c_str(),   "GazeFadeRate",       int(data.ConfigFloat[configid_float_overlay_gazefade_rate]     * 100.0f));
-    config.WriteInt( section.c_str(),   "GazeFadeOpacity",    int(data.ConfigFloat[configid_float_overlay_gazefade_opacity]  * 100.0f));
-    config.WriteInt( section.c_str(),   "UpdateLimitModeOverride",data.ConfigInt[configid_int_overlay_update_limit_override_mode]);
-    config.WriteInt( section.c_str(),   "UpdateLimitMS",      int(data.ConfigFloat[configid_float_overlay_update_limit_override_ms] * 100.0f));
-    config.WriteInt( section.c_str(),   "UpdateLimitFPS",         data.ConfigInt[configid_int_overlay_update_limit_override_fps]);
-    config.WriteInt( section.c_str(),   "BrowserMaxFPSOverride",  data.ConfigInt[configid_int_overlay_browser_max_fps_override]);
-    config.WriteBool(section.c_str(),   "InputEnabled",           data.ConfigBool[configid_bool_overlay_input_enabled]);
-    config.WriteBool(section.c_str(),   "InputDPlusLPEnabled",    data.ConfigBool[configid_bool_overlay_input_dplus_lp_enabled]);
-    config.WriteString(section.c_str(), "Tags",                   data.ConfigStr[configid_str_overlay_tags].c_str());
-    config.WriteBool(section.c_str(),   "UpdateInvisible",        data.ConfigBool[configid_bool_overlay_update_invisible]);
-
-    config.WriteBool(  section.c_str(), "ShowFloatingUI",          data.ConfigBool[configid_bool_overlay_floatingui_enabled]);
-    config.WriteBool(  section.c_str(), "ShowDesktopButtons",      data.ConfigBool[configid_bool_overlay_floatingui_desktops_enabled]);
-    config.WriteBool(  section.c_str(), "ShowExtraButtons",        data.ConfigBool[configid_bool_overlay_floatingui_extras_enabled]);
-    config.WriteBool(  section.c_str(), "ShowActionBar",           data.ConfigBool[configid_bool_overlay_actionbar_enabled]);
-    config.WriteBool(  section.c_str(), "ActionBarOrderUseGlobal", data.ConfigBool[configid_bool_overlay_actionbar_order_use_global]);
-    config.WriteString(section.c_str(), "ActionBarOrderCustom",    ActionManager::ActionOrderListToString(data.ConfigActionBarOrder).c_str());
-
-    config.WriteString(section.c_str(), "Transform", data.ConfigTransform.toString().c_str());
-
-    //Save WinRT Capture state
-    HWND window_handle = (HWND)data.ConfigHandle[configid_handle_overlay_state_winrt_hwnd];
-    std::string last_window_title, last_window_class_name, last_window_exe_name;
-
-    if (window_handle != nullptr)
-    {
-        WindowInfo info(window_handle);
-
-        last_window_title      = StringConvertFromUTF16(info.GetTitle().c_str());
-        last_window_class_name = StringConvertFromUTF16(info.GetWindowClassName().c_str());
-        last_window_exe_name   = info.GetExeName();
-    }
-
-    if (last_window_title.empty()) //Save last known title and exe name even when handle is nullptr or getting title failed so we can still restore the window on the next load if it happens to exist
-    {
-        last_window_title      = data.ConfigStr[configid_str_overlay_winrt_last_window_title];
-        last_window_class_name = data.ConfigStr[configid_str_overlay_winrt_last_window_class_name];
-        last_window_exe_name   = data.ConfigStr[configid_str_overlay_winrt_last_window_exe_name];
-    }
-
-    config.WriteString(section.c_str(), "WinRTLastWindowTitle",      last_window_title.c_str());
-    config.WriteString(section.c_str(), "WinRTLastWindowClassName",  last_window_class_name.c_str());
-    config.WriteString(section.c_str(), "WinRTLastWindowExeName",    last_window_exe_name.c_str());
-    config.WriteInt(   section.c_str(), "WinRTDesktopID",            data.ConfigInt[configid_int_overlay_winrt_desktop_id]);
-    config.WriteBool(  section.c_str(), "WinRTWindowMatchingStrict", data.ConfigBool[configid_bool_overlay_winrt_window_matching_strict]);
-
-    //Browser
-    config.WriteString(section.c_str(), "BrowserURL",               data.ConfigStr[configid_str_overlay_browser_url].c_str());
-    config.WriteString(section.c_str(), "BrowserURLUserLast",       data.ConfigStr[configid_str_overlay_browser_url_user_last].c_str());
-    config.WriteString(section.c_str(), "BrowserTitle",             data.ConfigStr[configid_str_overlay_browser_title].c_str());
-    config.WriteBool(  section.c_str(), "BrowserAllowTransparency", data.ConfigBool[configid_bool_overlay_browser_allow_transparency]);
+    OverlayConfigSchema::SaveSection(data, config, ss.str().c_str());
 }
 
 bool ConfigManager::LoadConfigFromFile()
 {
     LOG_F(INFO, "Loading config...");
 
+    //Finish queued writes and drop cached files before reading any of the files
+    m_ConfigFileWriter.DiscardCache();
+
+    //Values are written directly while loading, so the next snapshot has to include everything
+    m_IsSnapshotDirty       = true;
+    m_IsSnapshotStringDirty = true;
+
     //Prioritize config_newui.ini if it exists (will be deleted on save to rename)
     bool using_config_newui_file = true;
     std::wstring wpath = WStringConvertFromUTF8( std::string(m_ApplicationPath + "config_newui.ini").c_str() );
@@ -411,7 +438,7 @@ bool ConfigManager::LoadConfigFromFile()
         LOG_F(INFO, "Config file not found. Loading default config file instead");
     }
 
-    Ini config(wpath.c_str());
+    Ini config(wpath.c_str(), false, true);
 
     const int config_version = config.ReadInt("Misc", "ConfigVersion", 1);
 
@@ -593,6 +620,9 @@ bool ConfigManager::LoadConfigFromFile()
     m_ConfigBool[configid_bool_performance_monitor_show_trackers]           = config.ReadBool("Performance", "PerformanceMonitorShowTrackers", true);
     m_ConfigBool[configid_bool_performance_monitor_show_vive_wireless]      = config.ReadBool("Performance", "PerformanceMonitorShowViveWireless", false);
     m_ConfigBool[configid_bool_performance_monitor_disable_gpu_counters]    = config.ReadBool("Performance", "PerformanceMonitorDisableGPUCounters", false);
+    m_ConfigBool[configid_bool_performance_ipc_stats_enabled]               = config.ReadBool("Performance", "IPCStatsEnabled", false);
+
+    IPCStats::Get().SetEnabled(m_ConfigBool[configid_bool_performance_ipc_stats_enabled]);
 
     m_ConfigBool[configid_bool_misc_no_steam]             = config.ReadBool("Misc", "NoSteam", false);
     m_ConfigBool[configid_bool_misc_uiaccess_was_enabled] = config.ReadBool("Misc", "UIAccessWasEnabled", false);
@@ -722,20 +752,20 @@ void ConfigManager::LoadMultiOverlayProfile(const Ini& config, bool clear_existi
     const int config_version = config.ReadInt("Misc", "ConfigVersion", 1);
 
     unsigned int overlay_id = 0;
+    std::vector<std::string> sections;
+    std::vector<unsigned int> section_overlay_ids;
 
     std::stringstream ss;
     ss << "Overlay" << overlay_id;
 
-    //Load all sequential overlay sections that exist
+    //Collect all sequential overlay sections that exist
     while (config.SectionExists(ss.str().c_str()))
     {
         //Don't add if not in list (or none was passed)
         if ( (ovrl_inclusion_list == nullptr) || (ovrl_inclusion_list->size() <= overlay_id) || ((*ovrl_inclusion_list)[overlay_id] != 0) )
         {
-            OverlayManager::Get().DuplicateOverlay(OverlayConfigData());
-            OverlayManager::Get().SetCurrentOverlayID(OverlayManager::Get().GetOverlayCount() - 1);
-
-            LoadOverlayProfile(config, overlay_id);
+            sections.push_back(ss.str());
+            section_overlay_ids.push_back(overlay_id);
         }
 
         overlay_id++;
@@ -744,10 +774,50 @@ void ConfigManager::LoadMultiOverlayProfile(const Ini& config, bool clear_existi
         ss << "Overlay" << overlay_id;
     }
 
+    //Decode the sections in parallel. This only reads from the Ini and writes to the decoded data of each section, so it's safe off the main thread
+    std::vector<OverlayConfigData> decoded_data(sections.size());
+
+    ConfigManagerParallelFor(sections.size(), [&](size_t i)
+                             {
+                                 OverlayConfigSchema::LoadSection(decoded_data[i], config, sections[i].c_str());
+                             });
+
+    #ifndef DPLUS_UI
+        //New overlay handles are sent to the UI as a single delta afterwards instead of separate messages for each overlay
+        const unsigned int first_new_overlay_id = OverlayManager::Get().GetOverlayCount();
+        OverlayManager::Get().SetHandleSyncDeferred(true);
+    #endif
+
+    //Create the overlays and finish loading in order, as that touches overlay and window state
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        OverlayManager::Get().DuplicateOverlay(OverlayConfigData());
+        OverlayManager::Get().SetCurrentOverlayID(OverlayManager::Get().GetOverlayCount() - 1);
+
+        OverlayConfigSchema::CopyValues(decoded_data[i], OverlayManager::Get().GetCurrentConfigData());
+        FinishOverlayProfileLoad(section_overlay_ids[i]);
+    }
+
+    #ifndef DPLUS_UI
+        OverlayManager::Get().SetHandleSyncDeferred(false);
+
+        //The UI has default state values for the overlays it creates when loading the profile on its end
+        const ConfigDeltaFilter filter_handle = {{}, {}, {}, {configid_handle_overlay_state_overlay_handle}, {}};
+        const OverlayConfigData data_default;
+        ConfigDelta delta;
+
+        for (unsigned int i = first_new_overlay_id; i < OverlayManager::Get().GetOverlayCount(); ++i)
+        {
+            delta.AddOverlayDiff(i, data_default, OverlayManager::Get().GetConfigData(i), &filter_handle);
+        }
+
+        IPCManager::Get().SendConfigDeltaToUIApp(delta, (OutputManager::Get() != nullptr) ? OutputManager::Get()->GetWindowHandle() : nullptr);
+    #endif
+
     OverlayManager::Get().SetCurrentOverlayID( std::min(current_overlay_old, (OverlayManager::Get().GetOverlayCount() == 0) ? k_ulOverlayID_None : OverlayManager::Get().GetOverlayCount() - 1) );
 }
 
-void ConfigManager::SaveMultiOverlayProfile(Ini& config, std::vector<char>* ovrl_inclusion_list)
+void ConfigManager::SaveMultiOverlayProfile(Ini& config, const std::vector<OverlayConfigData>& overlay_data)
 {
     //Remove single overlay section in case it still exists
     config.RemoveSection("Overlay");
@@ -769,23 +839,52 @@ void ConfigManager::SaveMultiOverlayProfile(Ini& config, std::vector<char>* ovrl
 
     config.WriteInt("Misc", "ConfigVersion", k_nDesktopPlusConfigVersion);
 
-    unsigned int current_overlay_old = OverlayManager::Get().GetCurrentOverlayID();
+    //Save all overlays in separate sections
     overlay_id = 0;
+    for (const OverlayConfigData& data : overlay_data)
+    {
+        SaveOverlayProfile(config, data, overlay_id);
+        overlay_id++;
+    }
+}
+
+void ConfigManager::SaveMultiOverlayProfile(Ini& config, std::vector<char>* ovrl_inclusion_list)
+{
+    SaveMultiOverlayProfile(config, GetOverlayDataForSave(ovrl_inclusion_list));
+}
+
+std::vector<OverlayConfigData> ConfigManager::GetOverlayDataForSave(std::vector<char>* ovrl_inclusion_list) const
+{
+    std::vector<OverlayConfigData> overlay_data;
 
-    //Save all overlays in separate sections
     for (unsigned int i = 0; i < OverlayManager::Get().GetOverlayCount(); ++i)
     {
         //Don't save if not in list (or none was passed)
         if ( (ovrl_inclusion_list == nullptr) || (ovrl_inclusion_list->size() <= i) || ((*ovrl_inclusion_list)[i] != 0) )
         {
-            OverlayManager::Get().SetCurrentOverlayID(i);
+            overlay_data.push_back(OverlayManager::Get().GetConfigData(i));
+            OverlayConfigData& data = overlay_data.back();
 
-            SaveOverlayProfile(config, overlay_id);
-            overlay_id++;
+            //WinRT Capture state. The last known title and exe name are kept even when handle is nullptr or getting title failed
+            //so we can still restore the window on the next load if it happens to exist. Replace them with the current window's if possible
+            HWND window_handle = (HWND)data.ConfigHandle[configid_handle_overlay_state_winrt_hwnd];
+
+            if (window_handle != nullptr)
+            {
+                WindowInfo info(window_handle);
+                std::string last_window_title = StringConvertFromUTF16(info.GetTitle().c_str());
+
+                if (!last_window_title.empty())
+                {
+                    data.ConfigStr[configid_str_overlay_winrt_last_window_title]      = last_window_title;
+                    data.ConfigStr[configid_str_overlay_winrt_last_window_class_name] = StringConvertFromUTF16(info.GetWindowClassName().c_str());
+                    data.ConfigStr[configid_str_overlay_winrt_last_window_exe_name]   = info.GetExeName();
+                }
+            }
         }
     }
 
-    OverlayManager::Get().SetCurrentOverlayID(current_overlay_old);
+    return overlay_data;
 }
 
 #ifdef DPLUS_UI
@@ -1310,7 +1409,7 @@ ConfigManager::LegacyActionIDtoActionUID ConfigManager::MigrateLegacyActionsFrom
     return legacy_id_to_uid;
 }
 
-OverlayOrigin ConfigManager::GetOverlayOriginFromConfigString(const std::string& str)
+OverlayOrigin ConfigManager::GetOverlayOriginFromConfigString(std::string_view str)
 {
     const auto it = std::find_if(std::begin(g_OvrlOriginConfigFileStrings), std::end(g_OvrlOriginConfigFileStrings), [&](const auto& pair){ return (pair.second == str); });
 
@@ -1319,7 +1418,7 @@ OverlayOrigin ConfigManager::GetOverlayOriginFromConfigString(const std::string&
         return it->first;
     }
 
-    LOG_F(WARNING, "Overlay has origin with unknown config string \"%s\"", str.c_str());
+    LOG_F(WARNING, "Overlay has origin with unknown config string \"%.*s\"", (int)str.size(), str.data());
 
     return ovrl_origin_room;    //Fallback to Room instead of throwing invalid values around
 }
@@ -1383,57 +1482,108 @@ void ConfigManager::RemoveScaleFromTransform(Matrix4& transform, float* width)
 
 #ifdef DPLUS_UI
 
-void ConfigManager::SaveConfigToFile()
+void ConfigManager::SaveConfigToFile(bool defer_write)
 {
+    if (m_IsSavingDisabled)
+        return;
+
     const std::wstring wpath = WStringConvertFromUTF8( std::string(m_ApplicationPath + "config.ini").c_str() );
-    Ini config(wpath.c_str());
+
+    //Only copy the state here and leave building and writing the file to the writer thread. Saving again before it got to it replaces the queued state
+    std::shared_ptr<ConfigSaveState> state = std::make_shared<ConfigSaveState>();
+
+    PublishSnapshot();
+    state->Config                = GetSnapshot();
+    state->HasOverlayData        = !m_AppProfileManager.IsActiveProfileWithOverlayProfile();
+    state->ActionOrderUI         = m_ActionManager.GetActionOrderListUI();
+    state->ActionOrderBarDefault = m_ActionManager.GetActionOrderListBarDefault();
+    state->ActionOrderOverlayBar = m_ActionManager.GetActionOrderListOverlayBar();
+    state->GlobalShortcuts       = m_ConfigGlobalShortcuts;
+    state->Hotkeys               = m_ConfigHotkey;
+    state->WindowState           = std::make_unique<Ini>(L"", true);
+
+    if (state->HasOverlayData)
+    {
+        state->OverlayData = GetOverlayDataForSave();
+    }
+
+    SaveConfigPersistentWindowState(*state->WindowState);
+
+    m_ConfigFileWriter.QueueBuild(wpath, [state](Ini& config){ SaveConfigToIni(config, *state); });
+    m_ActionManager.SaveActionsToFile();
+    m_AppProfileManager.SaveProfilesToFile();
+
+    //If there's a potential leftover unused config_newui.ini, save right away and remove it if that succeeded
+    std::wstring wpath_newui = WStringConvertFromUTF8( std::string(m_ApplicationPath + "config_newui.ini").c_str() );
+    if (FileExists(wpath_newui.c_str()))
+    {
+        if (m_ConfigFileWriter.Flush())
+        {
+            ::DeleteFileW(wpath_newui.c_str());
+            Ini::DeleteSnapshot(wpath_newui);
+        }
+    }
+    else if (!defer_write)
+    {
+        m_ConfigFileWriter.Flush();
+    }
+}
+
+void ConfigManager::SaveConfigToIni(Ini& config, const ConfigSaveState& state)
+{
+    const ConfigSnapshot& snapshot = *state.Config;
 
     //Only save overlay config if no app profile that has loaded an overlay profile is active
-    if (!m_AppProfileManager.IsActiveProfileWithOverlayProfile())
+    if (state.HasOverlayData)
     {
-        SaveMultiOverlayProfile(config);
+        SaveMultiOverlayProfile(config, state.OverlayData);
     }
 
-    config.WriteString("Interface", "LanguageFile",             m_ConfigString[configid_str_interface_language_file].c_str());
-    config.WriteInt(   "Interface", "OverlayCurrentID",         m_ConfigInt[configid_int_interface_overlay_current_id]);
-    config.WriteInt(   "Interface", "DesktopButtonCyclingMode", m_ConfigInt[configid_int_interface_desktop_listing_style]);
-    config.WriteBool(  "Interface", "ShowAdvancedSettings",     m_ConfigBool[configid_bool_interface_show_advanced_settings]);
-    config.WriteBool(  "Interface", "DisplaySizeLarge",         m_ConfigBool[configid_bool_interface_large_style]);
-    config.WriteBool(  "Interface", "DesktopButtonIncludeAll",  m_ConfigBool[configid_bool_interface_desktop_buttons_include_combined]);
+    config.WriteString("Interface", "LanguageFile",             snapshot.GetValue(configid_str_interface_language_file).c_str());
+    config.WriteInt(   "Interface", "OverlayCurrentID",         snapshot.ConfigInt[configid_int_interface_overlay_current_id]);
+    config.WriteInt(   "Interface", "DesktopButtonCyclingMode", snapshot.ConfigInt[configid_int_interface_desktop_listing_style]);
+    config.WriteBool(  "Interface", "ShowAdvancedSettings",     snapshot.ConfigBool[configid_bool_interface_show_advanced_settings]);
+    config.WriteBool(  "Interface", "DisplaySizeLarge",         snapshot.ConfigBool[configid_bool_interface_large_style]);
+    config.WriteBool(  "Interface", "DesktopButtonIncludeAll",  snapshot.ConfigBool[configid_bool_interface_desktop_buttons_include_combined]);
 
     //Write color string
     std::stringstream ss;
-    ss << std::setw(8) << std::setfill('0') << std::hex << pun_cast<unsigned int, int>(m_ConfigInt[configid_int_interface_background_color]);
+    ss << std::setw(8) << std::setfill('0') << std::hex << pun_cast<unsigned int, int>(snapshot.ConfigInt[configid_int_interface_background_color]);
     config.WriteString("Interface", "EnvironmentBackgroundColor", ss.str().c_str());
 
-    config.WriteInt( "Interface", "EnvironmentBackgroundColorDisplayMode", m_ConfigInt[configid_int_interface_background_color_display_mode]);
-    config.WriteBool("Interface", "DimUI",                                 m_ConfigBool[configid_bool_interface_dim_ui]);
-    config.WriteBool("Interface", "BlankSpaceDragEnabled",                 m_ConfigBool[configid_bool_interface_blank_space_drag_enabled]);
-    config.WriteInt( "Interface", "LastVRUIScale",                     int(m_ConfigFloat[configid_float_interface_last_vr_ui_scale] * 100.0f));
-    config.WriteBool("Interface", "WarningCompositorResolutionHidden",     m_ConfigBool[configid_bool_interface_warning_compositor_res_hidden]);
-    config.WriteBool("Interface", "WarningCompositorQualityHidden",        m_ConfigBool[configid_bool_interface_warning_compositor_quality_hidden]);
-    config.WriteBool("Interface", "WarningProcessElevationHidden",         m_ConfigBool[configid_bool_interface_warning_process_elevation_hidden]);
-    config.WriteBool("Interface", "WarningElevatedModeHidden",             m_ConfigBool[configid_bool_interface_warning_elevated_mode_hidden]);
-    config.WriteBool("Interface", "WarningBrowserMissingHidden",           m_ConfigBool[configid_bool_interface_warning_browser_missing_hidden]);
-    config.WriteBool("Interface", "WarningBrowserVersionMismatchHidden",   m_ConfigBool[configid_bool_interface_warning_browser_version_mismatch_hidden]);
-    config.WriteBool("Interface", "WarningAppProfileActiveHidden",         m_ConfigBool[configid_bool_interface_warning_app_profile_active_hidden]);
-    config.WriteBool("Interface", "WindowSettingsRestoreState",            m_ConfigBool[configid_bool_interface_window_settings_restore_state]);
-    config.WriteBool("Interface", "WindowPropertiesRestoreState",          m_ConfigBool[configid_bool_interface_window_properties_restore_state]);
-    config.WriteBool("Interface", "WindowKeyboardRestoreState",            m_ConfigBool[configid_bool_interface_window_keyboard_restore_state]);
-    config.WriteBool("Interface", "QuickStartGuideHidden",                 m_ConfigBool[configid_bool_interface_quick_start_hidden]);
+    config.WriteInt( "Interface", "EnvironmentBackgroundColorDisplayMode", snapshot.ConfigInt[configid_int_interface_background_color_display_mode]);
+    config.WriteBool("Interface", "DimUI",                                 snapshot.ConfigBool[configid_bool_interface_dim_ui]);
+    config.WriteBool("Interface", "BlankSpaceDragEnabled",                 snapshot.ConfigBool[configid_bool_interface_blank_space_drag_enabled]);
+    config.WriteInt( "Interface", "LastVRUIScale",                     int(snapshot.ConfigFloat[configid_float_interface_last_vr_ui_scale] * 100.0f));
+    config.WriteBool("Interface", "WarningCompositorResolutionHidden",     snapshot.ConfigBool[configid_bool_interface_warning_compositor_res_hidden]);
+    config.WriteBool("Interface", "WarningCompositorQualityHidden",        snapshot.ConfigBool[configid_bool_interface_warning_compositor_quality_hidden]);
+    config.WriteBool("Interface", "WarningProcessElevationHidden",         snapshot.ConfigBool[configid_bool_interface_warning_process_elevation_hidden]);
+    config.WriteBool("Interface", "WarningElevatedModeHidden",             snapshot.ConfigBool[configid_bool_interface_warning_elevated_mode_hidden]);
+    config.WriteBool("Interface", "WarningBrowserMissingHidden",           snapshot.ConfigBool[configid_bool_interface_warning_browser_missing_hidden]);
+    config.WriteBool("Interface", "WarningBrowserVersionMismatchHidden",   snapshot.ConfigBool[configid_bool_interface_warning_browser_version_mismatch_hidden]);
+    config.WriteBool("Interface", "WarningAppProfileActiveHidden",         snapshot.ConfigBool[configid_bool_interface_warning_app_profile_active_hidden]);
+    config.WriteBool("Interface", "WindowSettingsRestoreState",            snapshot.ConfigBool[configid_bool_interface_window_settings_restore_state]);
+    config.WriteBool("Interface", "WindowPropertiesRestoreState",          snapshot.ConfigBool[configid_bool_interface_window_properties_restore_state]);
+    config.WriteBool("Interface", "WindowKeyboardRestoreState",            snapshot.ConfigBool[configid_bool_interface_window_keyboard_restore_state]);
+    config.WriteBool("Interface", "QuickStartGuideHidden",                 snapshot.ConfigBool[configid_bool_interface_quick_start_hidden]);
 
     //Only write WMR settings when they're not -1 since they get set to that when using a non-WMR system. We want to preserve them for HMD-switching users
-    if (m_ConfigInt[configid_int_interface_wmr_ignore_vscreens] != -1)
-        config.WriteInt("Interface", "WMRIgnoreVScreens", m_ConfigInt[configid_int_interface_wmr_ignore_vscreens]);
+    if (snapshot.ConfigInt[configid_int_interface_wmr_ignore_vscreens] != -1)
+        config.WriteInt("Interface", "WMRIgnoreVScreens", snapshot.ConfigInt[configid_int_interface_wmr_ignore_vscreens]);
 
-    SaveConfigPersistentWindowState(config);
+    //Copy persistent window state values
+    IniSectionCursor window_state_cursor = state.WindowState->GetSectionCursor("Interface");
+    while (window_state_cursor.Next())
+    {
+        config.WriteString("Interface", std::string(window_state_cursor.GetKey()).c_str(), std::string(window_state_cursor.GetValue()).c_str());
+    }
 
-    config.WriteString("Interface", "ActionOrder",           m_ActionManager.ActionOrderListToString(m_ActionManager.GetActionOrderListUI()).c_str() );
-    config.WriteString("Interface", "ActionOrderBarDefault", m_ActionManager.ActionOrderListToString(m_ActionManager.GetActionOrderListBarDefault()).c_str() );
-    config.WriteString("Interface", "ActionOrderOverlayBar", m_ActionManager.ActionOrderListToString(m_ActionManager.GetActionOrderListOverlayBar()).c_str() );
+    config.WriteString("Interface", "ActionOrder",           ActionManager::ActionOrderListToString(state.ActionOrderUI).c_str() );
+    config.WriteString("Interface", "ActionOrderBarDefault", ActionManager::ActionOrderListToString(state.ActionOrderBarDefault).c_str() );
+    config.WriteString("Interface", "ActionOrderOverlayBar", ActionManager::ActionOrderListToString(state.ActionOrderOverlayBar).c_str() );
 
-    config.WriteString("Input", "GoHomeButtonActionUID", std::to_string(m_ConfigHandle[configid_handle_input_go_home_action_uid]).c_str());
-    config.WriteString("Input", "GoBackButtonActionUID", std::to_string(m_ConfigHandle[configid_handle_input_go_back_action_uid]).c_str());
+    config.WriteString("Input", "GoHomeButtonActionUID", std::to_string(snapshot.ConfigHandle[configid_handle_input_go_home_action_uid]).c_str());
+    config.WriteString("Input", "GoBackButtonActionUID", std::to_string(snapshot.ConfigHandle[configid_handle_input_go_back_action_uid]).c_str());
 
     //Global Shorcuts
     int shortcut_id = 0;
@@ -1456,7 +1606,7 @@ void ConfigManager::SaveConfigToFile()
     }
 
     shortcut_id = 0;
-    for (const ActionUID uid: m_ConfigGlobalShortcuts)
+    for (const ActionUID uid: state.GlobalShortcuts)
     {
         ss = std::stringstream();
         ss << "GlobalShortcut" << std::setfill('0') << std::setw(2) << shortcut_id + 1 << "ActionUID";
@@ -1489,7 +1639,7 @@ void ConfigManager::SaveConfigToFile()
     }
 
     hotkey_id = 0;
-    for (const ConfigHotkey& hotkey : m_ConfigHotkey)
+    for (const ConfigHotkey& hotkey : state.Hotkeys)
     {
         ss = std::stringstream();
         ss << "GlobalHotkey" << std::setfill('0') << std::setw(2) << hotkey_id + 1;
@@ -1501,103 +1651,100 @@ void ConfigManager::SaveConfigToFile()
         ++hotkey_id;
     }
 
-    config.WriteInt( "Input", "DetachedInteractionMaxDistance", int(m_ConfigFloat[configid_float_input_detached_interaction_max_distance] * 100.0f));
-    config.WriteBool("Input", "LaserPointerBlockInput",             m_ConfigBool[configid_bool_input_laser_pointer_block_input]);
-    config.WriteBool("Input", "GlobalHMDPointer",                   m_ConfigBool[configid_bool_input_laser_pointer_hmd_device]);
-    config.WriteInt( "Input", "LaserPointerHMDKeyCodeToggle",       m_ConfigInt[configid_int_input_laser_pointer_hmd_device_keycode_toggle]);
-    config.WriteInt( "Input", "LaserPointerHMDKeyCodeLeft",         m_ConfigInt[configid_int_input_laser_pointer_hmd_device_keycode_left]);
-    config.WriteInt( "Input", "LaserPointerHMDKeyCodeRight",        m_ConfigInt[configid_int_input_laser_pointer_hmd_device_keycode_right]);
-    config.WriteInt( "Input", "LaserPointerHMDKeyCodeMiddle",       m_ConfigInt[configid_int_input_laser_pointer_hmd_device_keycode_middle]);
-    config.WriteInt( "Input", "LaserPointerHMDKeyCodeDrag",         m_ConfigInt[configid_int_input_laser_pointer_hmd_device_keycode_drag]);
-
-    config.WriteBool("Input", "DragAutoDocking",                    m_ConfigBool[configid_bool_input_drag_auto_docking]);
-    config.WriteBool("Input", "DragForceUpright",                   m_ConfigBool[configid_bool_input_drag_force_upright]);
-    config.WriteBool("Input", "DragFixedDistance",                  m_ConfigBool[configid_bool_input_drag_fixed_distance]);
-    config.WriteInt( "Input", "DragFixedDistanceCM",            int(m_ConfigFloat[configid_float_input_drag_fixed_distance_m] * 100.0f));
-    config.WriteInt( "Input", "DragFixedDistanceShape",             m_ConfigInt[configid_int_input_drag_fixed_distance_shape]);
-    config.WriteBool("Input", "DragFixedDistanceAutoCurve",         m_ConfigBool[configid_bool_input_drag_fixed_distance_auto_curve]);
-    config.WriteBool("Input", "DragFixedDistanceAutoTilt",          m_ConfigBool[configid_bool_input_drag_fixed_distance_auto_tilt]);
-    config.WriteBool("Input", "DragSnapPosition",                   m_ConfigBool[configid_bool_input_drag_snap_position]);
-    config.WriteInt( "Input", "DragSnapPositionSize",           int(m_ConfigFloat[configid_float_input_drag_snap_position_size] * 100.0f));
-
-    config.WriteBool("Mouse", "RenderCursor",              m_ConfigBool[configid_bool_input_mouse_render_cursor]);
-    config.WriteBool("Mouse", "RenderIntersectionBlob",    m_ConfigBool[configid_bool_input_mouse_render_intersection_blob]);
-    config.WriteBool("Mouse", "ScrollSmooth",              m_ConfigBool[configid_bool_input_mouse_scroll_smooth]);
-    config.WriteBool("Mouse", "AllowPointerOverride",      m_ConfigBool[configid_bool_input_mouse_allow_pointer_override]);
-    config.WriteBool("Mouse", "SimulatePenInput",          m_ConfigBool[configid_bool_input_mouse_simulate_pen_input]);
-    config.WriteInt( "Mouse", "DoubleClickAssistDuration", m_ConfigInt[configid_int_input_mouse_dbl_click_assist_duration_ms]);
-    config.WriteInt( "Mouse", "InputSmoothingLevel",       m_ConfigInt[configid_int_input_mouse_input_smoothing_level]);
-
-    config.WriteString("Keyboard", "LayoutFile",                m_ConfigString[configid_str_input_keyboard_layout_file].c_str());
-    config.WriteBool("Keyboard", "LayoutClusterFunction",       m_ConfigBool[configid_bool_input_keyboard_cluster_function_enabled]);
-    config.WriteBool("Keyboard", "LayoutClusterNavigation",     m_ConfigBool[configid_bool_input_keyboard_cluster_navigation_enabled]);
-    config.WriteBool("Keyboard", "LayoutClusterNumpad",         m_ConfigBool[configid_bool_input_keyboard_cluster_numpad_enabled]);
-    config.WriteBool("Keyboard", "LayoutClusterExtra",          m_ConfigBool[configid_bool_input_keyboard_cluster_extra_enabled]);
-    config.WriteBool("Keyboard", "StickyModifiers",             m_ConfigBool[configid_bool_input_keyboard_sticky_modifiers]);
-    config.WriteBool("Keyboard", "KeyRepeat",                   m_ConfigBool[configid_bool_input_keyboard_key_repeat]);
-    config.WriteBool("Keyboard", "AutoShowDesktop",             m_ConfigBool[configid_bool_input_keyboard_auto_show_desktop]);
-    config.WriteBool("Keyboard", "AutoShowBrowser",             m_ConfigBool[configid_bool_input_keyboard_auto_show_browser]);
-
-    config.WriteBool("Windows", "AutoFocusSceneAppDashboard",   m_ConfigBool[configid_bool_windows_auto_focus_scene_app_dashboard]);
-    config.WriteBool("Windows", "WinRTAutoFocus",               m_ConfigBool[configid_bool_windows_winrt_auto_focus]);
-    config.WriteBool("Windows", "WinRTKeepOnScreen",            m_ConfigBool[configid_bool_windows_winrt_keep_on_screen]);
-    config.WriteInt( "Windows", "WinRTDraggingMode",            m_ConfigInt[configid_int_windows_winrt_dragging_mode]);
-    config.WriteBool("Windows", "WinRTAutoSizeOverlay",         m_ConfigBool[configid_bool_windows_winrt_auto_size_overlay]);
-    config.WriteBool("Windows", "WinRTAutoFocusSceneApp",       m_ConfigBool[configid_bool_windows_winrt_auto_focus_scene_app]);
-    config.WriteInt( "Windows", "WinRTOnCaptureLost",           m_ConfigInt[configid_int_windows_winrt_capture_lost_behavior]);
-
-    config.WriteInt( "Browser", "BrowserMaxFPS",                m_ConfigInt[configid_int_browser_max_fps]);
-    config.WriteBool("Browser", "BrowserContentBlocker",        m_ConfigBool[configid_bool_browser_content_blocker]);
-
-    config.WriteInt( "Performance", "UpdateLimitMode",                      m_ConfigInt[configid_int_performance_update_limit_mode]);
-    config.WriteInt( "Performance", "UpdateLimitMS",                    int(m_ConfigFloat[configid_float_performance_update_limit_ms] * 100.0f));
-    config.WriteInt( "Performance", "UpdateLimitFPS",                       m_ConfigInt[configid_int_performance_update_limit_fps]);
-    config.WriteBool("Performance", "RapidLaserPointerUpdates",             m_ConfigBool[configid_bool_performance_rapid_laser_pointer_updates]);
-    config.WriteBool("Performance", "SingleDesktopMirroring",               m_ConfigBool[configid_bool_performance_single_desktop_mirroring]);
-    config.WriteBool("Performance", "HDRMirroring",                         m_ConfigBool[configid_bool_performance_hdr_mirroring]);
-    config.WriteBool("Performance", "ShowFPS",                              m_ConfigBool[configid_bool_performance_show_fps]);
-    config.WriteBool("Performance", "UIAutoThrottle",                       m_ConfigBool[configid_bool_performance_ui_auto_throttle]);
-    config.WriteBool("Performance", "PerformanceMonitorStyleLarge",         m_ConfigBool[configid_bool_performance_monitor_large_style]);
-    config.WriteBool("Performance", "PerformanceMonitorShowGraphs",         m_ConfigBool[configid_bool_performance_monitor_show_graphs]);
-    config.WriteBool("Performance", "PerformanceMonitorShowTime",           m_ConfigBool[configid_bool_performance_monitor_show_time]);
-    config.WriteBool("Performance", "PerformanceMonitorShowCPU",            m_ConfigBool[configid_bool_performance_monitor_show_cpu]);
-    config.WriteBool("Performance", "PerformanceMonitorShowGPU",            m_ConfigBool[configid_bool_performance_monitor_show_gpu]);
-    config.WriteBool("Performance", "PerformanceMonitorShowFPS",            m_ConfigBool[configid_bool_performance_monitor_show_fps]);
-    config.WriteBool("Performance", "PerformanceMonitorShowBattery",        m_ConfigBool[configid_bool_performance_monitor_show_battery]);
-    config.WriteBool("Performance", "PerformanceMonitorShowTrackers",       m_ConfigBool[configid_bool_performance_monitor_show_trackers]);
-    config.WriteBool("Performance", "PerformanceMonitorShowViveWireless",   m_ConfigBool[configid_bool_performance_monitor_show_vive_wireless]);
-    config.WriteBool("Performance", "PerformanceMonitorDisableGPUCounters", m_ConfigBool[configid_bool_performance_monitor_disable_gpu_counters]);
+    config.WriteInt( "Input", "DetachedInteractionMaxDistance", int(snapshot.ConfigFloat[configid_float_input_detached_interaction_max_distance] * 100.0f));
+    config.WriteBool("Input", "LaserPointerBlockInput",             snapshot.ConfigBool[configid_bool_input_laser_pointer_block_input]);
+    config.WriteBool("Input", "GlobalHMDPointer",                   snapshot.ConfigBool[configid_bool_input_laser_pointer_hmd_device]);
+    config.WriteInt( "Input", "LaserPointerHMDKeyCodeToggle",       snapshot.ConfigInt[configid_int_input_laser_pointer_hmd_device_keycode_toggle]);
+    config.WriteInt( "Input", "LaserPointerHMDKeyCodeLeft",         snapshot.ConfigInt[configid_int_input_laser_pointer_hmd_device_keycode_left]);
+    config.WriteInt( "Input", "LaserPointerHMDKeyCodeRight",        snapshot.ConfigInt[configid_int_input_laser_pointer_hmd_device_keycode_right]);
+    config.WriteInt( "Input", "LaserPointerHMDKeyCodeMiddle",       snapshot.ConfigInt[configid_int_input_laser_pointer_hmd_device_keycode_middle]);
+    config.WriteInt( "Input", "LaserPointerHMDKeyCodeDrag",         snapshot.ConfigInt[configid_int_input_laser_pointer_hmd_device_keycode_drag]);
+
+    config.WriteBool("Input", "DragAutoDocking",                    snapshot.ConfigBool[configid_bool_input_drag_auto_docking]);
+    config.WriteBool("Input", "DragForceUpright",                   snapshot.ConfigBool[configid_bool_input_drag_force_upright]);
+    config.WriteBool("Input", "DragFixedDistance",                  snapshot.ConfigBool[configid_bool_input_drag_fixed_distance]);
+    config.WriteInt( "Input", "DragFixedDistanceCM",            int(snapshot.ConfigFloat[configid_float_input_drag_fixed_distance_m] * 100.0f));
+    config.WriteInt( "Input", "DragFixedDistanceShape",             snapshot.ConfigInt[configid_int_input_drag_fixed_distance_shape]);
+    config.WriteBool("Input", "DragFixedDistanceAutoCurve",         snapshot.ConfigBool[configid_bool_input_drag_fixed_distance_auto_curve]);
+    config.WriteBool("Input", "DragFixedDistanceAutoTilt",          snapshot.ConfigBool[configid_bool_input_drag_fixed_distance_auto_tilt]);
+    config.WriteBool("Input", "DragSnapPosition",                   snapshot.ConfigBool[configid_bool_input_drag_snap_position]);
+    config.WriteInt( "Input", "DragSnapPositionSize",           int(snapshot.ConfigFloat[configid_float_input_drag_snap_position_size] * 100.0f));
+
+    config.WriteBool("Mouse", "RenderCursor",              snapshot.ConfigBool[configid_bool_input_mouse_render_cursor]);
+    config.WriteBool("Mouse", "RenderIntersectionBlob",    snapshot.ConfigBool[configid_bool_input_mouse_render_intersection_blob]);
+    config.WriteBool("Mouse", "ScrollSmooth",              snapshot.ConfigBool[configid_bool_input_mouse_scroll_smooth]);
+    config.WriteBool("Mouse", "AllowPointerOverride",      snapshot.ConfigBool[configid_bool_input_mouse_allow_pointer_override]);
+    config.WriteBool("Mouse", "SimulatePenInput",          snapshot.ConfigBool[configid_bool_input_mouse_simulate_pen_input]);
+    config.WriteInt( "Mouse", "DoubleClickAssistDuration", snapshot.ConfigInt[configid_int_input_mouse_dbl_click_assist_duration_ms]);
+    config.WriteInt( "Mouse", "InputSmoothingLevel",       snapshot.ConfigInt[configid_int_input_mouse_input_smoothing_level]);
+
+    config.WriteString("Keyboard", "LayoutFile",                snapshot.GetValue(configid_str_input_keyboard_layout_file).c_str());
+    config.WriteBool("Keyboard", "LayoutClusterFunction",       snapshot.ConfigBool[configid_bool_input_keyboard_cluster_function_enabled]);
+    config.WriteBool("Keyboard", "LayoutClusterNavigation",     snapshot.ConfigBool[configid_bool_input_keyboard_cluster_navigation_enabled]);
+    config.WriteBool("Keyboard", "LayoutClusterNumpad",         snapshot.ConfigBool[configid_bool_input_keyboard_cluster_numpad_enabled]);
+    config.WriteBool("Keyboard", "LayoutClusterExtra",          snapshot.ConfigBool[configid_bool_input_keyboard_cluster_extra_enabled]);
+    config.WriteBool("Keyboard", "StickyModifiers",             snapshot.ConfigBool[configid_bool_input_keyboard_sticky_modifiers]);
+    config.WriteBool("Keyboard", "KeyRepeat",                   snapshot.ConfigBool[configid_bool_input_keyboard_key_repeat]);
+    config.WriteBool("Keyboard", "AutoShowDesktop",             snapshot.ConfigBool[configid_bool_input_keyboard_auto_show_desktop]);
+    config.WriteBool("Keyboard", "AutoShowBrowser",             snapshot.ConfigBool[configid_bool_input_keyboard_auto_show_browser]);
+
+    config.WriteBool("Windows", "AutoFocusSceneAppDashboard",   snapshot.ConfigBool[configid_bool_windows_auto_focus_scene_app_dashboard]);
+    config.WriteBool("Windows", "WinRTAutoFocus",               snapshot.ConfigBool[configid_bool_windows_winrt_auto_focus]);
+    config.WriteBool("Windows", "WinRTKeepOnScreen",            snapshot.ConfigBool[configid_bool_windows_winrt_keep_on_screen]);
+    config.WriteInt( "Windows", "WinRTDraggingMode",            snapshot.ConfigInt[configid_int_windows_winrt_dragging_mode]);
+    config.WriteBool("Windows", "WinRTAutoSizeOverlay",         snapshot.ConfigBool[configid_bool_windows_winrt_auto_size_overlay]);
+    config.WriteBool("Windows", "WinRTAutoFocusSceneApp",       snapshot.ConfigBool[configid_bool_windows_winrt_auto_focus_scene_app]);
+    config.WriteInt( "Windows", "WinRTOnCaptureLost",           snapshot.ConfigInt[configid_int_windows_winrt_capture_lost_behavior]);
+
+    config.WriteInt( "Browser", "BrowserMaxFPS",                snapshot.ConfigInt[configid_int_browser_max_fps]);
+    config.WriteBool("Browser", "BrowserContentBlocker",        snapshot.ConfigBool[configid_bool_browser_content_blocker]);
+
+    config.WriteInt( "Performance", "UpdateLimitMode",                      snapshot.ConfigInt[configid_int_performance_update_limit_mode]);
+    config.WriteInt( "Performance", "UpdateLimitMS",                    int(snapshot.ConfigFloat[configid_float_performance_update_limit_ms] * 100.0f));
+    config.WriteInt( "Performance", "UpdateLimitFPS",                       snapshot.ConfigInt[configid_int_performance_update_limit_fps]);
+    config.WriteBool("Performance", "RapidLaserPointerUpdates",             snapshot.ConfigBool[configid_bool_performance_rapid_laser_pointer_updates]);
+    config.WriteBool("Performance", "SingleDesktopMirroring",               snapshot.ConfigBool[configid_bool_performance_single_desktop_mirroring]);
+    config.WriteBool("Performance", "HDRMirroring",                         snapshot.ConfigBool[configid_bool_performance_hdr_mirroring]);
+    config.WriteBool("Performance", "ShowFPS",                              snapshot.ConfigBool[configid_bool_performance_show_fps]);
+    config.WriteBool("Performance", "UIAutoThrottle",                       snapshot.ConfigBool[configid_bool_performance_ui_auto_throttle]);
+    config.WriteBool("Performance", "PerformanceMonitorStyleLarge",         snapshot.ConfigBool[configid_bool_performance_monitor_large_style]);
+    config.WriteBool("Performance", "PerformanceMonitorShowGraphs",         snapshot.ConfigBool[configid_bool_performance_monitor_show_graphs]);
+    config.WriteBool("Performance", "PerformanceMonitorShowTime",           snapshot.ConfigBool[configid_bool_performance_monitor_show_time]);
+    config.WriteBool("Performance", "PerformanceMonitorShowCPU",            snapshot.ConfigBool[configid_bool_performance_monitor_show_cpu]);
+    config.WriteBool("Performance", "PerformanceMonitorShowGPU",            snapshot.ConfigBool[configid_bool_performance_monitor_show_gpu]);
+    config.WriteBool("Performance", "PerformanceMonitorShowFPS",            snapshot.ConfigBool[configid_bool_performance_monitor_show_fps]);
+    config.WriteBool("Performance", "PerformanceMonitorShowBattery",        snapshot.ConfigBool[configid_bool_performance_monitor_show_battery]);
+    config.WriteBool("Performance", "PerformanceMonitorShowTrackers",       snapshot.ConfigBool[configid_bool_performance_monitor_show_trackers]);
+    config.WriteBool("Performance", "PerformanceMonitorShowViveWireless",   snapshot.ConfigBool[configid_bool_performance_monitor_show_vive_wireless]);
+    config.WriteBool("Performance", "PerformanceMonitorDisableGPUCounters", snapshot.ConfigBool[configid_bool_performance_monitor_disable_gpu_counters]);
+    config.WriteBool("Performance", "IPCStatsEnabled",                      snapshot.ConfigBool[configid_bool_performance_ipc_stats_enabled]);
 
     config.WriteInt( "Misc", "ConfigVersion",      k_nDesktopPlusConfigVersion);
-    config.WriteBool("Misc", "NoSteam",            m_ConfigBool[configid_bool_misc_no_steam]);
-    config.WriteBool("Misc", "UIAccessWasEnabled", (m_ConfigBool[configid_bool_misc_uiaccess_was_enabled] || m_ConfigBool[configid_bool_state_misc_uiaccess_enabled]));
+    config.WriteBool("Misc", "NoSteam",            snapshot.ConfigBool[configid_bool_misc_no_steam]);
+    config.WriteBool("Misc", "UIAccessWasEnabled", (snapshot.ConfigBool[configid_bool_misc_uiaccess_was_enabled] || snapshot.ConfigBool[configid_bool_state_misc_uiaccess_enabled]));
 
     //Remove old CustomSection section (actions are now saved separately)
     config.RemoveSection("CustomActions");
-
-    //Save config & if it succeeded, remove potential leftover unused config_newui.ini
-    if (config.Save())
-    {
-        std::wstring wpath_newui = WStringConvertFromUTF8( std::string(m_ApplicationPath + "config_newui.ini").c_str() );
-        if (FileExists(wpath_newui.c_str()))
-        {
-            ::DeleteFileW(wpath_newui.c_str());
-        }
-    }
-
-    m_ActionManager.SaveActionsToFile();
-    m_AppProfileManager.SaveProfilesToFile();
 }
 
 #endif //ifdef DPLUS_UI
 
 void ConfigManager::RestoreConfigFromDefault()
 {
+    if (m_IsSavingDisabled)
+        return;
+
     //Basically delete the config files and then load it again which will fall back to config_default.ini
     const std::wstring wpath_newui = WStringConvertFromUTF8( std::string(m_ApplicationPath + "config_newui.ini").c_str() );
     const std::wstring wpath       = WStringConvertFromUTF8( std::string(m_ApplicationPath + "config.ini").c_str() );
+
+    //Finish queued writes first so they don't recreate the files afterwards
+    m_ConfigFileWriter.Flush();
+
     ::DeleteFileW(wpath_newui.c_str());
     ::DeleteFileW(wpath.c_str());
+    Ini::DeleteSnapshot(wpath_newui);
+    Ini::DeleteSnapshot(wpath);
 
     LoadConfigFromFile();
 }
@@ -1625,7 +1772,7 @@ bool ConfigManager::LoadMultiOverlayProfileFromFile(const std::string& filename,
 
     if (FileExists(wpath.c_str()))
     {
-        Ini config(wpath);
+        Ini config(wpath, false, true);
         LoadMultiOverlayProfile(config, clear_existing_overlays, ovrl_inclusion_list);
         return true;
     }
@@ -1635,21 +1782,38 @@ bool ConfigManager::LoadMultiOverlayProfileFromFile(const std::string& filename,
 
 bool ConfigManager::SaveMultiOverlayProfileToFile(const std::string& filename, std::vector<char>* ovrl_inclusion_list)
 {
+    if (m_IsSavingDisabled)
+        return false;
+
     LOG_F(INFO, "Saving overlay profile \"%s\"...", filename.c_str());
 
     std::string path = m_ApplicationPath + "profiles/" + filename;
-    Ini config(WStringConvertFromUTF8(path.c_str()), true);
+    Ini config(WStringConvertFromUTF8(path.c_str()), true, true);
 
     SaveMultiOverlayProfile(config, ovrl_inclusion_list);
-    return config.Save();
+    const bool ret = config.Save();
+
+    #ifdef DPLUS_UI
+        g_OverlayProfileCatalog.Invalidate();
+    #endif
+
+    return ret;
 }
 
 bool ConfigManager::DeleteOverlayProfile(const std::string& filename)
 {
+    if (m_IsSavingDisabled)
+        return false;
+
     LOG_F(INFO, "Deleting overlay profile \"%s\"...", filename.c_str());
 
-    std::string path = m_ApplicationPath + "profiles/" + filename;
-    bool ret = (::DeleteFileW(WStringConvertFromUTF8(path.c_str()).c_str()) != 0);
+    const std::wstring wpath = WStringConvertFromUTF8( std::string(m_ApplicationPath + "profiles/" + filename).c_str() );
+    bool ret = (::DeleteFileW(wpath.c_str()) != 0);
+    Ini::DeleteSnapshot(wpath);
+
+    #ifdef DPLUS_UI
+        g_OverlayProfileCatalog.Invalidate();
+    #endif
 
     LOG_IF_F(WARNING, !ret, "Failed to delete overlay profile!");
 
@@ -1658,6 +1822,9 @@ bool ConfigManager::DeleteOverlayProfile(const std::string& filename)
 
 void ConfigManager::DeleteAllOverlayProfiles()
 {
+    if (m_IsSavingDisabled)
+        return;
+
     LOG_F(INFO, "Deleting all overlay profiles...");
 
     const std::wstring wpath = WStringConvertFromUTF8(std::string(m_ApplicationPath + "profiles/*.ini").c_str());
@@ -1672,12 +1839,23 @@ void ConfigManager::DeleteAllOverlayProfiles()
             {
                 std::wstring wpath = WStringConvertFromUTF8(std::string(m_ApplicationPath + "profiles/").c_str()) + find_data.cFileName;
                 ::DeleteFileW(wpath.c_str());
+                Ini::DeleteSnapshot(wpath);
             }
         }
         while (::FindNextFileW(handle_find, &find_data) != 0);
 
         ::FindClose(handle_find);
     }
+
+    #ifdef DPLUS_UI
+        g_OverlayProfileCatalog.Invalidate();
+    #endif
+}
+
+void ConfigManager::SetSavingDisabled(bool is_disabled)
+{
+    m_IsSavingDisabled = is_disabled;
+    m_ConfigFileWriter.SetDisabled(is_disabled);    //Covers actions and app profiles, which queue their writes directly
 }
 
 #ifdef DPLUS_UI
@@ -1687,23 +1865,8 @@ std::vector<std::string> ConfigManager::GetOverlayProfileList()
     std::vector<std::string> list;
     list.emplace_back(TranslationManager::GetString(tstr_SettingsProfilesOverlaysNameDefault));
 
-    const std::wstring wpath = WStringConvertFromUTF8(std::string(m_ApplicationPath + "profiles/*.ini").c_str());
-    WIN32_FIND_DATA find_data;
-    HANDLE handle_find = ::FindFirstFileW(wpath.c_str(), &find_data);
-
-    if (handle_find != INVALID_HANDLE_VALUE)
-    {
-        do
-        {
-            std::string name = StringConvertFromUTF16(find_data.cFileName);
-            name = name.substr(0, name.length() - 4);   //Remove extension
-
-            list.push_back(name);
-        }
-        while (::FindNextFileW(handle_find, &find_data) != 0);
-
-        ::FindClose(handle_find);
-    }
+    const std::vector<std::string>& name_list = g_OverlayProfileCatalog.GetProfileNameList();
+    list.insert(list.end(), name_list.begin(), name_list.end());
 
     list.emplace_back(TranslationManager::GetString(tstr_SettingsProfilesOverlaysNameNew));
 
@@ -1712,34 +1875,15 @@ std::vector<std::string> ConfigManager::GetOverlayProfileList()
 
 std::vector< std::pair<std::string, OverlayOrigin> > ConfigManager::GetOverlayProfileOverlayNameList(const std::string& filename)
 {
-    std::vector< std::pair<std::string, OverlayOrigin> > list;
-
-    std::wstring wpath = WStringConvertFromUTF8( std::string(m_ApplicationPath + "profiles/" + filename).c_str() );
-
-    if (FileExists(wpath.c_str()))
-    {
-        Ini config(wpath);
-        unsigned int overlay_id = 0;
+    //Catalog is keyed by profile name
+    const std::string name = (filename.length() > 4) ? filename.substr(0, filename.length() - 4) : filename;   //Remove extension
 
-        std::stringstream ss;
-        ss << "Overlay" << overlay_id;
-
-        //Get names and origin from all sequential overlay sections that exist
-        while (config.SectionExists(ss.str().c_str()))
-        {
-            overlay_id++;
-
-            std::string name(config.ReadString(ss.str().c_str(), "Name"));
-            OverlayOrigin origin = GetOverlayOriginFromConfigString(config.ReadString(ss.str().c_str(), "Origin"));
-
-            list.push_back( std::make_pair(name.empty() ? ss.str() : name, origin) );   //Name should never be blank with compatible profiles, but offer alternative just in case
-
-            ss = std::stringstream();
-            ss << "Overlay" << overlay_id;
-        }
-    }
+    return g_OverlayProfileCatalog.GetOverlayList(name);
+}
 
-    return list;
+OverlayProfileCatalog& ConfigManager::GetOverlayProfileCatalog()
+{
+    return g_OverlayProfileCatalog;
 }
 
 void ConfigManager::RestoreActionOrdersFromDefault()
@@ -1781,7 +1925,10 @@ void ConfigManager::SetValue(ConfigID_Bool configid, bool value)
     if (configid < configid_bool_overlay_MAX)
         OverlayManager::Get().GetCurrentConfigData().ConfigBool[configid] = value;
     else if (configid < configid_bool_MAX)
+    {
         Get().m_ConfigBool[configid] = value;
+        Get().m_IsSnapshotDirty = true;
+    }
 }
 
 void ConfigManager::SetValue(ConfigID_Int configid, int value)
@@ -1789,7 +1936,10 @@ void ConfigManager::SetValue(ConfigID_Int configid, int value)
     if (configid < configid_int_overlay_MAX)
         OverlayManager::Get().GetCurrentConfigData().ConfigInt[configid] = value;
     else if (configid < configid_int_MAX)
+    {
         Get().m_ConfigInt[configid] = value;
+        Get().m_IsSnapshotDirty = true;
+    }
 }
 
 void ConfigManager::SetValue(ConfigID_Float configid, float value)
@@ -1797,7 +1947,10 @@ void ConfigManager::SetValue(ConfigID_Float configid, float value)
     if (configid < configid_float_overlay_MAX)
         OverlayManager::Get().GetCurrentConfigData().ConfigFloat[configid] = value;
     else if (configid < configid_float_MAX)
+    {
         Get().m_ConfigFloat[configid] = value;
+        Get().m_IsSnapshotDirty = true;
+    }
 }
 
 void ConfigManager::SetValue(ConfigID_Handle configid, uint64_t value)
@@ -1805,7 +1958,10 @@ void ConfigManager::SetValue(ConfigID_Handle configid, uint64_t value)
     if (configid < configid_handle_overlay_MAX)
         OverlayManager::Get().GetCurrentConfigData().ConfigHandle[configid] = value;
     else if (configid < configid_handle_MAX)
+    {
         Get().m_ConfigHandle[configid] = value;
+        Get().m_IsSnapshotDirty = true;
+    }
 }
 
 void ConfigManager::SetValue(ConfigID_String configid, const std::string& value)
@@ -1813,7 +1969,11 @@ void ConfigManager::SetValue(ConfigID_String configid, const std::string& value)
     if (configid < configid_str_overlay_MAX)
         OverlayManager::Get().GetCurrentConfigData().ConfigStr[configid] = value;
     else if (configid < configid_str_MAX)
+    {
         Get().m_ConfigString[configid] = value;
+        Get().m_IsSnapshotDirty       = true;
+        Get().m_IsSnapshotStringDirty = true;
+    }
 }
 
 bool ConfigManager::GetValue(ConfigID_Bool configid)
@@ -1838,27 +1998,104 @@ uint64_t ConfigManager::GetValue(ConfigID_Handle configid)
 
 const std::string& ConfigManager::GetValue(ConfigID_String configid)
 {
-    return (configid < configid_str_overlay_MAX) ? OverlayManager::Get().GetCurrentConfigData().ConfigStr[configid] : Get().m_ConfigString[configid];
+    return (configid < configid_str_overlay_MAX) ? OverlayManager::Get().GetCurrentConfigData().ConfigStr[configid].str() : Get().m_ConfigString[configid];
 }
 
 bool& ConfigManager::GetRef(ConfigID_Bool configid)
 {
-    return (configid < configid_bool_overlay_MAX) ? OverlayManager::Get().GetCurrentConfigData().ConfigBool[configid] : Get().m_ConfigBool[configid];
+    if (configid < configid_bool_overlay_MAX)
+        return OverlayManager::Get().GetCurrentConfigData().ConfigBool[configid];
+
+    return Get().m_ConfigBool[configid];
 }
 
 int& ConfigManager::GetRef(ConfigID_Int configid)
 {
-    return (configid < configid_int_overlay_MAX) ? OverlayManager::Get().GetCurrentConfigData().ConfigInt[configid] : Get().m_ConfigInt[configid];
+    if (configid < configid_int_overlay_MAX)
+        return OverlayManager::Get().GetCurrentConfigData().ConfigInt[configid];
+
+    return Get().m_ConfigInt[configid];
 }
 
 float& ConfigManager::GetRef(ConfigID_Float configid)
 {
-    return (configid < configid_float_overlay_MAX) ? OverlayManager::Get().GetCurrentConfigData().ConfigFloat[configid] : Get().m_ConfigFloat[configid];
+    if (configid < configid_float_overlay_MAX)
+        return OverlayManager::Get().GetCurrentConfigData().ConfigFloat[configid];
+
+    return Get().m_ConfigFloat[configid];
 }
 
 uint64_t& ConfigManager::GetRef(ConfigID_Handle configid)
 {
-    return (configid < configid_handle_overlay_MAX) ? OverlayManager::Get().GetCurrentConfigData().ConfigHandle[configid] : Get().m_ConfigHandle[configid];
+    if (configid < configid_handle_overlay_MAX)
+        return OverlayManager::Get().GetCurrentConfigData().ConfigHandle[configid];
+
+    return Get().m_ConfigHandle[configid];
+}
+
+const bool* ConfigManager::GetGlobalValuesBool()
+{
+    return Get().m_ConfigBool;
+}
+
+const int* ConfigManager::GetGlobalValuesInt()
+{
+    return Get().m_ConfigInt;
+}
+
+const float* ConfigManager::GetGlobalValuesFloat()
+{
+    return Get().m_ConfigFloat;
+}
+
+const uint64_t* ConfigManager::GetGlobalValuesHandle()
+{
+    return Get().m_ConfigHandle;
+}
+
+void ConfigManager::PublishSnapshot()
+{
+    std::shared_ptr<const ConfigSnapshot> snapshot_prev = std::atomic_load(&m_Snapshot);
+
+    //Values written through GetRef() references don't mark the snapshot dirty, so compare with the previous snapshot to catch those
+    if ( (!m_IsSnapshotDirty) && (snapshot_prev != nullptr) )
+    {
+        if ( (std::equal(std::begin(m_ConfigBool),   std::end(m_ConfigBool),   std::begin(snapshot_prev->ConfigBool))) &&
+             (std::equal(std::begin(m_ConfigInt),    std::end(m_ConfigInt),    std::begin(snapshot_prev->ConfigInt))) &&
+             (::memcmp(m_ConfigFloat, snapshot_prev->ConfigFloat, sizeof(m_ConfigFloat)) == 0) &&   //Bitwise so NaN doesn't count as a change every time
+             (std::equal(std::begin(m_ConfigHandle), std::end(m_ConfigHandle), std::begin(snapshot_prev->ConfigHandle))) )
+        {
+            return;
+        }
+    }
+
+    std::shared_ptr<ConfigSnapshot> snapshot = std::make_shared<ConfigSnapshot>();
+
+    snapshot->Version = (snapshot_prev != nullptr) ? snapshot_prev->Version + 1 : 1;
+    std::copy(std::begin(m_ConfigBool),   std::end(m_ConfigBool),   std::begin(snapshot->ConfigBool));
+    std::copy(std::begin(m_ConfigInt),    std::end(m_ConfigInt),    std::begin(snapshot->ConfigInt));
+    std::copy(std::begin(m_ConfigFloat),  std::end(m_ConfigFloat),  std::begin(snapshot->ConfigFloat));
+    std::copy(std::begin(m_ConfigHandle), std::end(m_ConfigHandle), std::begin(snapshot->ConfigHandle));
+
+    //Strings are comparatively expensive to copy, so share them with the previous snapshot if they didn't change
+    if ( (m_IsSnapshotStringDirty) || (snapshot_prev == nullptr) )
+    {
+        snapshot->ConfigString = std::make_shared<const ConfigSnapshot::StringList>(std::begin(m_ConfigString), std::end(m_ConfigString));
+    }
+    else
+    {
+        snapshot->ConfigString = snapshot_prev->ConfigString;
+    }
+
+    std::atomic_store(&m_Snapshot, std::shared_ptr<const ConfigSnapshot>(std::move(snapshot)));
+
+    m_IsSnapshotDirty       = false;
+    m_IsSnapshotStringDirty = false;
+}
+
+std::shared_ptr<const ConfigSnapshot> ConfigManager::GetSnapshot()
+{
+    return std::atomic_load(&Get().m_Snapshot);
 }
 
 ActionManager::ActionList& ConfigManager::GetGlobalShortcuts()
@@ -1930,6 +2167,11 @@ AppProfileManager& ConfigManager::GetAppProfileManager()
     return m_AppProfileManager;
 }
 
+ConfigFileWriter& ConfigManager::GetConfigFileWriter()
+{
+    return m_ConfigFileWriter;
+}
+
 Matrix4& ConfigManager::GetOverlayDetachedTransform()
 {
     return OverlayManager::Get().GetCurrentConfigData().ConfigTransform;
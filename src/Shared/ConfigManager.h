@@ -6,13 +6,17 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <memory>
 #define NOMINMAX
 #include <windows.h>
 
 #include "Matrices.h"
 #include "Actions.h"
 #include "AppProfiles.h"
+#include "ConfigFileWriter.h"
+#include "StringPool.h"
 #include "openvr.h"
 
 //Settings enums
@@ -78,6 +82,7 @@ enum ConfigID_Bool
     configid_bool_performance_monitor_show_trackers,
     configid_bool_performance_monitor_show_vive_wireless,
     configid_bool_performance_monitor_disable_gpu_counters,
+    configid_bool_performance_ipc_stats_enabled,
     configid_bool_input_mouse_render_cursor,
     configid_bool_input_mouse_render_intersection_blob,
     configid_bool_input_mouse_scroll_smooth,
@@ -366,19 +371,55 @@ typedef std::vector<ConfigHotkey> ConfigHotkeyList;
 class OverlayConfigData
 {
     public:
-        std::string ConfigNameStr;
+        InternedString ConfigNameStr;
         bool ConfigBool[configid_bool_overlay_MAX];
         int ConfigInt[configid_int_overlay_MAX];
         float ConfigFloat[configid_float_overlay_MAX];
         uint64_t ConfigHandle[configid_handle_overlay_MAX];
-        std::string ConfigStr[configid_str_overlay_MAX];
+        InternedString ConfigStr[configid_str_overlay_MAX];
         Matrix4 ConfigTransform;
         ActionManager::ActionList ConfigActionBarOrder;
 
         OverlayConfigData();
 };
 
-class Ini;
+//Immutable copy of the global config values for threads other than the main thread
+//The main thread publishes a new snapshot after a batch of changes. A held snapshot stays valid and consistent regardless of later changes
+//Strings are shared between snapshots until one of them changes. Overlay config values are not part of snapshots
+class ConfigSnapshot
+{
+    public:
+        typedef std::vector<std::string> StringList;
+
+        uint64_t Version = 0;                                   //Increases with every published snapshot
+        bool ConfigBool[configid_bool_MAX];
+        int ConfigInt[configid_int_MAX];
+        float ConfigFloat[configid_float_MAX];
+        uint64_t ConfigHandle[configid_handle_MAX];
+        std::shared_ptr<const StringList> ConfigString;         //Indexed by ConfigID_String
+
+        bool               GetValue(ConfigID_Bool   configid) const;
+        int                GetValue(ConfigID_Int    configid) const;
+        float              GetValue(ConfigID_Float  configid) const;
+        uint64_t           GetValue(ConfigID_Handle configid) const;
+        const std::string& GetValue(ConfigID_String configid) const;
+};
+
+//Copy of everything SaveConfigToFile() writes, so config.ini can be built on the ConfigFileWriter thread
+struct ConfigSaveState
+{
+    std::shared_ptr<const ConfigSnapshot> Config;
+    bool HasOverlayData = false;                            //False while an app profile with an overlay profile is active, which keeps the overlays in config.ini as they are
+    std::vector<OverlayConfigData> OverlayData;
+    ActionManager::ActionList ActionOrderUI;
+    ActionManager::ActionList ActionOrderBarDefault;
+    ActionManager::ActionList ActionOrderOverlayBar;
+    ActionManager::ActionList GlobalShortcuts;
+    ConfigHotkeyList Hotkeys;
+    std::unique_ptr<Ini> WindowState;                       //Persistent window state values, written to a file-less Ini
+};
+
+class OverlayProfileCatalog;
 
 class ConfigManager
 {
@@ -395,19 +436,30 @@ class ConfigManager
 
         ActionManager m_ActionManager;
         AppProfileManager m_AppProfileManager;
+        ConfigFileWriter m_ConfigFileWriter;
 
         std::string m_ApplicationPath;
         std::string m_ExecutableName;
         bool m_IsSteamInstall;
+        bool m_IsSavingDisabled = false;
+
+        //- Snapshot state, only accessed by main thread except for m_Snapshot, which is only accessed through std::atomic_load/store
+        std::shared_ptr<const ConfigSnapshot> m_Snapshot;
+        bool m_IsSnapshotDirty       = true;                            //Set by SetValue(). Changes through GetRef() are found by comparing with the last snapshot
+        bool m_IsSnapshotStringDirty = true;
 
         void LoadOverlayProfile(const Ini& config, unsigned int overlay_id);
-        void SaveOverlayProfile(Ini& config, unsigned int overlay_id);
+        void FinishOverlayProfileLoad(unsigned int overlay_id);     //Post-load adjustments to the current overlay's config after its profile values were read
         void LoadMultiOverlayProfile(const Ini& config, bool clear_existing_overlays = true, std::vector<char>* ovrl_inclusion_list = nullptr);
         void SaveMultiOverlayProfile(Ini& config, std::vector<char>* ovrl_inclusion_list = nullptr);
+        std::vector<OverlayConfigData> GetOverlayDataForSave(std::vector<char>* ovrl_inclusion_list = nullptr) const;  //Copies of the overlays' config with current WinRT window info
+        static void SaveOverlayProfile(Ini& config, const OverlayConfigData& data, unsigned int overlay_id);
+        static void SaveMultiOverlayProfile(Ini& config, const std::vector<OverlayConfigData>& overlay_data);
 
         #ifdef DPLUS_UI
             void LoadConfigPersistentWindowState(Ini& config);
             void SaveConfigPersistentWindowState(Ini& config);
+            static void SaveConfigToIni(Ini& config, const ConfigSaveState& state);    //Called on the ConfigFileWriter thread
 
             void MigrateLegacyConfig(Ini& config, bool only_rename_config_file);
             void MigrateLegacyOverlayProfileFromConfig(Ini& config, bool apply_steamvr2_dashboard_offset, LegacyActionIDtoActionUID& legacy_id_to_uid); //This writes to passed config, but doesn't save it
@@ -416,9 +468,6 @@ class ConfigManager
 
         LegacyActionIDtoActionUID MigrateLegacyActionsFromConfig(const Ini& config);   //Returns post-migration legacy ActionID to ActionUID mapping
 
-        OverlayOrigin GetOverlayOriginFromConfigString(const std::string& str);
-        const char* GetConfigStringForOverlayOrigin(OverlayOrigin origin);
-
         static bool IsUIAccessEnabled();
         static void RemoveScaleFromTransform(Matrix4& transform, float* width);
 
@@ -427,7 +476,7 @@ class ConfigManager
         static ConfigManager& Get();
 
         bool LoadConfigFromFile();
-        void SaveConfigToFile();
+        void SaveConfigToFile(bool defer_write = false);    //defer_write leaves writing the files to the ConfigFileWriter thread instead of waiting for it
         void RestoreConfigFromDefault();
 
         void LoadOverlayProfileDefault(bool multi_overlay = false);
@@ -435,13 +484,21 @@ class ConfigManager
         bool SaveMultiOverlayProfileToFile(const std::string& filename, std::vector<char>* ovrl_inclusion_list = nullptr);
         bool DeleteOverlayProfile(const std::string& filename);
         void DeleteAllOverlayProfiles();
+        void SetSavingDisabled(bool is_disabled);                      //Turns all writes and deletions of config and profile files into no-ops, used while replaying IPC recordings
 
         #ifdef DPLUS_UI
             std::vector<std::string> GetOverlayProfileList();
             std::vector< std::pair<std::string, OverlayOrigin> > GetOverlayProfileOverlayNameList(const std::string& filename);
+            OverlayProfileCatalog& GetOverlayProfileCatalog();
             void RestoreActionOrdersFromDefault();
         #endif
 
+        void PublishSnapshot();                                         //Publishes a new snapshot if the global config changed since the last one. Call after a batch of changes
+        static std::shared_ptr<const ConfigSnapshot> GetSnapshot();     //Safe to call from any thread. Returns the last published snapshot
+
+        static OverlayOrigin GetOverlayOriginFromConfigString(std::string_view str);
+        static const char* GetConfigStringForOverlayOrigin(OverlayOrigin origin);
+
         static WPARAM GetWParamForConfigID(ConfigID_Bool id);
         static WPARAM GetWParamForConfigID(ConfigID_Int id);
         static WPARAM GetWParamForConfigID(ConfigID_Float id);
@@ -464,6 +521,12 @@ class ConfigManager
         static float&    GetRef(ConfigID_Float  configid);
         static uint64_t& GetRef(ConfigID_Handle configid);
 
+        //Global value arrays, indexed by config ID. Entries below the overlay MAX IDs are unused, as overlay values are stored in OverlayManager instead
+        static const bool*     GetGlobalValuesBool();
+        static const int*      GetGlobalValuesInt();
+        static const float*    GetGlobalValuesFloat();
+        static const uint64_t* GetGlobalValuesHandle();
+
         ActionManager::ActionList& GetGlobalShortcuts();
         const ActionManager::ActionList& GetGlobalShortcuts() const;
         ConfigHotkeyList& GetHotkeys();
@@ -474,6 +537,7 @@ class ConfigManager
 
         ActionManager& GetActionManager();
         AppProfileManager& GetAppProfileManager();
+        ConfigFileWriter& GetConfigFileWriter();
         Matrix4& GetOverlayDetachedTransform();
 
         const std::string& GetApplicationPath() const;
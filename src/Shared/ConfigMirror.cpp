@@ -0,0 +1,193 @@
+#include "ConfigMirror.h"
+
+#include <algorithm>
+#include <string>
+#include <cstring>
+#include <cstddef>
+
+#include "OverlayManager.h"
+
+static const uint32_t k_ConfigMirrorMagic      = 0x4D435044;    //"DPCM"
+static const uint32_t k_ConfigMirrorVersion    = 2;
+static const int      k_ConfigMirrorReadTries  = 64;            //Writes are a few memcpy calls, so running out of tries means the owner died while writing
+
+static std::string ConfigMirrorGetName(IPCPeerID owner_id)
+{
+    static const char* const peer_names[ipcpeer_MAX] = {"Dashboard", "UI", "Elevated"};
+
+    return std::string("DesktopPlusConfigMirror_") + peer_names[owner_id];
+}
+
+//Copies the global values and the given number of overlays, so readers don't copy the values of overlays that don't exist
+static void ConfigMirrorCopy(ConfigMirrorData& dst, const ConfigMirrorData& src, uint32_t overlay_count)
+{
+    memcpy(&dst, &src, offsetof(ConfigMirrorData, OverlayStateFPS));
+    memcpy(dst.OverlayStateFPS, src.OverlayStateFPS, sizeof(int) * overlay_count);
+}
+
+uint32_t ConfigMirrorData::GetMirroredOverlayCount() const
+{
+    return std::min(OverlayCount, k_ConfigMirrorOverlayMax);
+}
+
+ConfigMirror::ConfigMirror() : m_Header(nullptr), m_Data(nullptr), m_IsOwner(false), m_LastSequence(0)
+{
+}
+
+bool ConfigMirror::Map(IPCPeerID owner_id, bool is_owner)
+{
+    Close();
+
+    if (owner_id >= ipcpeer_MAX)
+        return false;
+
+    const std::string name = ConfigMirrorGetName(owner_id);
+    const size_t memory_size = sizeof(ConfigMirrorHeader) + sizeof(ConfigMirrorData);
+
+    bool is_open = (is_owner) ? m_SharedMemory.Create(name.c_str(), memory_size) : m_SharedMemory.Open(name.c_str(), memory_size);
+
+    if (!is_open)
+        return false;
+
+    ConfigMirrorHeader* header = (ConfigMirrorHeader*)m_SharedMemory.GetData();
+
+    if (m_SharedMemory.IsCreator())
+    {
+        //New blocks are zeroed, which is an empty mirror with nothing published yet
+        header->Magic    = k_ConfigMirrorMagic;
+        header->Version  = k_ConfigMirrorVersion;
+        header->DataSize = sizeof(ConfigMirrorData);
+        header->Sequence.store(0, std::memory_order_release);
+    }
+    else if ( (header->Magic != k_ConfigMirrorMagic) || (header->Version != k_ConfigMirrorVersion) || (header->DataSize != sizeof(ConfigMirrorData)) )
+    {
+        //Not initialized yet or from a different build
+        m_SharedMemory.Close();
+        return false;
+    }
+
+    m_Header    = header;
+    m_Data      = (ConfigMirrorData*)(header + 1);
+    m_IsOwner   = is_owner;
+    m_LocalData = std::make_unique<ConfigMirrorData>();
+
+    if (m_IsOwner)
+    {
+        //Previous owner may have died while writing, make the sequence even again. Readers will pick up the next publish
+        uint64_t sequence = m_Header->Sequence.load(std::memory_order_relaxed);
+        m_Header->Sequence.store((sequence + 1) & ~1ull, std::memory_order_release);
+
+        //Force a publish on the first call
+        memset(m_LocalData.get(), 0xFF, sizeof(ConfigMirrorData));
+    }
+
+    return true;
+}
+
+bool ConfigMirror::Create(IPCPeerID owner_id)
+{
+    return Map(owner_id, true);
+}
+
+bool ConfigMirror::Open(IPCPeerID owner_id)
+{
+    return Map(owner_id, false);
+}
+
+void ConfigMirror::Close()
+{
+    m_SharedMemory.Close();
+    m_Header  = nullptr;
+    m_Data    = nullptr;
+    m_IsOwner = false;
+    m_LocalData.reset();
+    m_LastSequence = 0;
+}
+
+bool ConfigMirror::IsOpen() const
+{
+    return (m_Header != nullptr);
+}
+
+void ConfigMirror::Publish()
+{
+    if ( (!IsOpen()) || (!m_IsOwner) )
+        return;
+
+    const OverlayManager& overlay_manager = OverlayManager::Get();
+    ConfigMirrorData& local = *m_LocalData;
+
+    const bool*     config_bool   = ConfigManager::GetGlobalValuesBool();
+    const int*      config_int    = ConfigManager::GetGlobalValuesInt();
+    const float*    config_float  = ConfigManager::GetGlobalValuesFloat();
+    const uint64_t* config_handle = ConfigManager::GetGlobalValuesHandle();
+
+    const uint32_t overlay_count  = overlay_manager.GetOverlayCount();
+    const uint32_t mirrored_count = std::min(overlay_count, k_ConfigMirrorOverlayMax);
+
+    //Compare against the last published data first, most frames don't change anything
+    bool has_changed = ( (local.OverlayCount != overlay_count) ||
+                         (memcmp(local.ConfigBool,   config_bool,   sizeof(local.ConfigBool))   != 0) || (memcmp(local.ConfigInt,    config_int,    sizeof(local.ConfigInt))    != 0) ||
+                         (memcmp(local.ConfigFloat,  config_float,  sizeof(local.ConfigFloat))  != 0) || (memcmp(local.ConfigHandle, config_handle, sizeof(local.ConfigHandle)) != 0) );
+
+    for (uint32_t i = 0; i < mirrored_count; ++i)
+    {
+        const int overlay_fps = overlay_manager.GetConfigData(i).ConfigInt[configid_int_overlay_state_fps];
+
+        if (local.OverlayStateFPS[i] != overlay_fps)
+        {
+            local.OverlayStateFPS[i] = overlay_fps;
+            has_changed = true;
+        }
+    }
+
+    if (!has_changed)
+        return;
+
+    local.OverlayCount = overlay_count;
+    memcpy(local.ConfigBool,   config_bool,   sizeof(local.ConfigBool));
+    memcpy(local.ConfigInt,    config_int,    sizeof(local.ConfigInt));
+    memcpy(local.ConfigFloat,  config_float,  sizeof(local.ConfigFloat));
+    memcpy(local.ConfigHandle, config_handle, sizeof(local.ConfigHandle));
+
+    //Odd sequence marks the data as being written. The fence keeps the data writes from being moved before it
+    const uint64_t sequence = m_Header->Sequence.load(std::memory_order_relaxed);
+    m_Header->Sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    ConfigMirrorCopy(*m_Data, local, mirrored_count);
+
+    m_Header->Sequence.store(sequence + 2, std::memory_order_release);
+}
+
+const ConfigMirrorData* ConfigMirror::Read()
+{
+    if ( (!IsOpen()) || (m_IsOwner) )
+        return nullptr;
+
+    for (int i = 0; i < k_ConfigMirrorReadTries; ++i)
+    {
+        const uint64_t sequence = m_Header->Sequence.load(std::memory_order_acquire);
+
+        if ( (sequence == 0) || (sequence == m_LastSequence) )
+            return nullptr;
+
+        if ((sequence & 1) != 0)
+            continue;
+
+        //The overlay count may be torn, so clamp it before using it for the copy. The result is thrown away in that case anyway
+        ConfigMirrorData& local = *m_LocalData;
+        ConfigMirrorCopy(local, *m_Data, std::min(m_Data->OverlayCount, k_ConfigMirrorOverlayMax));
+
+        //Keeps the data reads from being moved after the second sequence read
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (m_Header->Sequence.load(std::memory_order_relaxed) == sequence)
+        {
+            m_LastSequence = sequence;
+            return &local;
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,68 @@
+//Copy of a process' plain global config values (bool, int, float and handle) and frequently changing overlay state values in memory shared with the other Desktop+ processes
+//The owning process publishes it once per frame if anything changed. Other processes can read a consistent copy at any time without waiting for config messages
+//Consistency is ensured by a sequence lock: the sequence is odd while the owner writes and readers retry if it was odd or changed during their copy
+//Readers never block the owner. Strings and values whose changes need handling on the receiving side are still synced through IPC messages
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+#include "ConfigManager.h"
+#include "InterprocessMessaging.h"
+#include "IPCSharedMemory.h"
+
+static const uint32_t k_ConfigMirrorOverlayMax = 256;   //Overlays beyond this are not mirrored
+
+struct ConfigMirrorData
+{
+    bool ConfigBool[configid_bool_MAX];
+    int ConfigInt[configid_int_MAX];
+    float ConfigFloat[configid_float_MAX];
+    uint64_t ConfigHandle[configid_handle_MAX];
+    uint32_t OverlayCount;                              //Overlay count of the owner, may be higher than the number of mirrored overlays
+    int OverlayStateFPS[k_ConfigMirrorOverlayMax];      //configid_int_overlay_state_fps of each overlay. Other overlay values are only synced through IPC messages
+
+    uint32_t GetMirroredOverlayCount() const;
+};
+
+struct ConfigMirrorHeader
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t DataSize;                                  //sizeof(ConfigMirrorData), catches mismatching config ID lists
+    uint32_t Reserved;
+    alignas(64) std::atomic<uint64_t> Sequence;         //Odd while the owner is writing, 0 if nothing was published yet
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Config mirror sequence needs to be lock-free to work across processes");
+
+class ConfigMirror
+{
+    private:
+        IPCSharedMemory m_SharedMemory;
+        ConfigMirrorHeader* m_Header;
+        ConfigMirrorData* m_Data;
+        bool m_IsOwner;
+        std::unique_ptr<ConfigMirrorData> m_LocalData;  //Owner: Last published data. Reader: Data being copied before the sequence is checked
+        uint64_t m_LastSequence;                        //Reader: Sequence of the last successful Read()
+
+        bool Map(IPCPeerID owner_id, bool is_owner);
+
+    public:
+        ConfigMirror();
+        ConfigMirror(const ConfigMirror&) = delete;
+        ConfigMirror& operator=(const ConfigMirror&) = delete;
+
+        bool Create(IPCPeerID owner_id);                //Called by the owning process. Keeps using the existing block if a reader still holds it from a previous instance
+        bool Open(IPCPeerID owner_id);                  //Called by reading processes. Fails if the owner hasn't created the mirror yet
+        void Close();
+        bool IsOpen() const;
+
+        //Owner: Copies the current global config values of ConfigManager and overlay state values of OverlayManager into the mirror if they changed since the last call
+        void Publish();
+        //Reader: Returns pointer to a consistent copy of the mirror or nullptr if nothing new was published since the last call or the owner is stuck writing
+        //The copy stays valid until the next call
+        const ConfigMirrorData* Read();
+};
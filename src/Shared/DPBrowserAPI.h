@@ -4,10 +4,15 @@
     #define NOMINMAX
 #endif
 #include <windows.h>
+#include <cstdint>
+#include <cstring>
 
 #include "openvr.h"
 
-static const int k_lDPBrowserAPIVersion = 5;
+static const int k_lDPBrowserAPIVersion           = 7;
+static const int k_lDPBrowserAPIVersionMin        = 5;                                  //Oldest API version of the other side that is still supported
+static const int k_lDPBrowserAPIVersionCompound   = 6;                                  //First API version supporting compound commands
+static const int k_lDPBrowserAPIVersionInputBatch = 7;                                  //First API version supporting dpbrowser_ipcstr_input_batch
 LPCWSTR const g_WindowClassNameBrowserApp        = L"elvdesktopbrowser";
 LPCWSTR const g_WindowMessageNameBrowserApp      = L"WMIPC_DPLUS_BrowserCommand";
 const char* const g_AppKeyBrowserApp             = "elvissteinjr.DesktopPlusBrowser";
@@ -16,7 +21,7 @@ const char* const g_ExeNameBrowserApp            = "DesktopPlusBrowser.exe";
 
 enum DPBrowserICPCommandID
 {
-    dpbrowser_ipccmd_get_api_version,           //No value in lParam, use SendMessage(), gets the supported API version from the browser process
+    dpbrowser_ipccmd_get_api_version,           //lParam = client API version (0 from clients older than version 6), use SendMessage(), gets the supported API version from the browser process
     dpbrowser_ipccmd_set_overlay_target,        //lParam = overlay_handle, sets target overlay for commands that use lParam for other arguments | Also sent by browser process
     dpbrowser_ipccmd_start_browser,             //lParam = use_transparent_background bool, uses set_overlay_target & dpbrowser_ipcstr_url arg
     dpbrowser_ipccmd_duplicate_browser_output,  //lParam = overlay_handle_dst, uses set_overlay_target arg (overlay_handle_src)
@@ -51,8 +56,76 @@ enum DPBrowserICPCommandID
     dpbrowser_ipccmd_notify_lpointer_haptics,   //No value in lParam, triggers short UI interaction burst on primary device | Sent by browser process to dashboard process
     dpbrowser_ipccmd_notify_keyboard_show,      //lParam = show bool, uses set_overlay_target arg | Sent by browser process to UI process
     dpbrowser_ipccmd_notify_cblock_list_count,  //lParam = list count | Sent by browser process to UI process
+    dpbrowser_ipccmd_input_batch,               //lParam = batch ID, applies the dpbrowser_ipcstr_input_batch entries with that batch ID (API version 7+)
 };
 
+//Compound commands carry target overlay, command and arguments in a single message instead of set_overlay_target followed by the command (API version 6+)
+//wParam = dpbrowser_ipccmd_compound_flag + command ID (low byte) + arguments (upper 48 bits), lParam = overlay_handle
+//Only used for commands using the set_overlay_target arg. Arguments are the command's lParam value, except for dpbrowser_ipccmd_scroll, see DPBrowserAPIPackCompoundScroll()
+//Commands with arguments not fitting into 48 bits are still sent the old way. Compound commands don't change the target set by set_overlay_target
+//Both sides only send them if the other side reported a version >= k_lDPBrowserAPIVersionCompound during dpbrowser_ipccmd_get_api_version
+static const WPARAM dpbrowser_ipccmd_compound_flag = 0x100;
+
+inline bool DPBrowserAPIIsCompound(WPARAM w_param)
+{
+    return ((w_param & dpbrowser_ipccmd_compound_flag) != 0);
+}
+
+inline bool DPBrowserAPICompoundArgsFit(LPARAM args)
+{
+    return (((uint64_t)args >> 48) == 0);
+}
+
+inline WPARAM DPBrowserAPIPackCompound(int command_id, LPARAM args)
+{
+    return dpbrowser_ipccmd_compound_flag | ((WPARAM)command_id & 0xFF) | ((WPARAM)args << 16);
+}
+
+inline int DPBrowserAPIGetCompoundCommand(WPARAM w_param)
+{
+    return (int)(w_param & 0xFF);
+}
+
+inline LPARAM DPBrowserAPIGetCompoundArgs(WPARAM w_param)
+{
+    return (LPARAM)(w_param >> 16);
+}
+
+//Input collected by a client during one frame, sent as dpbrowser_ipcstr_input_batch data followed by posting dpbrowser_ipccmd_input_batch
+//The server only stores the entries on arrival, so they're applied in order with the other posted commands instead of overtaking them
+//Entries are handled in order as if each was sent as command with the overlay as target, without changing the target set by set_overlay_target
+//Stored entries of batches with another ID are dropped when dpbrowser_ipccmd_input_batch is handled. This covers batches sent again before the command of the previous one was
+//handled as well as ones the client gave up on sending
+//Only mouse_move, mouse_down, mouse_up, scroll, keyboard_vkey, keyboard_vkey_toggle and keyboard_wchar are sent this way. LParam is the command's full lParam value
+struct DPBrowserIPCInputBatchEntry
+{
+    uint64_t OverlayHandle;
+    int64_t LParam;
+    uint32_t CommandID;
+    uint32_t BatchID;
+};
+
+static const size_t k_lDPBrowserAPIStringDataMax      = 4096;                                                     //Servers ignore string data larger than this
+static const size_t k_lDPBrowserAPIInputBatchEntryMax = k_lDPBrowserAPIStringDataMax / sizeof(DPBrowserIPCInputBatchEntry); //170, clients send batches early when they reach this size
+
+//Scroll deltas are two floats with the lowest 8 mantissa bits dropped (X in the low, Y in the high 24 bits), which is plenty for scroll wheel deltas
+inline LPARAM DPBrowserAPIPackCompoundScroll(float x_delta, float y_delta)
+{
+    uint32_t x_bits = 0, y_bits = 0;
+    memcpy(&x_bits, &x_delta, sizeof(float));
+    memcpy(&y_bits, &y_delta, sizeof(float));
+
+    return (LPARAM)( (uint64_t)(x_bits >> 8) | ((uint64_t)(y_bits >> 8) << 24) );
+}
+
+inline void DPBrowserAPIUnpackCompoundScroll(LPARAM args, float& x_delta, float& y_delta)
+{
+    const uint32_t x_bits = (uint32_t)(args & 0xFFFFFF) << 8;
+    const uint32_t y_bits = (uint32_t)((args >> 24) & 0xFFFFFF) << 8;
+    memcpy(&x_delta, &x_bits, sizeof(float));
+    memcpy(&y_delta, &y_bits, sizeof(float));
+}
+
 enum DPBrowserICPStringID
 {
     dpbrowser_ipcstr_MIN = 1000,                //Start IDs at a higher value to avoid conflicts with config string messages on a client
@@ -62,6 +135,7 @@ enum DPBrowserICPStringID
     dpbrowser_ipcstr_tstr_error_title,          //Error page translation string
     dpbrowser_ipcstr_tstr_error_heading,        //Error page translation string
     dpbrowser_ipcstr_tstr_error_message,        //Error page translation string
+    dpbrowser_ipcstr_input_batch,               //Array of DPBrowserIPCInputBatchEntry for upcoming dpbrowser_ipccmd_input_batch commands (API version 7+)
     dpbrowser_ipcstr_MAX
 };
 
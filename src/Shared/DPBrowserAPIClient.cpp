@@ -2,6 +2,7 @@
 
 #include "ConfigManager.h"
 #include "InterprocessMessaging.h"
+#include "IPCStats.h"
 #include "Util.h"
 #include "Logging.h"
 
@@ -15,6 +16,9 @@
 
 static DPBrowserAPIClient g_DPBrowserAPIClient;
 
+//WM_COPYDATA can't be posted, so input batches are sent with this timeout to not stall the frame for long when the server is busy. Hung servers are skipped right away
+static const UINT k_DPBrowserAPIClientInputBatchTimeoutMs = 50;
+
 bool DPBrowserAPIClient::LaunchServerIfNotRunning()
 {
     //This is not going to work with the executable missing or previously discovered API mismatch
@@ -94,27 +98,8 @@ bool DPBrowserAPIClient::LaunchServerIfNotRunning()
     }
 
     //Check if the API versions match
-    if (m_ServerWindowHandle != nullptr)
-    {
-        const int server_api_version = (int)::SendMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_get_api_version, 0);
-
-        if (server_api_version != k_lDPBrowserAPIVersion)
-        {
-            m_HasServerAPIMismatch = true;
-
-            //Send quit message so the process doesn't linger around
-            ::PostMessage(m_ServerWindowHandle, WM_QUIT, 0, 0);
-
-            m_ServerWindowHandle = nullptr;
-
-            //Post config state to UI to allow displaying a warning since the UI doesn't try to launch the browser process on its own in most cases
-            IPCManager::Get().PostConfigMessageToUIApp(configid_bool_state_misc_browser_version_mismatch, true);
-
-            LOG_F(ERROR, "Desktop+ Browser API version does not match! Expected version %d, but got %d", k_lDPBrowserAPIVersion, server_api_version);
-
-            return false;
-        }
-    }
+    if ( (m_ServerWindowHandle != nullptr) && (!CheckServerAPIVersion()) )
+        return false;
 
     ApplyPendingSettings();
 
@@ -132,16 +117,49 @@ bool DPBrowserAPIClient::IsServerRunning()
     //Check if it's already running and update cached handle
     HWND window_handle = ::FindWindow(g_WindowClassNameBrowserApp, nullptr);
 
-    //Apply pending settings if window handle changed (only really useful after restarting UI process)
+    //Check API version and apply pending settings if window handle changed (only really useful after restarting UI process)
     if (m_ServerWindowHandle != window_handle)
     {
         m_ServerWindowHandle = window_handle;
+        m_ServerAPIVersion   = 0;
+
+        if ( (m_ServerWindowHandle != nullptr) && (!CheckServerAPIVersion()) )
+            return false;
+
         ApplyPendingSettings();
     }
 
     return (m_ServerWindowHandle != nullptr);
 }
 
+bool DPBrowserAPIClient::CheckServerAPIVersion()
+{
+    //Servers from version 6 on get our version to know if they can send compound commands, older ones ignore it
+    const int server_api_version = (int)::SendMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_get_api_version, k_lDPBrowserAPIVersion);
+
+    if ( (server_api_version < k_lDPBrowserAPIVersionMin) || (server_api_version > k_lDPBrowserAPIVersion) )
+    {
+        m_HasServerAPIMismatch = true;
+        m_ServerAPIVersion     = 0;
+
+        //Send quit message so the process doesn't linger around
+        ::PostMessage(m_ServerWindowHandle, WM_QUIT, 0, 0);
+
+        m_ServerWindowHandle = nullptr;
+
+        //Post config state to UI to allow displaying a warning since the UI doesn't try to launch the browser process on its own in most cases
+        IPCManager::Get().PostConfigMessageToUIApp(configid_bool_state_misc_browser_version_mismatch, true);
+
+        LOG_F(ERROR, "Desktop+ Browser API version does not match! Expected version %d to %d, but got %d", k_lDPBrowserAPIVersionMin, k_lDPBrowserAPIVersion, server_api_version);
+
+        return false;
+    }
+
+    m_ServerAPIVersion = server_api_version;
+
+    return true;
+}
+
 void DPBrowserAPIClient::ApplyPendingSettings()
 {
     //Apply pending settings, if there are any
@@ -173,6 +191,11 @@ void DPBrowserAPIClient::ApplyPendingSettings()
 }
 
 void DPBrowserAPIClient::SendStringMessage(DPBrowserICPStringID str_id, const std::string& str) const
+{
+    SendDataMessage(str_id, str.c_str(), str.length());  //We do not include the NUL byte
+}
+
+bool DPBrowserAPIClient::SendDataMessage(DPBrowserICPStringID str_id, const void* data, size_t size, UINT timeout_ms) const
 {
     HWND source_window = nullptr;
     #ifdef DPLUS_UI
@@ -191,10 +214,117 @@ void DPBrowserAPIClient::SendStringMessage(DPBrowserICPStringID str_id, const st
     {
         COPYDATASTRUCT cds = {0};
         cds.dwData = str_id;
-        cds.cbData = (DWORD)str.length();  //We do not include the NUL byte
-        cds.lpData = (void*)str.c_str();
+        cds.cbData = (DWORD)size;
+        cds.lpData = (void*)data;
+
+        //SendMessage() returns once the receiver handled the message, so the time spent in it is the latency
+        const bool is_stats_enabled = IPCStats::Get().IsEnabled();
+        const int64_t send_timestamp = (is_stats_enabled) ? IPCStats::GetTimestamp() : 0;
+
+        if (timeout_ms == 0)
+        {
+            ::SendMessage(m_ServerWindowHandle, WM_COPYDATA, (WPARAM)source_window, (LPARAM)(LPVOID)&cds);
+        }
+        else if (::SendMessageTimeout(m_ServerWindowHandle, WM_COPYDATA, (WPARAM)source_window, (LPARAM)(LPVOID)&cds, SMTO_NORMAL | SMTO_ABORTIFHUNG, timeout_ms, nullptr) == 0)
+        {
+            return false;
+        }
+
+        if (is_stats_enabled)
+        {
+            IPCStats::Get().RecordSend(ipcstats_browser_string, str_id - dpbrowser_ipcstr_MIN, size);
+            IPCStats::Get().RecordLatency(ipcstats_browser_string, str_id - dpbrowser_ipcstr_MIN, IPCStats::Get().GetMicrosecondsSince(send_timestamp));
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+void DPBrowserAPIClient::PostCommandMessage(DPBrowserICPCommandID command_id, LPARAM l_param)
+{
+    //Don't overtake queued commands
+    FlushQueuedCommands();
+    PostCommandMessageDirect(command_id, l_param);
+}
+
+void DPBrowserAPIClient::PostCommandMessageDirect(DPBrowserICPCommandID command_id, LPARAM l_param) const
+{
+    if (IPCStats::Get().IsEnabled())
+    {
+        IPCStats::Get().RecordSend(ipcstats_browser, command_id, sizeof(WPARAM) + sizeof(LPARAM));
+    }
+
+    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, command_id, l_param);
+}
+
+void DPBrowserAPIClient::PostTargetedCommandMessage(vr::VROverlayHandle_t overlay_handle, DPBrowserICPCommandID command_id, LPARAM l_param)
+{
+    //Don't overtake queued commands
+    FlushQueuedCommands();
+    PostTargetedCommandMessageDirect(overlay_handle, command_id, l_param);
+}
 
-        ::SendMessage(m_ServerWindowHandle, WM_COPYDATA, (WPARAM)source_window, (LPARAM)(LPVOID)&cds);
+void DPBrowserAPIClient::PostTargetedCommandMessageDirect(vr::VROverlayHandle_t overlay_handle, DPBrowserICPCommandID command_id, LPARAM l_param) const
+{
+    //Scroll deltas are sent with reduced precision in compound commands
+    if ( (command_id == dpbrowser_ipccmd_scroll) && (m_ServerAPIVersion >= k_lDPBrowserAPIVersionCompound) )
+    {
+        l_param = DPBrowserAPIPackCompoundScroll(pun_cast<float, DWORD>(LODWORD(l_param)), pun_cast<float, DWORD>(HIDWORD(l_param)));
+    }
+
+    //Fall back to setting the target first for older servers or arguments not fitting into a compound command
+    if ( (m_ServerAPIVersion < k_lDPBrowserAPIVersionCompound) || (!DPBrowserAPICompoundArgsFit(l_param)) )
+    {
+        PostCommandMessageDirect(dpbrowser_ipccmd_set_overlay_target, overlay_handle);
+        PostCommandMessageDirect(command_id, l_param);
+        return;
+    }
+
+    if (IPCStats::Get().IsEnabled())
+    {
+        IPCStats::Get().RecordSend(ipcstats_browser, command_id, sizeof(WPARAM) + sizeof(LPARAM));
+    }
+
+    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, DPBrowserAPIPackCompound(command_id, l_param), (LPARAM)overlay_handle);
+}
+
+void DPBrowserAPIClient::QueueInput(vr::VROverlayHandle_t overlay_handle, DPBrowserICPCommandID command_id, LPARAM l_param)
+{
+    //Merge with the previous entry if it's the same input on the same overlay. Only the latest mouse position matters and scroll deltas add up
+    if (!m_InputBatch.empty())
+    {
+        DPBrowserIPCInputBatchEntry& entry_last = m_InputBatch.back();
+
+        if ( (entry_last.OverlayHandle == overlay_handle) && (entry_last.CommandID == (uint32_t)command_id) )
+        {
+            if (command_id == dpbrowser_ipccmd_mouse_move)
+            {
+                entry_last.LParam = l_param;
+                return;
+            }
+            else if (command_id == dpbrowser_ipccmd_scroll)
+            {
+                const float x_delta = pun_cast<float, DWORD>(LODWORD(entry_last.LParam)) + pun_cast<float, DWORD>(LODWORD(l_param));
+                const float y_delta = pun_cast<float, DWORD>(HIDWORD(entry_last.LParam)) + pun_cast<float, DWORD>(HIDWORD(l_param));
+
+                entry_last.LParam = (int64_t)MAKEQWORD(pun_cast<DWORD, float>(x_delta), pun_cast<DWORD, float>(y_delta));
+                return;
+            }
+        }
+    }
+
+    DPBrowserIPCInputBatchEntry entry = {0};
+    entry.OverlayHandle = overlay_handle;
+    entry.LParam        = l_param;
+    entry.CommandID     = command_id;
+
+    m_InputBatch.push_back(entry);
+
+    if (m_InputBatch.size() >= k_lDPBrowserAPIInputBatchEntryMax)
+    {
+        FlushQueuedCommands();
     }
 }
 
@@ -232,8 +362,10 @@ void DPBrowserAPIClient::Quit()
     ::PostMessage(m_ServerWindowHandle, WM_QUIT, 0, 0);
 
     //Reset some variables, though this usually is just called during Desktop+ shutdown
-    m_HasServerAPIMismatch = false;
-    m_ServerWindowHandle   = nullptr;
+    m_HasServerAPIMismatch   = false;
+    m_ServerWindowHandle     = nullptr;
+    m_ServerAPIVersion       = 0;
+    m_InputBatch.clear();
 }
 
 bool DPBrowserAPIClient::IsBrowserAvailable() const
@@ -264,7 +396,7 @@ void DPBrowserAPIClient::HandleIPCMessage(const MSG& msg)
         COPYDATASTRUCT* pcds = (COPYDATASTRUCT*)msg.lParam;
 
         //Arbitrary size limit to prevent some malicous applications from sending bad data
-        if ( (pcds->dwData >= dpbrowser_ipcstr_MIN) && (pcds->dwData < dpbrowser_ipcstr_MAX) && (pcds->cbData <= 4096) ) 
+        if ( (pcds->dwData >= dpbrowser_ipcstr_MIN) && (pcds->dwData < dpbrowser_ipcstr_MAX) && (pcds->cbData <= k_lDPBrowserAPIStringDataMax) ) 
         {
             std::string copystr((char*)pcds->lpData, pcds->cbData); //We rely on the data length. The data is sent without the NUL byte
 
@@ -279,6 +411,21 @@ void DPBrowserAPIClient::HandleIPCMessage(const MSG& msg)
         return;
     }
 
+    //Handle compound commands as the plain command with their target, then restore the target set by set_overlay_target
+    if (DPBrowserAPIIsCompound(msg.wParam))
+    {
+        const vr::VROverlayHandle_t overlay_target_prev = m_IPCOverlayTarget;
+        m_IPCOverlayTarget = msg.lParam;
+
+        MSG msg_command = msg;
+        msg_command.wParam = DPBrowserAPIGetCompoundCommand(msg.wParam);
+        msg_command.lParam = DPBrowserAPIGetCompoundArgs(msg.wParam);
+        HandleIPCMessage(msg_command);
+
+        m_IPCOverlayTarget = overlay_target_prev;
+        return;
+    }
+
     switch (msg.wParam)
     {
         case dpbrowser_ipccmd_set_overlay_target:
@@ -414,8 +561,7 @@ void DPBrowserAPIClient::DPBrowser_StartBrowser(vr::VROverlayHandle_t overlay_ha
         return;
 
     SendStringMessage(dpbrowser_ipcstr_url, url);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_start_browser, use_transparent_background);
+    PostTargetedCommandMessage(overlay_handle, dpbrowser_ipccmd_start_browser, use_transparent_background);
 }
 
 void DPBrowserAPIClient::DPBrowser_DuplicateBrowserOutput(vr::VROverlayHandle_t overlay_handle_src, vr::VROverlayHandle_t overlay_handle_dst)
@@ -423,8 +569,7 @@ void DPBrowserAPIClient::DPBrowser_DuplicateBrowserOutput(vr::VROverlayHandle_t
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle_src);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_duplicate_browser_output, overlay_handle_dst);
+    PostTargetedCommandMessage(overlay_handle_src, dpbrowser_ipccmd_duplicate_browser_output, overlay_handle_dst);
 }
 
 void DPBrowserAPIClient::DPBrowser_PauseBrowser(vr::VROverlayHandle_t overlay_handle, bool pause)
@@ -432,8 +577,7 @@ void DPBrowserAPIClient::DPBrowser_PauseBrowser(vr::VROverlayHandle_t overlay_ha
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_pause_browser, pause);
+    PostTargetedCommandMessage(overlay_handle, dpbrowser_ipccmd_pause_browser, pause);
 }
 
 void DPBrowserAPIClient::DPBrowser_RecreateBrowser(vr::VROverlayHandle_t overlay_handle, bool use_transparent_background)
@@ -441,8 +585,7 @@ void DPBrowserAPIClient::DPBrowser_RecreateBrowser(vr::VROverlayHandle_t overlay
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_recreate_browser, use_transparent_background);
+    PostTargetedCommandMessage(overlay_handle, dpbrowser_ipccmd_recreate_browser, use_transparent_background);
 }
 
 void DPBrowserAPIClient::DPBrowser_StopBrowser(vr::VROverlayHandle_t overlay_handle)
@@ -450,7 +593,7 @@ void DPBrowserAPIClient::DPBrowser_StopBrowser(vr::VROverlayHandle_t overlay_han
     if (!IsServerRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_stop_browser, overlay_handle);
+    PostCommandMessage(dpbrowser_ipccmd_stop_browser, overlay_handle);
 }
 
 void DPBrowserAPIClient::DPBrowser_SetURL(vr::VROverlayHandle_t overlay_handle, const std::string& url)
@@ -459,7 +602,7 @@ void DPBrowserAPIClient::DPBrowser_SetURL(vr::VROverlayHandle_t overlay_handle,
         return;
 
     SendStringMessage(dpbrowser_ipcstr_url, url);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_url, overlay_handle);
+    PostCommandMessage(dpbrowser_ipccmd_set_url, overlay_handle);
 }
 
 void DPBrowserAPIClient::DPBrowser_SetResolution(vr::VROverlayHandle_t overlay_handle, int width, int height)
@@ -467,8 +610,7 @@ void DPBrowserAPIClient::DPBrowser_SetResolution(vr::VROverlayHandle_t overlay_h
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_resoution, MAKELPARAM(width, height));
+    PostTargetedCommandMessage(overlay_handle, dpbrowser_ipccmd_set_resoution, MAKELPARAM(width, height));
 }
 
 void DPBrowserAPIClient::DPBrowser_SetFPS(vr::VROverlayHandle_t overlay_handle, int fps)
@@ -476,8 +618,7 @@ void DPBrowserAPIClient::DPBrowser_SetFPS(vr::VROverlayHandle_t overlay_handle,
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_fps, fps);
+    PostTargetedCommandMessage(overlay_handle, dpbrowser_ipccmd_set_fps, fps);
 }
 
 void DPBrowserAPIClient::DPBrowser_SetZoomLevel(vr::VROverlayHandle_t overlay_handle, float zoom_level)
@@ -485,8 +626,7 @@ void DPBrowserAPIClient::DPBrowser_SetZoomLevel(vr::VROverlayHandle_t overlay_ha
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_zoom, pun_cast<LPARAM, float>(zoom_level));
+    PostTargetedCommandMessage(overlay_handle, dpbrowser_ipccmd_set_zoom, pun_cast<LPARAM, float>(zoom_level));
 }
 
 void DPBrowserAPIClient::DPBrowser_SetOverUnder3D(vr::VROverlayHandle_t overlay_handle, bool is_over_under_3D, int crop_x, int crop_y, int crop_width, int crop_height)
@@ -494,16 +634,15 @@ void DPBrowserAPIClient::DPBrowser_SetOverUnder3D(vr::VROverlayHandle_t overlay_
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-
+    //These arguments don't fit into a compound command and are sent with set_overlay_target first
     if (is_over_under_3D)
     {
         DPRect dp_rect(crop_x, crop_y, crop_x + crop_width, crop_y + crop_height);
-        ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_ou3d_crop, (LPARAM)dp_rect.Pack16());
+        PostTargetedCommandMessage(overlay_handle, dpbrowser_ipccmd_set_ou3d_crop, (LPARAM)dp_rect.Pack16());
     }
     else
     {
-        ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_ou3d_crop, -1);
+        PostTargetedCommandMessage(overlay_handle, dpbrowser_ipccmd_set_ou3d_crop, -1);
     }
 }
 
@@ -512,8 +651,57 @@ void DPBrowserAPIClient::DPBrowser_MouseMove(vr::VROverlayHandle_t overlay_handl
     if (!IsServerRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_mouse_move, MAKELPARAM(x, y));
+    QueueInput(overlay_handle, dpbrowser_ipccmd_mouse_move, MAKELPARAM(x, y));
+}
+
+void DPBrowserAPIClient::FlushQueuedCommands()
+{
+    if (m_InputBatch.empty())
+        return;
+
+    //Take the batch out first, SendMessageTimeout() may handle incoming messages that end up calling this again
+    std::vector<DPBrowserIPCInputBatchEntry> input_batch;
+    input_batch.swap(m_InputBatch);
+
+    if (m_ServerWindowHandle != nullptr)
+    {
+        bool is_batch_sent = false;
+
+        //Single entries are cheaper as posted message, older servers only take them that way
+        if ( (input_batch.size() > 1) && (m_ServerAPIVersion >= k_lDPBrowserAPIVersionInputBatch) )
+        {
+            const uint32_t batch_id = ++m_InputBatchID;
+
+            for (DPBrowserIPCInputBatchEntry& entry : input_batch)
+            {
+                entry.BatchID = batch_id;
+            }
+
+            //The server only stores the entries, the posted command applies them after the commands posted before it. Same as with dpbrowser_ipccmd_keyboard_string
+            is_batch_sent = SendDataMessage(dpbrowser_ipcstr_input_batch, input_batch.data(), input_batch.size() * sizeof(DPBrowserIPCInputBatchEntry), k_DPBrowserAPIClientInputBatchTimeoutMs);
+
+            if (is_batch_sent)
+            {
+                PostCommandMessageDirect(dpbrowser_ipccmd_input_batch, batch_id);
+            }
+        }
+
+        //Post entries individually if they weren't sent as batch, including when the server didn't take it in time
+        if (!is_batch_sent)
+        {
+            for (const DPBrowserIPCInputBatchEntry& entry : input_batch)
+            {
+                PostTargetedCommandMessageDirect(entry.OverlayHandle, (DPBrowserICPCommandID)entry.CommandID, (LPARAM)entry.LParam);
+            }
+        }
+    }
+
+    //Keep the allocation around for the next frame
+    if (m_InputBatch.empty())
+    {
+        input_batch.clear();
+        m_InputBatch.swap(input_batch);
+    }
 }
 
 void DPBrowserAPIClient::DPBrowser_MouseLeave(vr::VROverlayHandle_t overlay_handle)
@@ -521,7 +709,7 @@ void DPBrowserAPIClient::DPBrowser_MouseLeave(vr::VROverlayHandle_t overlay_hand
     if (!IsServerRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_mouse_leave, overlay_handle);
+    PostCommandMessage(dpbrowser_ipccmd_mouse_leave, overlay_handle);
 }
 
 void DPBrowserAPIClient::DPBrowser_MouseDown(vr::VROverlayHandle_t overlay_handle, vr::EVRMouseButton button)
@@ -529,8 +717,7 @@ void DPBrowserAPIClient::DPBrowser_MouseDown(vr::VROverlayHandle_t overlay_handl
     if (!IsServerRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_mouse_down, button);
+    QueueInput(overlay_handle, dpbrowser_ipccmd_mouse_down, button);
 }
 
 void DPBrowserAPIClient::DPBrowser_MouseUp(vr::VROverlayHandle_t overlay_handle, vr::EVRMouseButton button)
@@ -538,8 +725,7 @@ void DPBrowserAPIClient::DPBrowser_MouseUp(vr::VROverlayHandle_t overlay_handle,
     if (!IsServerRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_mouse_up, button);
+    QueueInput(overlay_handle, dpbrowser_ipccmd_mouse_up, button);
 }
 
 void DPBrowserAPIClient::DPBrowser_Scroll(vr::VROverlayHandle_t overlay_handle, float x_delta, float y_delta)
@@ -551,8 +737,7 @@ void DPBrowserAPIClient::DPBrowser_Scroll(vr::VROverlayHandle_t overlay_handle,
     DWORD x_delta_uint = pun_cast<DWORD, float>(x_delta);
     DWORD y_delta_uint = pun_cast<DWORD, float>(y_delta);
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_scroll, MAKEQWORD(x_delta_uint, y_delta_uint));
+    QueueInput(overlay_handle, dpbrowser_ipccmd_scroll, MAKEQWORD(x_delta_uint, y_delta_uint));
 }
 
 void DPBrowserAPIClient::DPBrowser_KeyboardSetKeyState(vr::VROverlayHandle_t overlay_handle, DPBrowserIPCKeyboardKeystateFlags flags, unsigned char keycode)
@@ -560,8 +745,7 @@ void DPBrowserAPIClient::DPBrowser_KeyboardSetKeyState(vr::VROverlayHandle_t ove
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_keyboard_vkey, MAKELPARAM(flags, keycode));
+    QueueInput(overlay_handle, dpbrowser_ipccmd_keyboard_vkey, MAKELPARAM(flags, keycode));
 }
 
 void DPBrowserAPIClient::DPBrowser_KeyboardToggleKey(vr::VROverlayHandle_t overlay_handle, unsigned char keycode)
@@ -569,8 +753,7 @@ void DPBrowserAPIClient::DPBrowser_KeyboardToggleKey(vr::VROverlayHandle_t overl
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_keyboard_vkey_toggle, keycode);
+    QueueInput(overlay_handle, dpbrowser_ipccmd_keyboard_vkey_toggle, keycode);
 }
 
 void DPBrowserAPIClient::DPBrowser_KeyboardTypeWChar(vr::VROverlayHandle_t overlay_handle, wchar_t wchar, bool down)
@@ -578,14 +761,13 @@ void DPBrowserAPIClient::DPBrowser_KeyboardTypeWChar(vr::VROverlayHandle_t overl
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_set_overlay_target, overlay_handle);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_keyboard_wchar, MAKELPARAM(wchar, down));
+    QueueInput(overlay_handle, dpbrowser_ipccmd_keyboard_wchar, MAKELPARAM(wchar, down));
 }
 
 void DPBrowserAPIClient::DPBrowser_KeyboardTypeString(vr::VROverlayHandle_t overlay_handle, const std::string& str)
 {
     SendStringMessage(dpbrowser_ipcstr_keyboard_string, str);
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_keyboard_string, overlay_handle);
+    PostCommandMessage(dpbrowser_ipccmd_keyboard_string, overlay_handle);
 }
 
 void DPBrowserAPIClient::DPBrowser_GoBack(vr::VROverlayHandle_t overlay_handle)
@@ -593,7 +775,7 @@ void DPBrowserAPIClient::DPBrowser_GoBack(vr::VROverlayHandle_t overlay_handle)
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_go_back, overlay_handle);
+    PostCommandMessage(dpbrowser_ipccmd_go_back, overlay_handle);
 }
 
 void DPBrowserAPIClient::DPBrowser_GoForward(vr::VROverlayHandle_t overlay_handle)
@@ -601,7 +783,7 @@ void DPBrowserAPIClient::DPBrowser_GoForward(vr::VROverlayHandle_t overlay_handl
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_go_forward, overlay_handle);
+    PostCommandMessage(dpbrowser_ipccmd_go_forward, overlay_handle);
 }
 
 void DPBrowserAPIClient::DPBrowser_Refresh(vr::VROverlayHandle_t overlay_handle)
@@ -609,7 +791,7 @@ void DPBrowserAPIClient::DPBrowser_Refresh(vr::VROverlayHandle_t overlay_handle)
     if (!LaunchServerIfNotRunning())
         return;
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_refresh, overlay_handle);
+    PostCommandMessage(dpbrowser_ipccmd_refresh, overlay_handle);
 }
 
 void DPBrowserAPIClient::DPBrowser_GlobalSetFPS(int fps)
@@ -620,7 +802,7 @@ void DPBrowserAPIClient::DPBrowser_GlobalSetFPS(int fps)
         return;
     }
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_global_set_fps, fps);
+    PostCommandMessage(dpbrowser_ipccmd_global_set_fps, fps);
 }
 
 void DPBrowserAPIClient::DPBrowser_ContentBlockSetEnabled(bool enable)
@@ -631,7 +813,7 @@ void DPBrowserAPIClient::DPBrowser_ContentBlockSetEnabled(bool enable)
         return;
     }
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_cblock_set_enabled, enable);
+    PostCommandMessage(dpbrowser_ipccmd_cblock_set_enabled, enable);
 }
 
 void DPBrowserAPIClient::DPBrowser_ErrorPageSetStrings(const std::string& title, const std::string& heading, const std::string& message)
@@ -646,5 +828,5 @@ void DPBrowserAPIClient::DPBrowser_ErrorPageSetStrings(const std::string& title,
     SendStringMessage(dpbrowser_ipcstr_tstr_error_heading, heading);
     SendStringMessage(dpbrowser_ipcstr_tstr_error_message, message);
 
-    ::PostMessage(m_ServerWindowHandle, m_Win32MessageID, dpbrowser_ipccmd_error_set_strings, 0);
+    PostCommandMessage(dpbrowser_ipccmd_error_set_strings, 0);
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "DPBrowserAPI.h"
 
 class DPBrowserAPIClient : public DPBrowserAPI
@@ -8,6 +10,7 @@ class DPBrowserAPIClient : public DPBrowserAPI
         bool m_IsServerAvailable = false;
         bool m_HasServerAPIMismatch = false;
         HWND m_ServerWindowHandle = nullptr;
+        int m_ServerAPIVersion = 0;
         UINT m_Win32MessageID = 0;
 
         std::string m_IPCStrings[dpbrowser_ipcstr_MAX - dpbrowser_ipcstr_MIN];
@@ -18,10 +21,21 @@ class DPBrowserAPIClient : public DPBrowserAPI
         int m_PendingSettingContentBlockEnabled = -1;
         bool m_PendingTranslationStrings = true;
 
+        //Input is collected and sent once per frame as a single batch, see FlushQueuedCommands()
+        std::vector<DPBrowserIPCInputBatchEntry> m_InputBatch;
+        uint32_t m_InputBatchID = 0;
+
         bool LaunchServerIfNotRunning();                        //Should be called and checked for in most API implementations, also makes sure m_ServerWindowHandle is updated
         bool IsServerRunning();                                 //Also makes sure m_ServerWindowHandle is updated
+        bool CheckServerAPIVersion();                           //Queries the API version of m_ServerWindowHandle, handles mismatches and returns false on them
         void ApplyPendingSettings();
         void SendStringMessage(DPBrowserICPStringID str_id, const std::string& str) const;
+        bool SendDataMessage(DPBrowserICPStringID str_id, const void* data, size_t size, UINT timeout_ms = 0) const; //timeout_ms 0 waits until handled, otherwise gives up after it and returns false
+        void PostCommandMessage(DPBrowserICPCommandID command_id, LPARAM l_param);
+        void PostCommandMessageDirect(DPBrowserICPCommandID command_id, LPARAM l_param) const;
+        void PostTargetedCommandMessage(vr::VROverlayHandle_t overlay_handle, DPBrowserICPCommandID command_id, LPARAM l_param);
+        void PostTargetedCommandMessageDirect(vr::VROverlayHandle_t overlay_handle, DPBrowserICPCommandID command_id, LPARAM l_param) const; //Compound command or set_overlay_target + command
+        void QueueInput(vr::VROverlayHandle_t overlay_handle, DPBrowserICPCommandID command_id, LPARAM l_param);
 
         std::string& GetIPCString(DPBrowserICPStringID str_id); //Abstracts the minimum string ID away when acccessing m_IPCStrings
 
@@ -35,6 +49,7 @@ class DPBrowserAPIClient : public DPBrowserAPI
         UINT GetRegisteredMessageID() const;
 
         void HandleIPCMessage(const MSG& msg);
+        void FlushQueuedCommands();         //Should be called once per frame
 
         //DPBrowserAPI:
         virtual void DPBrowser_StartBrowser(vr::VROverlayHandle_t overlay_handle, const std::string& url, bool use_transparent_background) override;
@@ -2,7 +2,8 @@
 
 #pragma once
 
-#include "Util.h"
+#include <cstdint>
+
 #include "Vectors.h"
 
 // 2D axis aligned bounding-box
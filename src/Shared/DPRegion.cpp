@@ -0,0 +1,329 @@
+#include "DPRegion.h"
+
+#include <algorithm>
+#include <climits>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+static int64_t DPRegionGetArea(const DPRect& rect)
+{
+    return (int64_t)rect.GetWidth() * rect.GetHeight();
+}
+
+static int64_t DPRegionGetIntersectionArea(const DPRect& a, const DPRect& b)
+{
+    if (!a.Overlaps(b))
+        return 0;
+
+    DPRect rect_intersection = a;
+    rect_intersection.ClipWith(b);
+
+    return DPRegionGetArea(rect_intersection);
+}
+
+//Returns how much area the bounding rect of a and b covers on top of what a and b already cover
+static int64_t DPRegionGetMergeWaste(const DPRect& a, const DPRect& b, int64_t& covered_area)
+{
+    DPRect rect_union = a;
+    rect_union.Add(b);
+
+    covered_area = DPRegionGetArea(a) + DPRegionGetArea(b) - DPRegionGetIntersectionArea(a, b);
+
+    return DPRegionGetArea(rect_union) - covered_area;
+}
+
+DPRegion::DPRegion() : m_RectCount(0)
+{
+}
+
+DPRegion::DPRegion(const DPRect& rect) : m_RectCount(0)
+{
+    Add(rect);
+}
+
+void DPRegion::RemoveRect(int id)
+{
+    m_Rects[id] = m_Rects[m_RectCount - 1];
+    m_RectCount--;
+}
+
+void DPRegion::Add(const DPRect& rect)
+{
+    if ( (rect.GetWidth() <= 0) || (rect.GetHeight() <= 0) )
+        return;
+
+    DPRect rect_new = rect;
+
+    //Merge with existing rects while that adds less than a quarter of the covered area. Merged rects may reach other ones, so repeat until nothing is merged anymore
+    for (;;)
+    {
+        int merge_id = -1;
+        int64_t merge_waste_min = INT64_MAX;
+
+        for (int i = 0; i < m_RectCount; ++i)
+        {
+            if (m_Rects[i].Contains(rect_new))
+                return;
+
+            int64_t covered_area = 0;
+            const int64_t waste = DPRegionGetMergeWaste(m_Rects[i], rect_new, covered_area);
+
+            if ( (waste <= covered_area / 4) && (waste < merge_waste_min) )
+            {
+                merge_id = i;
+                merge_waste_min = waste;
+            }
+        }
+
+        if (merge_id == -1)
+            break;
+
+        rect_new.Add(m_Rects[merge_id]);
+        RemoveRect(merge_id);
+    }
+
+    if (m_RectCount < k_DPRegionRectMax)
+    {
+        m_Rects[m_RectCount] = rect_new;
+        m_RectCount++;
+        return;
+    }
+
+    //No space left, merge the pair that wastes the least area. The new rect is at index k_DPRegionRectMax here
+    auto get_rect = [&](int id) -> const DPRect& { return (id < m_RectCount) ? m_Rects[id] : rect_new; };
+
+    int merge_id_a = 0, merge_id_b = 1;
+    int64_t merge_waste_min = INT64_MAX;
+
+    for (int a = 0; a < m_RectCount; ++a)
+    {
+        for (int b = a + 1; b <= m_RectCount; ++b)
+        {
+            int64_t covered_area = 0;
+            const int64_t waste = DPRegionGetMergeWaste(get_rect(a), get_rect(b), covered_area);
+
+            if (waste < merge_waste_min)
+            {
+                merge_id_a = a;
+                merge_id_b = b;
+                merge_waste_min = waste;
+            }
+        }
+    }
+
+    DPRect rect_merged = get_rect(merge_id_a);
+    rect_merged.Add(get_rect(merge_id_b));
+
+    //Remove the higher index first so the other one isn't moved by it
+    if (merge_id_b < m_RectCount)
+    {
+        RemoveRect(merge_id_b);
+        RemoveRect(merge_id_a);
+
+        //Didn't merge with anything above, so it can go in as is
+        m_Rects[m_RectCount] = rect_new;
+        m_RectCount++;
+    }
+    else
+    {
+        RemoveRect(merge_id_a);
+    }
+
+    //There's space for it now, but it may also be mergeable with other rects
+    Add(rect_merged);
+}
+
+void DPRegion::Add(const DPRegion& region)
+{
+    for (const DPRect& rect : region)
+    {
+        Add(rect);
+    }
+}
+
+void DPRegion::Clear()
+{
+    m_RectCount = 0;
+}
+
+void DPRegion::ClipWith(const DPRect& rect)
+{
+    for (int i = 0; i < m_RectCount;)
+    {
+        m_Rects[i].ClipWithFull(rect);
+
+        if ( (m_Rects[i].GetWidth() <= 0) || (m_Rects[i].GetHeight() <= 0) )
+        {
+            RemoveRect(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+bool DPRegion::IsEmpty() const
+{
+    return (m_RectCount == 0);
+}
+
+bool DPRegion::Contains(const DPRect& rect) const
+{
+    return std::any_of(begin(), end(), [&](const DPRect& region_rect){ return region_rect.Contains(rect); });
+}
+
+bool DPRegion::Overlaps(const DPRect& rect) const
+{
+    return std::any_of(begin(), end(), [&](const DPRect& region_rect){ return region_rect.Overlaps(rect); });
+}
+
+DPRect DPRegion::GetBounds() const
+{
+    if (m_RectCount == 0)
+        return DPRect();
+
+    DPRect rect_bounds = m_Rects[0];
+
+    for (int i = 1; i < m_RectCount; ++i)
+    {
+        rect_bounds.Add(m_Rects[i]);
+    }
+
+    return rect_bounds;
+}
+
+int DPRegion::GetRectCount() const
+{
+    return m_RectCount;
+}
+
+const DPRect& DPRegion::GetRect(int id) const
+{
+    return m_Rects[id];
+}
+
+bool DPRegion::RunBenchmark(const char* process_name)
+{
+    std::ofstream file(std::string(process_name) + "_dirty_region_benchmark.txt", std::ios::trunc);
+
+    if (!file.good())
+        return false;
+
+    //Patterns on a 3840x2160 desktop, each producing the rectangles of one frame
+    const DPRect rect_desktop(0, 0, 3840, 2160);
+    const int frame_count = 20000;
+    std::mt19937 rng(1234);
+
+    auto random_rect = [&](int size_min, int size_max) -> DPRect
+    {
+        std::uniform_int_distribution<int> dist_size(size_min, size_max);
+        const int width  = dist_size(rng);
+        const int height = dist_size(rng);
+        const int x = std::uniform_int_distribution<int>(0, rect_desktop.GetWidth()  - width)(rng);
+        const int y = std::uniform_int_distribution<int>(0, rect_desktop.GetHeight() - height)(rng);
+
+        return DPRect(x, y, x + width, y + height);
+    };
+
+    struct Pattern
+    {
+        const char* Name;
+        std::function<void(int, std::vector<DPRect>&)> GetFrameRects;
+    };
+
+    const Pattern patterns[] =
+    {
+        {"Typing", [&](int frame, std::vector<DPRect>& rects)
+                   {
+                       //Text cursor moving along a line and a clock in the corner
+                       const int x = 200 + (frame % 400) * 8;
+                       rects.emplace_back(x, 300, x + 16, 316);
+                       rects.emplace_back(3700, 2120, 3800, 2150);
+                   }},
+        {"Scrolling", [&](int, std::vector<DPRect>& rects)
+                   {
+                       //Adjacent stripes of a scrolling window
+                       for (int i = 0; i < 32; ++i)
+                       {
+                           rects.emplace_back(400, 200 + i * 40, 2400, 240 + i * 40);
+                       }
+                   }},
+        {"Scattered", [&](int, std::vector<DPRect>& rects)
+                   {
+                       for (int i = 0; i < 64; ++i)
+                       {
+                           rects.push_back(random_rect(8, 64));
+                       }
+                   }},
+        {"Large", [&](int, std::vector<DPRect>& rects)
+                   {
+                       for (int i = 0; i < 16; ++i)
+                       {
+                           rects.push_back(random_rect(64, 800));
+                       }
+                   }},
+    };
+
+    file << "Dirty region merging of " << process_name << ", " << k_DPRegionRectMax << " rectangles max, " << frame_count << " frames per pattern\n";
+    file << "Area is the total area of the region's rectangles relative to their bounding rectangle, which was used before\n\n";
+    file << std::setw(12) << "Pattern" << std::setw(14) << "Rects/frame" << std::setw(12) << "us/frame" << std::setw(14) << "Region rects" << std::setw(10) << "Area %"
+         << std::setw(10) << "Check" << "\n";
+    file << std::fixed << std::setprecision(2);
+
+    bool all_checks_passed = true;
+    std::vector<DPRect> frame_rects;
+
+    for (const Pattern& pattern : patterns)
+    {
+        uint64_t rect_count_total = 0, region_rect_count_total = 0;
+        double area_ratio_total = 0.0;
+        std::chrono::steady_clock::duration time_total(0);
+        bool check_passed = true;
+
+        for (int frame = 0; frame < frame_count; ++frame)
+        {
+            frame_rects.clear();
+            pattern.GetFrameRects(frame, frame_rects);
+
+            const auto start_time = std::chrono::steady_clock::now();
+
+            DPRegion region;
+            for (const DPRect& rect : frame_rects)
+            {
+                region.Add(rect);
+            }
+            region.ClipWith(rect_desktop);
+
+            time_total += std::chrono::steady_clock::now() - start_time;
+
+            //Every added rectangle has to end up inside one of the region's rectangles
+            check_passed &= std::all_of(frame_rects.begin(), frame_rects.end(), [&](const DPRect& rect){ return region.Contains(rect); });
+
+            int64_t region_area = 0;
+            for (const DPRect& rect : region)
+            {
+                region_area += DPRegionGetArea(rect);
+            }
+
+            rect_count_total        += frame_rects.size();
+            region_rect_count_total += region.GetRectCount();
+            area_ratio_total        += (double)region_area / std::max(DPRegionGetArea(region.GetBounds()), (int64_t)1);
+        }
+
+        const double time_us = std::chrono::duration<double, std::micro>(time_total).count();
+
+        file << std::setw(12) << pattern.Name << std::setw(14) << (double)rect_count_total / frame_count << std::setw(12) << time_us / frame_count
+             << std::setw(14) << (double)region_rect_count_total / frame_count << std::setw(10) << area_ratio_total * 100.0 / frame_count
+             << std::setw(10) << ((check_passed) ? "OK" : "FAILED") << "\n";
+
+        all_checks_passed &= check_passed;
+    }
+
+    return ( (all_checks_passed) && (file.good()) );
+}
@@ -0,0 +1,42 @@
+//Area made of a small number of rectangles, used for dirty regions where a single bounding rectangle would cover a lot of unchanged space
+//Added rectangles are merged with existing ones when that doesn't add much area they didn't already cover. Once the rectangle limit is reached, the pair wasting the least area gets merged
+//The rectangles may overlap. With enough scattered changes, the region ends up as a few large rectangles, at worst the bounding rectangle of everything added
+//Only depends on DPRect.h and the standard library, so it doesn't pull in windows.h or Direct3D headers
+
+#pragma once
+
+#include "DPRect.h"
+
+static const int k_DPRegionRectMax = 8;
+
+class DPRegion
+{
+    private:
+        DPRect m_Rects[k_DPRegionRectMax];
+        int m_RectCount;
+
+        void RemoveRect(int id);
+
+    public:
+        DPRegion();
+        DPRegion(const DPRect& rect);
+
+        void Add(const DPRect& rect);               //Ignores empty and inverted rectangles
+        void Add(const DPRegion& region);
+        void Clear();
+        void ClipWith(const DPRect& rect);          //Clips all rectangles to rect, removing those that end up empty
+
+        bool IsEmpty() const;
+        bool Contains(const DPRect& rect) const;    //True if a single rectangle of the region contains rect
+        bool Overlaps(const DPRect& rect) const;
+        DPRect GetBounds() const;                   //Returns an empty rect at 0, 0 if the region is empty
+        int GetRectCount() const;
+        const DPRect& GetRect(int id) const;
+
+        const DPRect* begin() const { return m_Rects; }
+        const DPRect* end()   const { return m_Rects + m_RectCount; }
+
+        //Adds synthetic dirty rectangle patterns frame by frame, checks that every added rectangle is covered and writes timings and resulting region sizes
+        //to "<process_name>_dirty_region_benchmark.txt". Returns false if writing failed or a check didn't pass
+        static bool RunBenchmark(const char* process_name);
+};
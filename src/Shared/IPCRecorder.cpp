@@ -0,0 +1,323 @@
+#include "IPCRecorder.h"
+
+#include <map>
+#include <algorithm>
+#include <tuple>
+#include <iomanip>
+#include <iterator>
+#include <cstring>
+
+#include "InterprocessMessaging.h"
+#include "IPCStats.h"
+#include "DPBrowserAPIClient.h"
+
+static IPCRecorder g_IPCRecorder;
+
+static const uint32_t k_IPCRecorderBinaryMagic   = 0x43525044;    //"DPRC"
+static const uint32_t k_IPCRecorderBinaryVersion = 1;
+
+enum IPCRecorderRecordType : uint8_t
+{
+    ipcrec_message,             //Registered IPC message, id is IPCMsgID
+    ipcrec_copydata,            //WM_COPYDATA, id is the data ID and data follows the record
+    ipcrec_browser              //DPBrowserAPI message
+};
+
+//Header of every record
+struct IPCRecorderRecord
+{
+    int64_t TimeUs;             //Microseconds since recording start
+    uint64_t WParam;
+    int64_t LParam;
+    uint64_t ID;
+    uint32_t DataSize;
+    uint8_t Type;
+};
+
+template <typename T>
+static void IPCRecorderWriteValue(std::ofstream& file, const T& value)
+{
+    file.write((const char*)&value, sizeof(T));
+}
+
+template <typename T>
+static bool IPCRecorderReadValue(const std::string& str, size_t& pos, T& value)
+{
+    if (str.size() - pos < sizeof(T))
+        return false;
+
+    memcpy(&value, str.data() + pos, sizeof(T));
+    pos += sizeof(T);
+
+    return true;
+}
+
+static std::string IPCRecorderGetRowName(uint8_t type, uint64_t id)
+{
+    switch (type)
+    {
+        case ipcrec_message:
+        {
+            switch (id)
+            {
+                case ipcmsg_action:          return "Action";
+                case ipcmsg_set_config:      return "Config";
+                case ipcmsg_elevated_action: return "ElevatedAction";
+                default:                     return "Message";
+            }
+        }
+        case ipcrec_copydata: return "CopyData";
+        case ipcrec_browser:  return "Browser";
+        default:              return "Unknown";
+    }
+}
+
+IPCRecorder::Scope::Scope(const MSG& msg, bool do_record) : m_IsActive(IPCRecorder::Get().IsRecording())
+{
+    if (m_IsActive)
+    {
+        IPCRecorder& recorder = IPCRecorder::Get();
+
+        if ( (do_record) && (recorder.m_HandlerDepth == 0) )
+        {
+            recorder.Record(msg);
+        }
+
+        recorder.m_HandlerDepth++;
+    }
+}
+
+IPCRecorder::Scope::~Scope()
+{
+    if (m_IsActive)
+    {
+        IPCRecorder::Get().m_HandlerDepth--;
+    }
+}
+
+IPCRecorder::IPCRecorder() : m_StartTimestamp(0), m_HandlerDepth(0)
+{
+}
+
+IPCRecorder& IPCRecorder::Get()
+{
+    return g_IPCRecorder;
+}
+
+bool IPCRecorder::StartRecording(const char* process_name)
+{
+    m_File.open(std::string(process_name) + "_ipc_recording.bin", std::ios::binary | std::ios::trunc);
+
+    if (!m_File.good())
+    {
+        m_File.close();
+        return false;
+    }
+
+    IPCRecorderWriteValue(m_File, k_IPCRecorderBinaryMagic);
+    IPCRecorderWriteValue(m_File, k_IPCRecorderBinaryVersion);
+
+    m_StartTimestamp = IPCStats::GetTimestamp();
+
+    return true;
+}
+
+void IPCRecorder::StopRecording()
+{
+    m_File.close();
+}
+
+bool IPCRecorder::IsRecording() const
+{
+    return m_File.is_open();
+}
+
+void IPCRecorder::Record(const MSG& msg)
+{
+    if (!IsRecording())
+        return;
+
+    IPCRecorderRecord record = {0};
+    const COPYDATASTRUCT* pcds = nullptr;
+
+    if (msg.message == WM_COPYDATA)
+    {
+        pcds = (const COPYDATASTRUCT*)msg.lParam;
+
+        record.Type     = ipcrec_copydata;
+        record.ID       = pcds->dwData;
+        record.DataSize = pcds->cbData;
+    }
+    else if (msg.message == DPBrowserAPIClient::Get().GetRegisteredMessageID())
+    {
+        record.Type   = ipcrec_browser;
+        record.LParam = msg.lParam;
+    }
+    else
+    {
+        const IPCMsgID msgid = IPCManager::Get().GetIPCMessageID(msg.message);
+
+        //Doorbells only announce other messages, which are recorded on their own
+        if ( (msgid == ipcmsg_MAX) || (msgid == ipcmsg_ring_doorbell) )
+            return;
+
+        record.Type   = ipcrec_message;
+        record.ID     = msgid;
+        record.LParam = msg.lParam;
+    }
+
+    record.TimeUs = (int64_t)IPCStats::Get().GetMicrosecondsSince(m_StartTimestamp);
+    record.WParam = msg.wParam;
+
+    IPCRecorderWriteValue(m_File, record.TimeUs);
+    IPCRecorderWriteValue(m_File, record.WParam);
+    IPCRecorderWriteValue(m_File, record.LParam);
+    IPCRecorderWriteValue(m_File, record.ID);
+    IPCRecorderWriteValue(m_File, record.DataSize);
+    IPCRecorderWriteValue(m_File, record.Type);
+
+    if ( (pcds != nullptr) && (pcds->cbData != 0) )
+    {
+        m_File.write((const char*)pcds->lpData, pcds->cbData);
+    }
+}
+
+bool IPCRecorder::Replay(const char* path, const char* process_name, const std::function<void(const MSG&)>& handler)
+{
+    std::ifstream file_in(path, std::ios::binary);
+
+    if (!file_in.good())
+        return false;
+
+    const std::string str((std::istreambuf_iterator<char>(file_in)), std::istreambuf_iterator<char>());
+
+    size_t pos = 0;
+    uint32_t magic = 0, version = 0;
+
+    if ( (!IPCRecorderReadValue(str, pos, magic)) || (!IPCRecorderReadValue(str, pos, version)) || (magic != k_IPCRecorderBinaryMagic) || (version != k_IPCRecorderBinaryVersion) )
+        return false;
+
+    struct ReplayRow
+    {
+        uint64_t Count = 0;
+        int64_t TicksTotal = 0;
+        int64_t TicksMax = 0;
+    };
+
+    //Rows are per type, IPCMsgID and wParam, or data ID for WM_COPYDATA
+    std::map<std::tuple<uint8_t, uint64_t, uint64_t>, ReplayRow> rows;
+    ReplayRow total;
+    int64_t recorded_time_us = 0;
+
+    LARGE_INTEGER frequency;
+    ::QueryPerformanceFrequency(&frequency);
+
+    while (pos < str.size())
+    {
+        IPCRecorderRecord record = {0};
+
+        if ( (!IPCRecorderReadValue(str, pos, record.TimeUs)) || (!IPCRecorderReadValue(str, pos, record.WParam)) || (!IPCRecorderReadValue(str, pos, record.LParam)) ||
+             (!IPCRecorderReadValue(str, pos, record.ID))     || (!IPCRecorderReadValue(str, pos, record.DataSize)) || (!IPCRecorderReadValue(str, pos, record.Type)) ||
+             (str.size() - pos < record.DataSize) )
+        {
+            //Recording may have been cut off if the process didn't exit cleanly, replay what we got
+            break;
+        }
+
+        MSG msg = {0};
+        COPYDATASTRUCT cds;
+        uint64_t row_id = record.ID;
+
+        switch (record.Type)
+        {
+            case ipcrec_message:
+            {
+                if (record.ID >= ipcmsg_MAX)
+                    continue;
+
+                msg.message = IPCManager::Get().GetWin32MessageID((IPCMsgID)record.ID);
+                break;
+            }
+            case ipcrec_copydata:
+            {
+                cds.dwData = (ULONG_PTR)record.ID;
+                cds.cbData = record.DataSize;
+                cds.lpData = (void*)(str.data() + pos);
+
+                msg.message = WM_COPYDATA;
+                msg.lParam  = (LPARAM)&cds;
+                break;
+            }
+            case ipcrec_browser:
+            {
+                msg.message = DPBrowserAPIClient::Get().GetRegisteredMessageID();
+                break;
+            }
+            default:
+            {
+                pos += record.DataSize;
+                continue;
+            }
+        }
+
+        msg.wParam = (WPARAM)record.WParam;
+
+        if (record.Type != ipcrec_copydata)
+        {
+            msg.lParam = (LPARAM)record.LParam;
+            row_id     = record.WParam;
+
+            //Compound browser commands carry their arguments in wParam as well, only use the command ID
+            if ( (record.Type == ipcrec_browser) && (DPBrowserAPIIsCompound(msg.wParam)) )
+            {
+                row_id = DPBrowserAPIGetCompoundCommand(msg.wParam);
+            }
+        }
+
+        LARGE_INTEGER ticks_start, ticks_end;
+        ::QueryPerformanceCounter(&ticks_start);
+
+        handler(msg);
+
+        ::QueryPerformanceCounter(&ticks_end);
+
+        const int64_t ticks = ticks_end.QuadPart - ticks_start.QuadPart;
+
+        for (ReplayRow* row : {&rows[std::make_tuple(record.Type, record.ID, row_id)], &total})
+        {
+            row->Count++;
+            row->TicksTotal += ticks;
+            row->TicksMax = std::max(row->TicksMax, ticks);
+        }
+
+        recorded_time_us = record.TimeUs;
+        pos += record.DataSize;
+    }
+
+    std::ofstream file(std::string(process_name) + "_ipc_replay.txt", std::ios::trunc);
+
+    if (!file.good())
+        return false;
+
+    auto ticks_to_ms = [&](int64_t ticks) { return (double)ticks * 1000.0 / (double)frequency.QuadPart; };
+
+    file << "IPC replay of " << path << " in " << process_name << "\n";
+    file << "Recorded span: " << recorded_time_us / 1000 << " ms, " << total.Count << " messages\n\n";
+
+    file << std::left << std::setw(16) << "Type" << std::right << std::setw(8) << "ID" << std::setw(10) << "Count"
+         << std::setw(14) << "Total ms" << std::setw(12) << "Avg ms" << std::setw(12) << "Max ms" << "\n";
+    file << std::fixed << std::setprecision(4);
+
+    for (const auto& row : rows)
+    {
+        file << std::left << std::setw(16) << IPCRecorderGetRowName(std::get<0>(row.first), std::get<1>(row.first)) << std::right << std::setw(8) << std::get<2>(row.first)
+             << std::setw(10) << row.second.Count << std::setw(14) << ticks_to_ms(row.second.TicksTotal)
+             << std::setw(12) << ticks_to_ms(row.second.TicksTotal) / row.second.Count << std::setw(12) << ticks_to_ms(row.second.TicksMax) << "\n";
+    }
+
+    file << std::left << std::setw(16) << "Total" << std::right << std::setw(8) << "" << std::setw(10) << total.Count
+         << std::setw(14) << ticks_to_ms(total.TicksTotal) << std::setw(12) << ((total.Count != 0) ? ticks_to_ms(total.TicksTotal) / total.Count : 0.0)
+         << std::setw(12) << ticks_to_ms(total.TicksMax) << "\n";
+
+    return file.good();
+}
@@ -0,0 +1,45 @@
+//Records the IPC messages handled by a process to a file and replays them later, for benchmarking the message handlers with a reproducible message stream
+//Recording is enabled with the -IPCRecord command line argument and writes "<process_name>_ipc_recording.bin" to the working directory
+//Replaying is done with -IPCReplay <path>, which feeds the recorded messages to the process' handler after startup, writes "<process_name>_ipc_replay.txt" and exits
+//Replays are meant to be run without the other Desktop+ processes, so messages sent in response don't go anywhere. They're as fast as possible and don't keep the recorded timing
+//Messages are recorded by IPCMsgID instead of window message ID. Nested messages (e.g. ConfigDelta entries replayed while handling another message) are not recorded
+
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <functional>
+#define NOMINMAX
+#include <windows.h>
+
+class IPCRecorder
+{
+    private:
+        std::ofstream m_File;
+        int64_t m_StartTimestamp;
+        int m_HandlerDepth;
+
+    public:
+        //Put at the start of message handlers. Records the message unless it's handled while handling another recorded message or do_record is false
+        class Scope
+        {
+            private:
+                bool m_IsActive;
+
+            public:
+                Scope(const MSG& msg, bool do_record = true);
+                ~Scope();
+        };
+
+        IPCRecorder();
+        static IPCRecorder& Get();
+
+        bool StartRecording(const char* process_name);
+        void StopRecording();
+        bool IsRecording() const;
+
+        void Record(const MSG& msg);
+
+        //Calls handler for each message in the recording and writes the time spent in it to "<process_name>_ipc_replay.txt". Returns false if the recording couldn't be read
+        static bool Replay(const char* path, const char* process_name, const std::function<void(const MSG&)>& handler);
+};
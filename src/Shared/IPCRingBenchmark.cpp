@@ -0,0 +1,187 @@
+#include "IPCRingBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "IPCSharedMemory.h"
+#include "IPCRingBuffer.h"
+
+static const uint32_t k_IPCRingBenchmarkCheckCapacity = 4096;
+
+//Same layout as the record headers written by IPCRingBuffer::Push()
+struct IPCRingBenchmarkRecordHeader
+{
+    uint32_t Size;
+    uint32_t Type;
+};
+
+//Memory block for a ring buffer used by the checks, aligned like a shared memory mapping would be
+struct alignas(64) IPCRingBenchmarkCheckMemory
+{
+    uint8_t Data[sizeof(IPCRingBufferHeader) + k_IPCRingBenchmarkCheckCapacity];
+};
+
+//Puts a record header at offset in the data area, which is where the consumer reads next, and moves the write position to write_pos_offset bytes after it
+//Then checks that Peek() drops it
+static bool IPCRingBenchmarkCheckMalformedRecord(std::ostream& out, const char* name, uint32_t offset, uint32_t size, uint32_t type, uint64_t write_pos_offset)
+{
+    std::unique_ptr<IPCRingBenchmarkCheckMemory> memory = std::make_unique<IPCRingBenchmarkCheckMemory>();
+    IPCRingBuffer ring;
+
+    if (!ring.Attach(memory->Data, sizeof(memory->Data), k_IPCRingBenchmarkCheckCapacity, true))
+        return false;
+
+    //Positions never wrap, so start one lap in to not have them at 0
+    IPCRingBufferHeader* header = (IPCRingBufferHeader*)memory->Data;
+    const uint64_t read_pos = k_IPCRingBenchmarkCheckCapacity + offset;
+    header->ReadPos.store(read_pos, std::memory_order_relaxed);
+    header->WritePos.store(read_pos, std::memory_order_relaxed);
+    ring.Discard();
+
+    const IPCRingBenchmarkRecordHeader record_header = {size, type};
+    memcpy(memory->Data + sizeof(IPCRingBufferHeader) + offset, &record_header, sizeof(record_header));
+    header->WritePos.store(read_pos + write_pos_offset, std::memory_order_release);
+
+    uint32_t peek_type = 0, peek_size = 0;
+    const bool is_dropped = ( (ring.Peek(peek_type, peek_size) == nullptr) && (ring.GetUsedSize() == 0) );
+
+    out << std::setw(40) << name << std::setw(10) << ((is_dropped) ? "OK" : "FAILED");
+
+    if (!is_dropped)
+    {
+        out << " (returned size " << peek_size << ")";
+    }
+
+    out << "\n";
+
+    return is_dropped;
+}
+
+bool IPCRingBenchmark::Run(std::ostream& out, uint32_t capacity, const uint32_t* payload_sizes, size_t payload_size_count, size_t message_count)
+{
+    //Unique enough for concurrent runs, the block is removed again right after mapping on platforms where it would stay around
+    const std::string name = "DesktopPlus_IPCRingBenchmark_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    IPCSharedMemory shared_memory;
+    IPCRingBuffer ring_producer, ring_consumer;
+
+    const bool is_created = shared_memory.Create(name.c_str(), IPCRingBuffer::GetMemorySize(capacity));
+    IPCSharedMemory::Remove(name.c_str());
+
+    if (!is_created)
+        return false;
+
+    if ( (!ring_producer.Attach(shared_memory.GetData(), shared_memory.GetSize(), capacity, true)) ||
+         (!ring_consumer.Attach(shared_memory.GetData(), shared_memory.GetSize(), capacity, false)) )
+    {
+        return false;
+    }
+
+    const uint32_t payload_size_max = *std::max_element(payload_sizes, payload_sizes + payload_size_count);
+
+    if (payload_size_max > ring_producer.GetMaxRecordSize())
+        return false;
+
+    out << "Full is the number of times the producer found the ring buffer full and had to wait for the consumer\n\n";
+    out << std::setw(10) << "Payload" << std::setw(12) << "Messages" << std::setw(12) << "Time ms" << std::setw(14) << "Messages/s"
+        << std::setw(10) << "MB/s" << std::setw(12) << "Full" << "\n";
+    out << std::fixed << std::setprecision(1);
+
+    std::vector<char> payload(payload_size_max, 'x');
+
+    for (size_t i = 0; i < payload_size_count; ++i)
+    {
+        const uint32_t payload_size = payload_sizes[i];
+        uint64_t full_count = 0;
+        const auto start_time = std::chrono::steady_clock::now();
+
+        //Copies the payloads out like IPCManager::PullRingMessages() does
+        std::thread consumer_thread([&]()
+        {
+            std::vector<char> received_data(payload.size());
+            uint32_t type = 0, size = 0;
+            const void* data = nullptr;
+
+            for (size_t received_count = 0; received_count < message_count;)
+            {
+                if ((data = ring_consumer.Peek(type, size)) != nullptr)
+                {
+                    memcpy(received_data.data(), data, size);
+                    ring_consumer.Consume();
+                    ++received_count;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        for (size_t sent_count = 0; sent_count < message_count;)
+        {
+            if (ring_producer.Push(1, payload.data(), payload_size))
+            {
+                ++sent_count;
+            }
+            else
+            {
+                ++full_count;
+                std::this_thread::yield();
+            }
+        }
+
+        consumer_thread.join();
+
+        const double time_s = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count(), 0.000001);
+
+        out << std::setw(10) << payload_size << std::setw(12) << message_count << std::setw(12) << time_s * 1000.0 << std::setw(14) << message_count / time_s
+            << std::setw(10) << (message_count * payload_size) / time_s / (1024.0 * 1024.0) << std::setw(12) << full_count << "\n";
+    }
+
+    return out.good();
+}
+
+bool IPCRingBenchmark::RunChecks(std::ostream& out)
+{
+    const uint32_t type_padding = 0xFFFFFFFF;
+    const uint32_t capacity     = k_IPCRingBenchmarkCheckCapacity;
+    bool all_passed = true;
+
+    out << std::setw(40) << "Malformed record" << std::setw(10) << "Check" << "\n";
+
+    //Sizes which wrap around to a record size of 0 when rounded up in 32-bit
+    all_passed &= IPCRingBenchmarkCheckMalformedRecord(out, "Size 0xFFFFFFF1",                  0,             0xFFFFFFF1,   1,            64);
+    all_passed &= IPCRingBenchmarkCheckMalformedRecord(out, "Size 0xFFFFFFF8",                  0,             0xFFFFFFF8,   1,            64);
+    //Larger than anything the producer may push, but within the written data and the end of the buffer
+    all_passed &= IPCRingBenchmarkCheckMalformedRecord(out, "Size above max record size",       0,             capacity / 2, 1,            capacity);
+    //Extends past the written data
+    all_passed &= IPCRingBenchmarkCheckMalformedRecord(out, "Size past write position",         0,             100,          1,            16);
+    //Extends past the end of the buffer
+    all_passed &= IPCRingBenchmarkCheckMalformedRecord(out, "Size past end of buffer",          capacity - 64, 100,          1,            256);
+    //Padding records have to end exactly at the end of the buffer
+    all_passed &= IPCRingBenchmarkCheckMalformedRecord(out, "Padding not ending at buffer end", 0,             8,            type_padding, 64);
+    all_passed &= IPCRingBenchmarkCheckMalformedRecord(out, "Padding with wrapping size",       0,             0xFFFFFFF8,   type_padding, 64);
+    //Write position further ahead than the capacity allows
+    all_passed &= IPCRingBenchmarkCheckMalformedRecord(out, "Used size above capacity",         0,             8,            1,            capacity + 64);
+
+    //A valid record still has to come through
+    std::unique_ptr<IPCRingBenchmarkCheckMemory> memory = std::make_unique<IPCRingBenchmarkCheckMemory>();
+    IPCRingBuffer ring;
+    const char payload[] = "payload";
+    uint32_t type = 0, size = 0;
+    const void* data = nullptr;
+
+    const bool is_valid_passed = ( (ring.Attach(memory->Data, sizeof(memory->Data), capacity, true)) &&
+                                   (ring.Push(7, payload, sizeof(payload))) && ((data = ring.Peek(type, size)) != nullptr) &&
+                                   (type == 7) && (size == sizeof(payload)) && (memcmp(data, payload, sizeof(payload)) == 0) );
+
+    out << std::setw(40) << "Valid record" << std::setw(10) << ((is_valid_passed) ? "OK" : "FAILED") << "\n";
+    all_passed &= is_valid_passed;
+
+    return ( (all_passed) && (out.good()) );
+}
@@ -0,0 +1,19 @@
+//Throughput benchmark and malformed input checks for IPCRingBuffer
+//Only uses IPCSharedMemory, IPCRingBuffer and the standard library, so it builds and runs on other platforms as well (see src/IPCRingBenchmark for a standalone build)
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+
+class IPCRingBenchmark
+{
+    public:
+        //Pushes message_count records of each payload size through a shared memory ring buffer of the given capacity between two threads
+        //and writes the throughput to out. Returns false if the ring buffer couldn't be set up
+        static bool Run(std::ostream& out, uint32_t capacity, const uint32_t* payload_sizes, size_t payload_size_count, size_t message_count = 200000);
+        //Writes record headers a misbehaving producer could write and checks that the consumer drops them instead of returning them. Writes results to out
+        //Returns false if any check failed
+        static bool RunChecks(std::ostream& out);
+};
@@ -0,0 +1,228 @@
+#include "IPCRingBuffer.h"
+
+#include <new>
+#include <cstring>
+
+static const uint32_t k_IPCRingBufferMagic       = 0x52495044;    //"DPIR"
+static const uint32_t k_IPCRingBufferVersion     = 1;
+static const uint32_t k_IPCRingBufferTypePadding = 0xFFFFFFFF;    //Fills the rest of the buffer when a record doesn't fit before the end
+
+struct IPCRingBufferRecordHeader
+{
+    uint32_t Size;                                      //Payload size, not including header or alignment
+    uint32_t Type;
+};
+
+static uint64_t IPCRingBufferGetRecordSize(uint32_t payload_size)
+{
+    //Keep records 8-byte aligned so headers never straddle the end of the buffer. Stays 64-bit so sizes close to UINT32_MAX can't wrap around to 0
+    return (sizeof(IPCRingBufferRecordHeader) + (uint64_t)payload_size + 7) & ~7ull;
+}
+
+size_t IPCRingBuffer::GetMemorySize(uint32_t capacity)
+{
+    return sizeof(IPCRingBufferHeader) + capacity;
+}
+
+IPCRingBuffer::IPCRingBuffer() : m_Header(nullptr),
+                                 m_Data(nullptr),
+                                 m_Capacity(0),
+                                 m_PeekNextPos(0)
+{
+}
+
+bool IPCRingBuffer::Attach(void* memory, size_t memory_size, uint32_t capacity, bool initialize)
+{
+    Detach();
+
+    //Capacity needs to be a power of two and allow at least a few records
+    if ( (memory == nullptr) || (capacity < 64) || ((capacity & (capacity - 1)) != 0) || (memory_size < GetMemorySize(capacity)) )
+        return false;
+
+    IPCRingBufferHeader* header = (IPCRingBufferHeader*)memory;
+
+    if (initialize)
+    {
+        header = new (memory) IPCRingBufferHeader();
+        header->Version  = k_IPCRingBufferVersion;
+        header->Capacity = capacity;
+        header->Reserved = 0;
+        header->WritePos.store(0, std::memory_order_relaxed);
+        header->ReadPos.store(0, std::memory_order_relaxed);
+        header->NotifyPending.store(0, std::memory_order_relaxed);
+
+        //Magic is written last so a process opening the block while it's being set up doesn't consider it valid yet
+        std::atomic_thread_fence(std::memory_order_release);
+        header->Magic = k_IPCRingBufferMagic;
+    }
+    else
+    {
+        if ( (header->Magic != k_IPCRingBufferMagic) || (header->Version != k_IPCRingBufferVersion) || (header->Capacity != capacity) )
+            return false;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    m_Header   = header;
+    m_Data     = (uint8_t*)memory + sizeof(IPCRingBufferHeader);
+    m_Capacity = capacity;
+    m_PeekNextPos = m_Header->ReadPos.load(std::memory_order_relaxed);
+
+    return true;
+}
+
+void IPCRingBuffer::Detach()
+{
+    m_Header   = nullptr;
+    m_Data     = nullptr;
+    m_Capacity = 0;
+    m_PeekNextPos = 0;
+}
+
+bool IPCRingBuffer::IsAttached() const
+{
+    return (m_Header != nullptr);
+}
+
+uint32_t IPCRingBuffer::GetMaxRecordSize() const
+{
+    //Limit to half the capacity so a record always fits after waiting for the consumer, even if padding is needed
+    return (m_Capacity / 2) - sizeof(IPCRingBufferRecordHeader);
+}
+
+bool IPCRingBuffer::Push(uint32_t type, const void* data, uint32_t size)
+{
+    return Push(type, data, size, nullptr, 0);
+}
+
+bool IPCRingBuffer::Push(uint32_t type, const void* data_head, uint32_t size_head, const void* data, uint32_t size)
+{
+    const uint64_t payload_size = (uint64_t)size_head + size;
+
+    if ( (m_Header == nullptr) || (payload_size > GetMaxRecordSize()) || (type == k_IPCRingBufferTypePadding) )
+        return false;
+
+    const uint64_t record_size = IPCRingBufferGetRecordSize((uint32_t)payload_size);
+    uint64_t write_pos         = m_Header->WritePos.load(std::memory_order_relaxed);
+    const uint64_t read_pos    = m_Header->ReadPos.load(std::memory_order_acquire);
+
+    uint32_t offset             = (uint32_t)(write_pos & (m_Capacity - 1));
+    const uint32_t space_to_end = m_Capacity - offset;
+    const uint32_t padding_size = (record_size > space_to_end) ? space_to_end : 0;
+
+    if (write_pos + padding_size + record_size - read_pos > m_Capacity)
+        return false;
+
+    if (padding_size != 0)
+    {
+        const IPCRingBufferRecordHeader padding_header = {padding_size - (uint32_t)sizeof(IPCRingBufferRecordHeader), k_IPCRingBufferTypePadding};
+        memcpy(m_Data + offset, &padding_header, sizeof(padding_header));
+
+        write_pos += padding_size;
+        offset = 0;
+    }
+
+    const IPCRingBufferRecordHeader record_header = {(uint32_t)payload_size, type};
+    memcpy(m_Data + offset, &record_header, sizeof(record_header));
+
+    if (size_head != 0)
+    {
+        memcpy(m_Data + offset + sizeof(record_header), data_head, size_head);
+    }
+
+    if (size != 0)
+    {
+        memcpy(m_Data + offset + sizeof(record_header) + size_head, data, size);
+    }
+
+    m_Header->WritePos.store(write_pos + record_size, std::memory_order_release);
+
+    return true;
+}
+
+bool IPCRingBuffer::SetNotifyPending()
+{
+    if (m_Header == nullptr)
+        return false;
+
+    return (m_Header->NotifyPending.exchange(1, std::memory_order_acq_rel) == 0);
+}
+
+void IPCRingBuffer::ClearNotifyPending()
+{
+    if (m_Header == nullptr)
+        return;
+
+    m_Header->NotifyPending.exchange(0, std::memory_order_acq_rel);
+}
+
+const void* IPCRingBuffer::Peek(uint32_t& type, uint32_t& size)
+{
+    if (m_Header == nullptr)
+        return nullptr;
+
+    uint64_t read_pos = m_Header->ReadPos.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        const uint64_t write_pos = m_Header->WritePos.load(std::memory_order_acquire);
+
+        if (read_pos == write_pos)
+            return nullptr;
+
+        const uint32_t offset   = (uint32_t)(read_pos & (m_Capacity - 1));
+        const uint64_t used_size = write_pos - read_pos;
+
+        IPCRingBufferRecordHeader record_header;
+        memcpy(&record_header, m_Data + offset, sizeof(record_header));
+
+        //Drop everything if the producer wrote something that doesn't make sense. Payload sizes are checked before rounding them up to the record size
+        const bool is_padding = (record_header.Type == k_IPCRingBufferTypePadding);
+        const uint64_t record_size = (is_padding) ? sizeof(record_header) + (uint64_t)record_header.Size : IPCRingBufferGetRecordSize(record_header.Size);
+
+        if ( (used_size > m_Capacity) || ( (!is_padding) && (record_header.Size > GetMaxRecordSize()) ) || (record_size > used_size) || (record_size > m_Capacity - offset) ||
+             ( (is_padding) && (offset + record_size != m_Capacity) ) )
+        {
+            Discard();
+            return nullptr;
+        }
+
+        if (is_padding)
+        {
+            read_pos += record_size;
+            m_Header->ReadPos.store(read_pos, std::memory_order_release);
+            continue;
+        }
+
+        m_PeekNextPos = read_pos + record_size;
+        type = record_header.Type;
+        size = record_header.Size;
+
+        return m_Data + offset + sizeof(record_header);
+    }
+}
+
+void IPCRingBuffer::Consume()
+{
+    if (m_Header == nullptr)
+        return;
+
+    m_Header->ReadPos.store(m_PeekNextPos, std::memory_order_release);
+}
+
+void IPCRingBuffer::Discard()
+{
+    if (m_Header == nullptr)
+        return;
+
+    m_PeekNextPos = m_Header->WritePos.load(std::memory_order_acquire);
+    m_Header->ReadPos.store(m_PeekNextPos, std::memory_order_release);
+}
+
+uint64_t IPCRingBuffer::GetUsedSize() const
+{
+    if (m_Header == nullptr)
+        return 0;
+
+    return m_Header->WritePos.load(std::memory_order_acquire) - m_Header->ReadPos.load(std::memory_order_acquire);
+}
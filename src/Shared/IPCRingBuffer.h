@@ -0,0 +1,57 @@
+//Lock-free single-producer/single-consumer ring buffer of variable-size records, meant to be placed in memory shared between processes
+//Only atomics inside the memory block are used for synchronization, so it works on top of any shared memory backend (see IPCSharedMemory)
+//Positions are 64-bit byte counts which never wrap, so a full buffer can't be mistaken for an empty one. Records are never split across the end of the buffer
+//The memory block is written by another process, so record headers are validated when reading. Nothing stops a misbehaving producer from sending garbage payloads though
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+struct IPCRingBufferHeader
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t Capacity;                                  //Size of the data area following the header, power of two
+    uint32_t Reserved;
+    alignas(64) std::atomic<uint64_t> WritePos;         //Only written by the producer
+    alignas(64) std::atomic<uint64_t> ReadPos;          //Only written by the consumer
+    alignas(64) std::atomic<uint32_t> NotifyPending;    //Set by the producer once it notified the consumer, cleared by the consumer before reading
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring buffer positions need to be lock-free to work across processes");
+
+class IPCRingBuffer
+{
+    private:
+        IPCRingBufferHeader* m_Header;
+        uint8_t* m_Data;
+        uint32_t m_Capacity;
+        uint64_t m_PeekNextPos;                         //Consumer position after the record returned by Peek()
+
+    public:
+        static size_t GetMemorySize(uint32_t capacity); //Size of the memory block needed for a ring buffer of the given capacity
+
+        IPCRingBuffer();
+        //Initializes the header if initialize is true, otherwise checks if it matches a ring buffer of the given capacity
+        bool Attach(void* memory, size_t memory_size, uint32_t capacity, bool initialize);
+        void Detach();
+        bool IsAttached() const;
+        uint32_t GetMaxRecordSize() const;              //Largest payload size that can be pushed
+
+        //Producer functions
+        bool Push(uint32_t type, const void* data, uint32_t size);  //Returns false if there's not enough free space
+        //Pushes a single record with the payload made of both parts, so a header can be put in front of data without copying it first
+        bool Push(uint32_t type, const void* data_head, uint32_t size_head, const void* data, uint32_t size);
+        bool SetNotifyPending();                        //Returns true if it wasn't set already, meaning the consumer needs to be notified
+        void ClearNotifyPending();                      //Called by the producer if notifying failed. Also called by the consumer before reading
+
+        //Consumer functions
+        //Returns pointer to the payload of the oldest record or nullptr if there is none. Payload stays valid until Consume() is called
+        const void* Peek(uint32_t& type, uint32_t& size);
+        void Consume();                                 //Removes the record returned by the last Peek() call
+        void Discard();                                 //Removes all records
+
+        uint64_t GetUsedSize() const;
+};
@@ -0,0 +1,195 @@
+#include "IPCSharedMemory.h"
+
+#ifdef _WIN32
+    #define NOMINMAX
+    #include <windows.h>
+    #include "Util.h"
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+IPCSharedMemory::IPCSharedMemory() : m_Data(nullptr),
+                                     m_Size(0),
+                                     m_IsCreator(false),
+                                 #ifdef _WIN32
+                                     m_MappingHandle(nullptr)
+                                 #else
+                                     m_FileDescriptor(-1)
+                                 #endif
+{
+}
+
+IPCSharedMemory::~IPCSharedMemory()
+{
+    Close();
+}
+
+#ifdef _WIN32
+
+bool IPCSharedMemory::Map(const char* name, size_t size, bool allow_create)
+{
+    Close();
+
+    const std::wstring wname = WStringConvertFromUTF8(name);
+
+    if (allow_create)
+    {
+        m_MappingHandle = ::CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, (DWORD)((uint64_t)size >> 32), (DWORD)(size & 0xFFFFFFFF), wname.c_str());
+        m_IsCreator = ( (m_MappingHandle != nullptr) && (::GetLastError() != ERROR_ALREADY_EXISTS) );
+    }
+    else
+    {
+        m_MappingHandle = ::OpenFileMappingW(FILE_MAP_ALL_ACCESS, FALSE, wname.c_str());
+    }
+
+    if (m_MappingHandle == nullptr)
+        return false;
+
+    //Fails if an existing mapping is smaller than the requested size
+    m_Data = ::MapViewOfFile(m_MappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+
+    if (m_Data == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    m_Size = size;
+
+    return true;
+}
+
+void IPCSharedMemory::Close()
+{
+    if (m_Data != nullptr)
+    {
+        ::UnmapViewOfFile(m_Data);
+        m_Data = nullptr;
+    }
+
+    if (m_MappingHandle != nullptr)
+    {
+        ::CloseHandle(m_MappingHandle);
+        m_MappingHandle = nullptr;
+    }
+
+    m_Size = 0;
+    m_IsCreator = false;
+}
+
+void IPCSharedMemory::Remove(const char* /*name*/)
+{
+    //Mappings are gone once all handles are closed
+}
+
+#else
+
+bool IPCSharedMemory::Map(const char* name, size_t size, bool allow_create)
+{
+    Close();
+
+    //POSIX names need a leading slash
+    const std::string shm_name = std::string("/") + name;
+
+    if (allow_create)
+    {
+        m_FileDescriptor = ::shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        m_IsCreator = (m_FileDescriptor != -1);
+
+        if (m_IsCreator)
+        {
+            if (::ftruncate(m_FileDescriptor, (off_t)size) != 0)
+            {
+                Close();
+                ::shm_unlink(shm_name.c_str());
+                return false;
+            }
+        }
+    }
+
+    if (m_FileDescriptor == -1)
+    {
+        m_FileDescriptor = ::shm_open(shm_name.c_str(), O_RDWR, 0600);
+
+        if (m_FileDescriptor == -1)
+            return false;
+    }
+
+    struct stat file_stat;
+    if ( (::fstat(m_FileDescriptor, &file_stat) != 0) || ((size_t)file_stat.st_size < size) )
+    {
+        Close();
+        return false;
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_FileDescriptor, 0);
+
+    if (data == MAP_FAILED)
+    {
+        Close();
+        return false;
+    }
+
+    m_Data = data;
+    m_Size = size;
+
+    return true;
+}
+
+void IPCSharedMemory::Close()
+{
+    if (m_Data != nullptr)
+    {
+        ::munmap(m_Data, m_Size);
+        m_Data = nullptr;
+    }
+
+    if (m_FileDescriptor != -1)
+    {
+        ::close(m_FileDescriptor);
+        m_FileDescriptor = -1;
+    }
+
+    m_Size = 0;
+    m_IsCreator = false;
+}
+
+void IPCSharedMemory::Remove(const char* name)
+{
+    ::shm_unlink((std::string("/") + name).c_str());
+}
+
+#endif //_WIN32
+
+bool IPCSharedMemory::Create(const char* name, size_t size)
+{
+    return Map(name, size, true);
+}
+
+bool IPCSharedMemory::Open(const char* name, size_t size)
+{
+    return Map(name, size, false);
+}
+
+bool IPCSharedMemory::IsOpen() const
+{
+    return (m_Data != nullptr);
+}
+
+bool IPCSharedMemory::IsCreator() const
+{
+    return m_IsCreator;
+}
+
+void* IPCSharedMemory::GetData() const
+{
+    return m_Data;
+}
+
+size_t IPCSharedMemory::GetSize() const
+{
+    return m_Size;
+}
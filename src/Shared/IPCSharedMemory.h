@@ -0,0 +1,40 @@
+//Named memory block shared between processes, used by the IPC ring buffer transport
+//This is a thin platform layer so the ring buffer logic itself isn't tied to Win32. Windows uses named file mappings backed by the page file, other platforms POSIX shm_open()/mmap()
+//On Windows, the block exists as long as any process has it open. On POSIX platforms it stays around until Remove() is called
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+class IPCSharedMemory
+{
+    private:
+        void* m_Data;
+        size_t m_Size;
+        bool m_IsCreator;
+
+        #ifdef _WIN32
+            void* m_MappingHandle;
+        #else
+            int m_FileDescriptor;
+        #endif
+
+        bool Map(const char* name, size_t size, bool allow_create);
+
+    public:
+        IPCSharedMemory();
+        ~IPCSharedMemory();
+        IPCSharedMemory(const IPCSharedMemory&) = delete;
+        IPCSharedMemory& operator=(const IPCSharedMemory&) = delete;
+
+        bool Create(const char* name, size_t size);     //Creates the block or opens it if it already exists
+        bool Open(const char* name, size_t size);       //Only opens existing blocks. Fails if the existing block is smaller than size
+        void Close();
+        static void Remove(const char* name);           //Does nothing on Windows
+
+        bool IsOpen() const;
+        bool IsCreator() const;                         //True if the last Create() call created a new block instead of opening an existing one
+        void* GetData() const;
+        size_t GetSize() const;
+};
@@ -0,0 +1,264 @@
+#include "IPCStats.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include "InterprocessMessaging.h"
+#include "DPBrowserAPI.h"
+
+static IPCStats g_IPCStats;
+
+static const size_t k_IPCStatsBrowserCommandIDMax = 256;  //DPBrowserICPCommandID has no max value as it's shared with the browser process
+
+//Bucket upper limits in microseconds
+static const uint64_t k_IPCStatsLatencyBucketLimits[k_IPCStatsLatencyBucketCount] = {100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, UINT64_MAX};
+
+float IPCStatsRow::GetLatencyAverageMs() const
+{
+    return (LatencyCount != 0) ? (float)((double)LatencyTotalUs / LatencyCount / 1000.0) : 0.0f;
+}
+
+float IPCStatsRow::GetLatencyPercentileMs(float percentile) const
+{
+    if (LatencyCount == 0)
+        return 0.0f;
+
+    const uint64_t target_count = (uint64_t)(LatencyCount * percentile);
+    uint64_t count = 0;
+
+    for (size_t i = 0; i < k_IPCStatsLatencyBucketCount; ++i)
+    {
+        count += LatencyBuckets[i];
+
+        if (count > target_count)
+        {
+            //Last bucket has no limit, use the max latency instead
+            return (i + 1 < k_IPCStatsLatencyBucketCount) ? k_IPCStatsLatencyBucketLimits[i] / 1000.0f : LatencyMaxUs / 1000.0f;
+        }
+    }
+
+    return LatencyMaxUs / 1000.0f;
+}
+
+IPCStats::IPCStats() : m_IsEnabled(false), m_TimestampFrequency(1)
+{
+    m_EntryCount[ipcstats_action]          = ipcact_MAX;
+    m_EntryCount[ipcstats_config]          = configid_bool_MAX + configid_int_MAX + configid_float_MAX + configid_handle_MAX;
+    m_EntryCount[ipcstats_config_string]   = configid_str_MAX;
+    m_EntryCount[ipcstats_config_delta]    = 1;
+    m_EntryCount[ipcstats_elevated_action] = ipceact_MAX;
+    m_EntryCount[ipcstats_elevated_string] = ipcestrid_MAX;
+    m_EntryCount[ipcstats_browser]         = k_IPCStatsBrowserCommandIDMax;
+    m_EntryCount[ipcstats_browser_string]  = dpbrowser_ipcstr_MAX - dpbrowser_ipcstr_MIN;
+    m_EntryCount[ipcstats_ui_mask]         = 1;
+    m_EntryCount[ipcstats_lane_delay]      = ipclane_MAX;
+    m_EntryCount[ipcstats_ring_full]       = ipcpeer_MAX;
+
+    for (size_t i = 0; i < ipcstats_MAX; ++i)
+    {
+        m_Entries[i] = std::make_unique<Entry[]>(m_EntryCount[i]);
+    }
+
+    LARGE_INTEGER frequency;
+    if (::QueryPerformanceFrequency(&frequency))
+    {
+        m_TimestampFrequency = frequency.QuadPart;
+    }
+}
+
+IPCStats& IPCStats::Get()
+{
+    return g_IPCStats;
+}
+
+IPCStats::Entry* IPCStats::GetEntry(IPCStatsChannel channel, size_t id)
+{
+    if ( (channel >= ipcstats_MAX) || (id >= m_EntryCount[channel]) )
+        return nullptr;
+
+    return &m_Entries[channel][id];
+}
+
+void IPCStats::SetEnabled(bool is_enabled)
+{
+    m_IsEnabled.store(is_enabled, std::memory_order_relaxed);
+}
+
+int64_t IPCStats::GetTimestamp()
+{
+    LARGE_INTEGER counter;
+    ::QueryPerformanceCounter(&counter);
+
+    return counter.QuadPart;
+}
+
+uint64_t IPCStats::GetMicrosecondsSince(int64_t timestamp) const
+{
+    const int64_t elapsed = GetTimestamp() - timestamp;
+
+    //Not expected with QPC, but don't record garbage if the timestamp came from somewhere else
+    if (elapsed < 0)
+        return 0;
+
+    return (uint64_t)((elapsed * 1000000) / m_TimestampFrequency);
+}
+
+void IPCStats::RecordSend(IPCStatsChannel channel, size_t id, size_t bytes)
+{
+    if (Entry* entry = GetEntry(channel, id))
+    {
+        entry->SendCount.fetch_add(1, std::memory_order_relaxed);
+        entry->SendBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+void IPCStats::RecordLatency(IPCStatsChannel channel, size_t id, uint64_t latency_us)
+{
+    Entry* entry = GetEntry(channel, id);
+
+    if (entry == nullptr)
+        return;
+
+    size_t bucket = 0;
+    while (latency_us > k_IPCStatsLatencyBucketLimits[bucket])
+    {
+        ++bucket;
+    }
+
+    entry->LatencyCount.fetch_add(1, std::memory_order_relaxed);
+    entry->LatencyTotalUs.fetch_add(latency_us, std::memory_order_relaxed);
+    entry->LatencyBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t latency_max = entry->LatencyMaxUs.load(std::memory_order_relaxed);
+    while ( (latency_us > latency_max) && (!entry->LatencyMaxUs.compare_exchange_weak(latency_max, latency_us, std::memory_order_relaxed)) )
+    {
+    }
+}
+
+uint64_t IPCStats::GetLatencyBucketLimitUs(size_t bucket)
+{
+    return (bucket < k_IPCStatsLatencyBucketCount) ? k_IPCStatsLatencyBucketLimits[bucket] : UINT64_MAX;
+}
+
+const char* IPCStats::GetChannelName(IPCStatsChannel channel)
+{
+    switch (channel)
+    {
+        case ipcstats_action:          return "Action";
+        case ipcstats_config:          return "Config";
+        case ipcstats_config_string:   return "ConfigString";
+        case ipcstats_config_delta:    return "ConfigDelta";
+        case ipcstats_elevated_action: return "ElevatedAction";
+        case ipcstats_elevated_string: return "ElevatedString";
+        case ipcstats_browser:         return "Browser";
+        case ipcstats_browser_string:  return "BrowserString";
+        case ipcstats_ui_mask:         return "UIMask";
+        case ipcstats_lane_delay:      return "LaneDelay";
+        case ipcstats_ring_full:       return "RingFull";
+        default:                       return "Unknown";
+    }
+}
+
+std::vector<IPCStatsRow> IPCStats::GetRows() const
+{
+    std::vector<IPCStatsRow> rows;
+
+    for (size_t channel = 0; channel < ipcstats_MAX; ++channel)
+    {
+        for (size_t id = 0; id < m_EntryCount[channel]; ++id)
+        {
+            const Entry& entry = m_Entries[channel][id];
+
+            IPCStatsRow row;
+            row.SendCount    = entry.SendCount.load(std::memory_order_relaxed);
+            row.LatencyCount = entry.LatencyCount.load(std::memory_order_relaxed);
+
+            if ( (row.SendCount == 0) && (row.LatencyCount == 0) )
+                continue;
+
+            row.Channel        = (IPCStatsChannel)channel;
+            row.ID             = (uint32_t)id;
+            row.SendBytes      = entry.SendBytes.load(std::memory_order_relaxed);
+            row.LatencyTotalUs = entry.LatencyTotalUs.load(std::memory_order_relaxed);
+            row.LatencyMaxUs   = entry.LatencyMaxUs.load(std::memory_order_relaxed);
+
+            for (size_t i = 0; i < k_IPCStatsLatencyBucketCount; ++i)
+            {
+                row.LatencyBuckets[i] = entry.LatencyBuckets[i].load(std::memory_order_relaxed);
+            }
+
+            rows.push_back(row);
+        }
+    }
+
+    //Received messages are only counted with latency, so sort by whichever is higher
+    std::stable_sort(rows.begin(), rows.end(), [](const IPCStatsRow& a, const IPCStatsRow& b)
+                     { return std::max(a.SendCount, a.LatencyCount) > std::max(b.SendCount, b.LatencyCount); });
+
+    return rows;
+}
+
+void IPCStats::Reset()
+{
+    for (size_t channel = 0; channel < ipcstats_MAX; ++channel)
+    {
+        for (size_t id = 0; id < m_EntryCount[channel]; ++id)
+        {
+            Entry& entry = m_Entries[channel][id];
+
+            entry.SendCount.store(0, std::memory_order_relaxed);
+            entry.SendBytes.store(0, std::memory_order_relaxed);
+            entry.LatencyCount.store(0, std::memory_order_relaxed);
+            entry.LatencyTotalUs.store(0, std::memory_order_relaxed);
+            entry.LatencyMaxUs.store(0, std::memory_order_relaxed);
+
+            for (auto& bucket : entry.LatencyBuckets)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+bool IPCStats::WriteDumpFile(const char* process_name) const
+{
+    std::ofstream file(std::string(process_name) + "_ipc_stats.txt", std::ios::trunc);
+
+    if (!file.good())
+        return false;
+
+    file << "IPC stats of " << process_name << "\n";
+    file << "Latency columns are message counts per bucket, bucket limits are in ms\n\n";
+
+    file << std::left << std::setw(16) << "Channel" << std::right << std::setw(6) << "ID" << std::setw(12) << "Sent" << std::setw(14) << "Bytes"
+         << std::setw(12) << "Latencies" << std::setw(10) << "Avg ms" << std::setw(10) << "P95 ms" << std::setw(10) << "Max ms";
+
+    for (size_t i = 0; i < k_IPCStatsLatencyBucketCount; ++i)
+    {
+        const uint64_t limit = k_IPCStatsLatencyBucketLimits[i];
+        file << std::setw(9) << ((limit != UINT64_MAX) ? "<=" + std::to_string(limit / 1000.0).substr(0, 5) : std::string(">100"));
+    }
+
+    file << "\n";
+    file << std::fixed << std::setprecision(3);
+
+    for (const IPCStatsRow& row : GetRows())
+    {
+        file << std::left << std::setw(16) << GetChannelName(row.Channel) << std::right << std::setw(6) << row.ID << std::setw(12) << row.SendCount
+             << std::setw(14) << row.SendBytes << std::setw(12) << row.LatencyCount << std::setw(10) << row.GetLatencyAverageMs()
+             << std::setw(10) << row.GetLatencyPercentileMs(0.95f) << std::setw(10) << row.LatencyMaxUs / 1000.0f;
+
+        for (size_t i = 0; i < k_IPCStatsLatencyBucketCount; ++i)
+        {
+            file << std::setw(9) << row.LatencyBuckets[i];
+        }
+
+        file << "\n";
+    }
+
+    const IPCPeerWindowCacheStats window_cache_stats = IPCManager::Get().GetPeerWindowCacheStats();
+    file << "\nPeer window cache: " << window_cache_stats.Hits << " hits, " << window_cache_stats.Lookups << " lookups, " << window_cache_stats.Invalidations << " invalidations\n";
+
+    return file.good();
+}
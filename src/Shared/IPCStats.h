@@ -0,0 +1,100 @@
+//Opt-in instrumentation of interprocess messages, enabled by setting IPCStatsEnabled=true in the [Performance] section of the config file
+//Counts messages and bytes sent per message type and ID, as well as latency histograms where the latency is known:
+//- Messages and strings received through the shared memory transport carry the time they were sent, so the latency is the time until the receiver handles them
+//- Ring messages additionally record how long they waited in the receiver's lane queue, per IPCMessageLane
+//- Strings and other data sent with SendMessage() as fallback are handled synchronously, so the latency is the time the sender was blocked
+//Stats are per process. The UI shows its stats in the performance monitor and both the dashboard and UI process write them to a dump file on exit
+//Peer window cache hits and lookups are shown and written along with them
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+enum IPCStatsChannel
+{
+    ipcstats_action,            //IDs are IPCActionID
+    ipcstats_config,            //IDs are generic ConfigIDs as used by ipcmsg_set_config
+    ipcstats_config_string,     //IDs are ConfigID_String
+    ipcstats_config_delta,      //Single ID, ConfigDelta data
+    ipcstats_elevated_action,   //IDs are IPCElevatedActionID
+    ipcstats_elevated_string,   //IDs are IPCElevatedStringID
+    ipcstats_browser,           //IDs are DPBrowserICPCommandID
+    ipcstats_browser_string,    //IDs are DPBrowserICPStringID - dpbrowser_ipcstr_MIN
+    ipcstats_ui_mask,           //Single ID, UIIntersectionMask updates
+    ipcstats_lane_delay,        //IDs are IPCMessageLane, latency only. Time received ring messages waited in their lane before being handled
+    ipcstats_ring_full,         //IDs are IPCPeerID of the receiver, send counts only. Messages that didn't fit into the receiver's ring buffer (dropped, or sent as WM_COPYDATA for data)
+    ipcstats_MAX
+};
+
+static const size_t k_IPCStatsLatencyBucketCount = 11;
+
+//Counters of IPCManager's peer window handle cache, which are always collected
+struct IPCPeerWindowCacheStats
+{
+    uint64_t Hits          = 0;     //Cached window passed revalidation
+    uint64_t Lookups       = 0;     //FindWindow() calls due to empty or stale cache
+    uint64_t Invalidations = 0;     //Cached window turned out stale (peer exited or restarted)
+};
+
+//Plain copy of the stats of a single message ID
+struct IPCStatsRow
+{
+    IPCStatsChannel Channel = ipcstats_action;
+    uint32_t ID             = 0;
+    uint64_t SendCount      = 0;
+    uint64_t SendBytes      = 0;
+    uint64_t LatencyCount   = 0;
+    uint64_t LatencyTotalUs = 0;
+    uint64_t LatencyMaxUs   = 0;
+    uint64_t LatencyBuckets[k_IPCStatsLatencyBucketCount] = {};
+
+    float GetLatencyAverageMs() const;
+    float GetLatencyPercentileMs(float percentile) const;   //Upper limit of the bucket the percentile falls into, so only as precise as the buckets are
+};
+
+class IPCStats
+{
+    private:
+        struct Entry
+        {
+            std::atomic<uint64_t> SendCount{0};
+            std::atomic<uint64_t> SendBytes{0};
+            std::atomic<uint64_t> LatencyCount{0};
+            std::atomic<uint64_t> LatencyTotalUs{0};
+            std::atomic<uint64_t> LatencyMaxUs{0};
+            std::atomic<uint64_t> LatencyBuckets[k_IPCStatsLatencyBucketCount] = {};
+        };
+
+        std::atomic<bool> m_IsEnabled;
+        std::unique_ptr<Entry[]> m_Entries[ipcstats_MAX];
+        size_t m_EntryCount[ipcstats_MAX];
+        int64_t m_TimestampFrequency;
+
+        Entry* GetEntry(IPCStatsChannel channel, size_t id);
+
+    public:
+        IPCStats();
+        static IPCStats& Get();
+
+        void SetEnabled(bool is_enabled);
+        bool IsEnabled() const { return m_IsEnabled.load(std::memory_order_relaxed); }
+
+        //Timestamps are comparable across processes
+        static int64_t GetTimestamp();
+        uint64_t GetMicrosecondsSince(int64_t timestamp) const;
+
+        //These can be called from any thread, but callers are expected to check IsEnabled() first
+        void RecordSend(IPCStatsChannel channel, size_t id, size_t bytes);
+        void RecordLatency(IPCStatsChannel channel, size_t id, uint64_t latency_us);
+
+        static uint64_t GetLatencyBucketLimitUs(size_t bucket);     //Upper limit of the bucket, UINT64_MAX for the last one
+        static const char* GetChannelName(IPCStatsChannel channel);
+
+        std::vector<IPCStatsRow> GetRows() const;                   //Returns rows of all IDs with any messages, sorted by send count (highest first)
+        void Reset();
+        bool WriteDumpFile(const char* process_name) const;         //Writes to "<process_name>_ipc_stats.txt" in the working directory
+};
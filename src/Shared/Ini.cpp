@@ -29,6 +29,9 @@ ini_t* ini_load( char const* data, void* memctx );
 int ini_save( ini_t const* ini, char* data, int size );
 void ini_destroy( ini_t* ini );
 
+ini_t* ini_load_snapshot( char const* data, int size, void* memctx );
+int ini_save_snapshot( ini_t const* ini, char* data, int size );
+
 int ini_section_count( ini_t const* ini );
 char const* ini_section_name( ini_t const* ini, int section );
 
@@ -61,6 +64,11 @@ void ini_property_value_set( ini_t* ini, int section, int property, char const*
 #include "Ini.h"
 
 #include <string>
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include <cstring>
+#include <algorithm>
 #define NOMINMAX
 #include <windows.h>
 
@@ -69,24 +77,88 @@ void ini_property_value_set( ini_t* ini, int section, int property, char const*
 #endif
 
 
-Ini::Ini(const std::wstring& wfilename, bool replace_contents) : m_WFileName(wfilename), m_IniPtr(nullptr)
+//Snapshot file header, followed by the ini_save_snapshot() payload
+//The snapshot is only used if it's keyed to the current state of the source file
+struct IniSnapshotHeader
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint64_t SourceSize;
+    uint64_t SourceWriteTime;
+    uint64_t SourceHash;
+    uint64_t PayloadSize;
+    uint64_t PayloadHash;
+};
+
+static const uint32_t k_IniSnapshotMagic   = 0x53495044;   //"DPIS"
+static const uint32_t k_IniSnapshotVersion = 1;
+
+static uint64_t IniHashData(const char* data, size_t size)
+{
+    //FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+static bool IniGetFileKey(const std::wstring& filename, uint64_t& size, uint64_t& write_time)
+{
+    WIN32_FILE_ATTRIBUTE_DATA attr_data;
+    if (::GetFileAttributesExW(filename.c_str(), GetFileExInfoStandard, &attr_data) == 0)
+        return false;
+
+    size       = ((uint64_t)attr_data.nFileSizeHigh      << 32) | attr_data.nFileSizeLow;
+    write_time = ((uint64_t)attr_data.ftLastWriteTime.dwHighDateTime << 32) | attr_data.ftLastWriteTime.dwLowDateTime;
+
+    return true;
+}
+
+static bool IniReadFileContents(const std::wstring& filename, std::string& contents)
+{
+    FILE* fp = _wfopen(filename.c_str(), L"rt");
+    if (fp == nullptr)
+        return false;
+
+    //Read entire file into string
+    fseek(fp, 0, SEEK_END);
+    contents.resize(ftell(fp));
+    rewind(fp);
+    size_t bytes_read = fread(&contents[0], 1, contents.size(), fp);
+    fclose(fp);
+
+    contents.resize(bytes_read);
+
+    return true;
+}
+
+
+Ini::Ini(const std::wstring& wfilename, bool replace_contents, bool use_snapshot_cache) : m_WFileName(wfilename), m_IniPtr(nullptr), 
+                                                                                          m_UseSnapshotCache(use_snapshot_cache)
 {
     if (!replace_contents)
     {
-        FILE* fp = _wfopen(m_WFileName.c_str(), L"rt");
-        if (fp != nullptr)
+        if ((m_UseSnapshotCache) && (LoadSnapshot()))
+            return;
+
+        std::string contents;
+        if (IniReadFileContents(m_WFileName, contents))
         {
-            //Read entire file into string
-            std::string contents;
-            fseek(fp, 0, SEEK_END);
-            contents.resize(ftell(fp));
-            rewind(fp);
-            size_t bytes_read = fread(&contents[0], 1, contents.size(), fp);
-            fclose(fp);
+            m_IniPtr = ini_load(contents.data(), nullptr);
 
-            contents.resize(bytes_read);
+            //Only UI process writes files, dashboard process will pick up the snapshot once it exists
+            #ifdef DPLUS_UI
+                if (m_UseSnapshotCache)
+                {
+                    SaveSnapshot(m_WFileName, contents.data(), contents.size());
+                }
+            #endif
 
-            m_IniPtr = ini_load(contents.data(), nullptr);
             return;
         }
     }
@@ -106,33 +178,203 @@ bool Ini::Save()
 
 bool Ini::Save(const std::wstring& filename)
 {
+    return WriteContents(filename, GetContents());
+}
+
+bool Ini::SaveIfChanged(std::string& last_contents)
+{
+    std::string contents = GetContents();
+
+    if (contents == last_contents)
+        return true;
+
+    if (!WriteContents(m_WFileName, contents))
+        return false;
+
+    last_contents = std::move(contents);
+    return true;
+}
+
+std::string Ini::GetContents() const
+{
+    std::string contents;
+
     int size = ini_save(m_IniPtr, nullptr, 0); //Get required size
     if (size > 0)
     {
-        char* data = new (std::nothrow) char[size];
+        contents.resize(size);
+        size = ini_save(m_IniPtr, &contents[0], size); //Store in string
+        contents.resize(size - 1);                     //Contents are 0-terminated when using size provided by ini_save(), so drop the last byte
+    }
+
+    return contents;
+}
+
+bool Ini::WriteContents(const std::wstring& filename, const std::string& contents) const
+{
+    //Write to temporary file and replace the target with it
+    const std::wstring temp_filename = filename + L".tmp";
+    bool write_ok = false;
+
+    FILE* fp = _wfopen(temp_filename.c_str(), L"wt");
+    if (fp != nullptr)
+    {
+        write_ok = (fwrite(contents.data(), 1, contents.size(), fp) == contents.size());
+        write_ok = (fclose(fp) == 0) && (write_ok);
+
+        if ( (write_ok) && (::MoveFileExW(temp_filename.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING) == 0) )
+        {
+            //Replacing can fail if another process has the file open right now, write it directly then
+            fp = _wfopen(filename.c_str(), L"wt");
+            write_ok = (fp != nullptr);
+
+            if (fp != nullptr)
+            {
+                write_ok = (fwrite(contents.data(), 1, contents.size(), fp) == contents.size());
+                write_ok = (fclose(fp) == 0) && (write_ok);
+            }
+
+            ::DeleteFileW(temp_filename.c_str());
+        }
+        else if (!write_ok)
+        {
+            ::DeleteFileW(temp_filename.c_str());
+        }
+
+        if ( (write_ok) && (m_UseSnapshotCache) )
+        {
+            SaveSnapshot(filename, contents.data(), contents.size());
+        }
+    }
+
+    return write_ok;
+}
+
+const std::wstring& Ini::GetFileName() const
+{
+    return m_WFileName;
+}
+
+bool Ini::LoadSnapshot()
+{
+    uint64_t source_size = 0, source_write_time = 0;
+    if (!IniGetFileKey(m_WFileName, source_size, source_write_time))
+        return false;
+
+    HANDLE file_handle = ::CreateFileW(GetSnapshotFileName(m_WFileName).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, 
+                                       FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER file_size;
+    HANDLE mapping_handle = nullptr;
+    const char* view = nullptr;
+    std::string contents;
+
+    if ( (::GetFileSizeEx(file_handle, &file_size)) && ((uint64_t)file_size.QuadPart > sizeof(IniSnapshotHeader)) && (file_size.QuadPart < INT_MAX) )
+    {
+        mapping_handle = ::CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
 
-        if (data == nullptr)
+        if (mapping_handle != nullptr)
         {
-            return false;
+            view = (const char*)::MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
         }
+    }
+
+    if (view != nullptr)
+    {
+        IniSnapshotHeader header;
+        memcpy(&header, view, sizeof(header));
 
-        size = ini_save(m_IniPtr, data, size); //Store in data buffer
+        const char* payload = view + sizeof(header);
+        const size_t payload_size = (size_t)file_size.QuadPart - sizeof(header);
 
-        FILE* fp = _wfopen(filename.c_str(), L"wt");
-        if (fp != nullptr)
+        bool is_valid = ( (header.Magic == k_IniSnapshotMagic) && (header.Version == k_IniSnapshotVersion) && (header.SourceSize == source_size) && 
+                          (header.PayloadSize == payload_size) );
+
+        //Files are often saved again without changes, so fall back to comparing the content hash if only the write time differs
+        if ( (is_valid) && (header.SourceWriteTime != source_write_time) )
         {
-            fwrite(data, 1, size - 1, fp); //data is 0-terminated when using size provided by ini_save(), so don't write the last byte
-            fclose(fp);
+            is_valid = ( (IniReadFileContents(m_WFileName, contents)) && (IniHashData(contents.data(), contents.size()) == header.SourceHash) );
         }
-        delete[] data;
 
-        return (fp != nullptr);
+        //Catch corrupted or partially written snapshots
+        if ( (is_valid) && (IniHashData(payload, payload_size) == header.PayloadHash) )
+        {
+            m_IniPtr = ini_load_snapshot(payload, (int)payload_size, nullptr);
+        }
+
+        ::UnmapViewOfFile(view);
     }
 
-    return false;
+    if (mapping_handle != nullptr)
+    {
+        ::CloseHandle(mapping_handle);
+    }
+
+    ::CloseHandle(file_handle);
+
+    //Update the snapshot's key if the contents matched, so the next load doesn't have to compare them again
+    #ifdef DPLUS_UI
+        if ( (m_IniPtr != nullptr) && (!contents.empty()) )
+        {
+            SaveSnapshot(m_WFileName, contents.data(), contents.size());
+        }
+    #endif
+
+    return (m_IniPtr != nullptr);
 }
 
-std::string Ini::ReadString(const char* section, const char* key, const char* default_value) const
+void Ini::SaveSnapshot(const std::wstring& filename, const char* source_data, size_t source_size) const
+{
+    IniSnapshotHeader header = {};
+    header.Magic   = k_IniSnapshotMagic;
+    header.Version = k_IniSnapshotVersion;
+
+    //Key by what ended up on disk, as text mode may change the size
+    if (!IniGetFileKey(filename, header.SourceSize, header.SourceWriteTime))
+        return;
+
+    int payload_size = ini_save_snapshot(m_IniPtr, nullptr, 0);
+    if (payload_size <= 0)
+        return;
+
+    std::vector<char> data(sizeof(header) + payload_size);
+    ini_save_snapshot(m_IniPtr, data.data() + sizeof(header), payload_size);
+
+    header.SourceHash  = IniHashData(source_data, source_size);
+    header.PayloadSize = (uint64_t)payload_size;
+    header.PayloadHash = IniHashData(data.data() + sizeof(header), payload_size);
+    memcpy(data.data(), &header, sizeof(header));
+
+    //Write to a temporary file first and swap it in so readers never see a partial snapshot
+    const std::wstring snapshot_filename = GetSnapshotFileName(filename);
+    const std::wstring temp_filename     = snapshot_filename + L".tmp";
+
+    FILE* fp = _wfopen(temp_filename.c_str(), L"wb");
+    if (fp == nullptr)
+        return;
+
+    bool write_ok = (fwrite(data.data(), 1, data.size(), fp) == data.size());
+    write_ok = (fclose(fp) == 0) && (write_ok);
+
+    if ( (!write_ok) || (::MoveFileExW(temp_filename.c_str(), snapshot_filename.c_str(), MOVEFILE_REPLACE_EXISTING) == 0) )
+    {
+        ::DeleteFileW(temp_filename.c_str());
+    }
+}
+
+std::wstring Ini::GetSnapshotFileName(const std::wstring& filename)
+{
+    return filename + L".snapshot";
+}
+
+void Ini::DeleteSnapshot(const std::wstring& filename)
+{
+    ::DeleteFileW(GetSnapshotFileName(filename).c_str());
+}
+
+const char* Ini::FindValue(const char* section, const char* key) const
 {
     int section_id = ini_find_section(m_IniPtr, section, 0);
 
@@ -146,9 +388,28 @@ std::string Ini::ReadString(const char* section, const char* key, const char* de
         }
     }
 
+    return nullptr;
+}
+
+std::string Ini::ReadString(const char* section, const char* key, const char* default_value) const
+{
+    const char* value = FindValue(section, key);
+
+    if (value != nullptr)
+    {
+        return value;
+    }
+
     return (default_value != nullptr) ? default_value : "";
 }
 
+std::string_view Ini::ReadStringView(const char* section, const char* key, std::string_view default_value) const
+{
+    const char* value = FindValue(section, key);
+
+    return (value != nullptr) ? std::string_view(value) : default_value;
+}
+
 void Ini::WriteString(const char* section, const char* key, const char* value)
 {
     int section_id = ini_find_section(m_IniPtr, section, 0);
@@ -172,28 +433,16 @@ void Ini::WriteString(const char* section, const char* key, const char* value)
 
 int Ini::ReadInt(const char* section, const char* key, int default_value) const
 {
-    std::string str_value = ReadString(section, key, "NAN");
+    const char* value = FindValue(section, key);
 
-    if (str_value != "NAN")
-        return atoi(str_value.c_str());
-    else
-        return default_value;
+    return (value != nullptr) ? atoi(value) : default_value;
 }
 
 bool Ini::ReadBool(const char* section, const char* key, bool default_value) const
 {
-    std::string str_value = ReadString(section, key, "NAN");
+    const char* value = FindValue(section, key);
 
-    //Allow these, because why not
-    if (str_value == "true")
-        return true;
-    else if (str_value == "false")
-        return false;
-
-    if (str_value != "NAN")
-        return (atoi(str_value.c_str()) != 0);
-    else
-        return default_value;
+    return (value != nullptr) ? ParseBool(value) : default_value;
 }
 
 void Ini::WriteInt(const char* section, const char* key, int value)
@@ -216,14 +465,7 @@ bool Ini::SectionExists(const char* section) const
 
 bool Ini::KeyExists(const char* section, const char* key) const
 {
-    int section_id = ini_find_section(m_IniPtr, section, 0);
-
-    if (section_id == INI_NOT_FOUND)
-    {
-        return false;
-    }
-
-    return (ini_find_property(m_IniPtr, section_id, key, 0) != INI_NOT_FOUND);
+    return (FindValue(section, key) != nullptr);
 }
 
 bool Ini::RenameSection(const char* section, const char* new_name)
@@ -272,6 +514,102 @@ std::vector<std::string> Ini::GetSectionList()
 
     return section_list;
 }
+
+IniSectionCursor Ini::GetSectionCursor(const char* section) const
+{
+    return IniSectionCursor(m_IniPtr, ini_find_section(m_IniPtr, section, 0));
+}
+
+int Ini::ParseInt(std::string_view str)
+{
+    //Same behavior as atoi(), but doesn't need the string to be NUL-terminated
+    size_t pos = 0;
+
+    while ( (pos < str.size()) && (isspace((unsigned char)str[pos])) )
+        ++pos;
+
+    bool negative = false;
+    if ( (pos < str.size()) && ((str[pos] == '-') || (str[pos] == '+')) )
+    {
+        negative = (str[pos] == '-');
+        ++pos;
+    }
+
+    //Accumulate as int64 and saturate out-of-range values like the CRT's atoi() does. INT_MIN's magnitude doesn't fit in an int, so it can't be negated at the end
+    const int64_t value_max = (negative) ? -(int64_t)INT_MIN : INT_MAX;
+    int64_t value = 0;
+    while ( (pos < str.size()) && (str[pos] >= '0') && (str[pos] <= '9') )
+    {
+        value = std::min((value * 10) + (str[pos] - '0'), value_max);
+        ++pos;
+    }
+
+    return (int)((negative) ? -value : value);
+}
+
+bool Ini::ParseBool(std::string_view str)
+{
+    //Allow these, because why not
+    if (str == "true")
+        return true;
+    else if (str == "false")
+        return false;
+
+    return (ParseInt(str) != 0);
+}
+
+IniSectionCursor::IniSectionCursor(const ini_t* ini_ptr, int section_id) : m_IniPtr(ini_ptr), m_SectionID(section_id), m_PropertyID(-1), m_PropertyCount(0)
+{
+    if (m_SectionID != INI_NOT_FOUND)
+    {
+        m_PropertyCount = ini_property_count(m_IniPtr, m_SectionID);
+    }
+}
+
+bool IniSectionCursor::IsValid() const
+{
+    return (m_SectionID != INI_NOT_FOUND);
+}
+
+bool IniSectionCursor::Next()
+{
+    if (m_PropertyID + 1 < m_PropertyCount)
+    {
+        ++m_PropertyID;
+        return true;
+    }
+
+    m_PropertyID = m_PropertyCount;
+    return false;
+}
+
+std::string_view IniSectionCursor::GetKey() const
+{
+    const char* name = ini_property_name(m_IniPtr, m_SectionID, m_PropertyID);
+    return (name != nullptr) ? std::string_view(name) : std::string_view();
+}
+
+std::string_view IniSectionCursor::GetValue() const
+{
+    const char* value = ini_property_value(m_IniPtr, m_SectionID, m_PropertyID);
+    return (value != nullptr) ? std::string_view(value) : std::string_view();
+}
+
+bool IniSectionCursor::KeyEquals(const char* key) const
+{
+    const char* name = ini_property_name(m_IniPtr, m_SectionID, m_PropertyID);
+    return ( (name != nullptr) && (_stricmp(name, key) == 0) );
+}
+
+int IniSectionCursor::GetValueInt() const
+{
+    return Ini::ParseInt(GetValue());
+}
+
+bool IniSectionCursor::GetValueBool() const
+{
+    return Ini::ParseBool(GetValue());
+}
 //C++ Interface end. Below is normal ini.h code
 
 /**
@@ -618,6 +956,7 @@ the length is determined automatically, but in this case `value` has to be zero-
 #define INITIAL_CAPACITY ( 256 )
 
 #include <stddef.h>
+#include <string.h>
 
 #ifndef INI_MALLOC
     #include <stdlib.h>
@@ -650,6 +989,15 @@ struct ini_internal_section_t
     {
     char name[ 32 ];
     char* name_large;
+
+    /* Desktop+: per-section property index. property_list holds the global property indices belonging to this section in
+       section order (list position == property index as used by the API). property_hash is an open-addressing table of 
+       list positions + 1 (0 is an empty slot), keyed by the case-folded property name. */
+    int* property_list;
+    int property_list_count;
+    int property_list_capacity;
+    int* property_hash;
+    int property_hash_capacity;
     };
 
 
@@ -673,26 +1021,254 @@ struct ini_t
     int property_capacity;
     int property_count;
 
+    /* Desktop+: open-addressing table of section indices + 1 (0 is an empty slot), keyed by the case-folded section name */
+    int* section_hash;
+    int section_hash_capacity;
+
     void* memctx;
     };
 
 
-static int ini_internal_property_index( ini_t const* ini, int section, int property )
+/* Desktop+: hashed section and property lookup
+   Finding a property used to scan every property in the file, which made loading profiles with many overlays quadratic.
+   Sections now keep a list of their properties plus a hash table on top of it. The tables are kept up to date by the
+   add/rename functions. Removal reorders the global property array, so the affected lists are rebuilt from it instead. */
+
+#define INI_HASH_MIN_CAPACITY ( 16 )
+
+static unsigned int ini_internal_hash( char const* name, int length )
     {
+    unsigned int hash;
+    unsigned char c;
     int i;
-    int p;
 
-    if( ini && section >= 0 && section < ini->section_count )
+    /* FNV-1a on ASCII-lowercased characters, matching the case-insensitivity of INI_STRNICMP */
+    hash = 2166136261u;
+    for( i = 0; i < length; ++i )
         {
-        p = 0;
-        for( i = 0; i < ini->property_count; ++i )
+        c = (unsigned char) name[ i ];
+        if( c >= 'A' && c <= 'Z' ) c = (unsigned char)( c + ( 'a' - 'A' ) );
+        hash ^= c;
+        hash *= 16777619u;
+        }
+
+    return hash;
+    }
+
+
+static int ini_internal_name_equals( char const* name, int length, char const* other )
+    {
+    return ( INI_STRNICMP( name, other, length ) == 0 ) && ( other[ length ] == '\0' );
+    }
+
+
+static char const* ini_internal_section_name( ini_t const* ini, int section )
+    {
+    return ini->sections[ section ].name_large ? ini->sections[ section ].name_large : ini->sections[ section ].name;
+    }
+
+
+static char const* ini_internal_property_name( ini_t const* ini, int property_global )
+    {
+    return ini->properties[ property_global ].name_large ? ini->properties[ property_global ].name_large : ini->properties[ property_global ].name;
+    }
+
+
+static int ini_internal_hash_capacity_for( int count )
+    {
+    int capacity;
+
+    /* Keep load factor at or below 0.5 */
+    capacity = INI_HASH_MIN_CAPACITY;
+    while( capacity < count * 2 )
+        capacity *= 2;
+
+    return capacity;
+    }
+
+
+/* Makes sure the table has room for count entries. Returns 1 if it was reallocated, in which case it's empty and needs to be refilled */
+static int ini_internal_hash_reserve( ini_t* ini, int** table, int* capacity, int count )
+    {
+    int new_capacity;
+
+    if( *table && count * 2 <= *capacity )
+        return 0;
+
+    new_capacity = ini_internal_hash_capacity_for( count );
+    if( *table ) INI_FREE( ini->memctx, *table );
+    *table = (int*) INI_MALLOC( ini->memctx, new_capacity * sizeof( int ) );
+    memset( *table, 0, new_capacity * sizeof( int ) );
+    *capacity = new_capacity;
+
+    return 1;
+    }
+
+
+static void ini_internal_section_hash_insert( ini_t* ini, int section )
+    {
+    char const* name;
+    int length;
+    unsigned int mask;
+    unsigned int slot;
+
+    name = ini_internal_section_name( ini, section );
+    length = (int) INI_STRLEN( name );
+    mask = (unsigned int) ini->section_hash_capacity - 1;
+    slot = ini_internal_hash( name, length ) & mask;
+
+    while( ini->section_hash[ slot ] != 0 )
+        {
+        /* Duplicate names are allowed, but lookups return the one with the lowest index like the linear search did */
+        if( ini_internal_name_equals( name, length, ini_internal_section_name( ini, ini->section_hash[ slot ] - 1 ) ) )
+            return;
+
+        slot = ( slot + 1 ) & mask;
+        }
+
+    ini->section_hash[ slot ] = section + 1;
+    }
+
+
+static void ini_internal_section_hash_rebuild( ini_t* ini )
+    {
+    int s;
+
+    if( !ini_internal_hash_reserve( ini, &ini->section_hash, &ini->section_hash_capacity, ini->section_count ) )
+        memset( ini->section_hash, 0, ini->section_hash_capacity * sizeof( int ) );
+
+    for( s = 0; s < ini->section_count; ++s )
+        ini_internal_section_hash_insert( ini, s );
+    }
+
+
+static void ini_internal_property_hash_insert( ini_t* ini, int section, int list_pos )
+    {
+    struct ini_internal_section_t* sec;
+    char const* name;
+    int length;
+    unsigned int mask;
+    unsigned int slot;
+
+    sec = &ini->sections[ section ];
+    name = ini_internal_property_name( ini, sec->property_list[ list_pos ] );
+    length = (int) INI_STRLEN( name );
+    mask = (unsigned int) sec->property_hash_capacity - 1;
+    slot = ini_internal_hash( name, length ) & mask;
+
+    while( sec->property_hash[ slot ] != 0 )
+        {
+        /* Same as with sections, first property with a given name wins */
+        if( ini_internal_name_equals( name, length, ini_internal_property_name( ini, sec->property_list[ sec->property_hash[ slot ] - 1 ] ) ) )
+            return;
+
+        slot = ( slot + 1 ) & mask;
+        }
+
+    sec->property_hash[ slot ] = list_pos + 1;
+    }
+
+
+static void ini_internal_property_hash_rebuild( ini_t* ini, int section )
+    {
+    struct ini_internal_section_t* sec;
+    int i;
+
+    sec = &ini->sections[ section ];
+
+    if( !ini_internal_hash_reserve( ini, &sec->property_hash, &sec->property_hash_capacity, sec->property_list_count ) )
+        memset( sec->property_hash, 0, sec->property_hash_capacity * sizeof( int ) );
+
+    for( i = 0; i < sec->property_list_count; ++i )
+        ini_internal_property_hash_insert( ini, section, i );
+    }
+
+
+static void ini_internal_property_list_push( ini_t* ini, int section, int property_global )
+    {
+    struct ini_internal_section_t* sec;
+    int* new_list;
+
+    sec = &ini->sections[ section ];
+
+    if( sec->property_list_count >= sec->property_list_capacity )
+        {
+        sec->property_list_capacity = ( sec->property_list_capacity > 0 ) ? sec->property_list_capacity * 2 : INI_HASH_MIN_CAPACITY;
+        new_list = (int*) INI_MALLOC( ini->memctx, sec->property_list_capacity * sizeof( int ) );
+        if( sec->property_list )
             {
-            if( ini->properties[ i ].section == section )
-                {
-                if( p == property ) return i;
-                ++p;
-                }
+            INI_MEMCPY( new_list, sec->property_list, sec->property_list_count * sizeof( int ) );
+            INI_FREE( ini->memctx, sec->property_list );
             }
+        sec->property_list = new_list;
+        }
+
+    sec->property_list[ sec->property_list_count++ ] = property_global;
+    }
+
+
+static void ini_internal_section_index_init( struct ini_internal_section_t* sec )
+    {
+    sec->property_list = 0;
+    sec->property_list_count = 0;
+    sec->property_list_capacity = 0;
+    sec->property_hash = 0;
+    sec->property_hash_capacity = 0;
+    }
+
+
+static void ini_internal_section_index_free( ini_t* ini, struct ini_internal_section_t* sec )
+    {
+    if( sec->property_list ) INI_FREE( ini->memctx, sec->property_list );
+    if( sec->property_hash ) INI_FREE( ini->memctx, sec->property_hash );
+    ini_internal_section_index_init( sec );
+    }
+
+
+/* Rebuilds property lists and tables of the given sections from the global property array (section_b may be INI_NOT_FOUND) */
+static void ini_internal_property_index_rebuild( ini_t* ini, int section_a, int section_b )
+    {
+    int p;
+
+    if( section_a != INI_NOT_FOUND ) ini->sections[ section_a ].property_list_count = 0;
+    if( section_b != INI_NOT_FOUND ) ini->sections[ section_b ].property_list_count = 0;
+
+    for( p = 0; p < ini->property_count; ++p )
+        {
+        if( ini->properties[ p ].section == section_a || ini->properties[ p ].section == section_b )
+            ini_internal_property_list_push( ini, ini->properties[ p ].section, p );
+        }
+
+    if( section_a != INI_NOT_FOUND ) ini_internal_property_hash_rebuild( ini, section_a );
+    if( section_b != INI_NOT_FOUND && section_b != section_a ) ini_internal_property_hash_rebuild( ini, section_b );
+    }
+
+
+/* Rebuilds the entire index, used after removing a section since that can shuffle properties of all sections */
+static void ini_internal_index_rebuild( ini_t* ini )
+    {
+    int s;
+    int p;
+
+    for( s = 0; s < ini->section_count; ++s )
+        ini->sections[ s ].property_list_count = 0;
+
+    for( p = 0; p < ini->property_count; ++p )
+        ini_internal_property_list_push( ini, ini->properties[ p ].section, p );
+
+    for( s = 0; s < ini->section_count; ++s )
+        ini_internal_property_hash_rebuild( ini, s );
+
+    ini_internal_section_hash_rebuild( ini );
+    }
+
+
+static int ini_internal_property_index( ini_t const* ini, int section, int property )
+    {
+    if( ini && section >= 0 && section < ini->section_count )
+        {
+        if( property >= 0 && property < ini->sections[ section ].property_list_count )
+            return ini->sections[ section ].property_list[ property ];
         }
 
     return INI_NOT_FOUND;
@@ -710,9 +1286,13 @@ ini_t* ini_create( void* memctx )
     ini->section_count = 1; /* global section */
     ini->sections[ 0 ].name[ 0 ] = '\0'; 
     ini->sections[ 0 ].name_large = 0;
+    ini_internal_section_index_init( &ini->sections[ 0 ] );
     ini->properties = (struct ini_internal_property_t*) INI_MALLOC( ini->memctx, INITIAL_CAPACITY * sizeof( ini->properties[ 0 ] ) );
     ini->property_capacity = INITIAL_CAPACITY;
     ini->property_count = 0;
+    ini->section_hash = 0;
+    ini->section_hash_capacity = 0;
+    ini_internal_section_hash_rebuild( ini );
     return ini;
     }
 
@@ -802,6 +1382,7 @@ int ini_save( ini_t const* ini, char* data, int size )
     int s;
     int p;
     int i;
+    int k;
     int l;
     char* n;
     int pos;
@@ -828,29 +1409,27 @@ int ini_save( ini_t const* ini, char* data, int size )
                 ++pos;
                 }
 
-            for( p = 0; p < ini->property_count; ++p )
+            for( k = 0; k < ini->sections[ s ].property_list_count; ++k ) /* Desktop+: walk the section's list instead of all properties */
                 {
-                if( ini->properties[ p ].section == s )
+                p = ini->sections[ s ].property_list[ k ];
+                n = ini->properties[ p ].name_large ? ini->properties[ p ].name_large : ini->properties[ p ].name;
+                l = (int) INI_STRLEN( n );
+                for( i = 0; i < l; ++i )
                     {
-                    n = ini->properties[ p ].name_large ? ini->properties[ p ].name_large : ini->properties[ p ].name;
-                    l = (int) INI_STRLEN( n );
-                    for( i = 0; i < l; ++i )
-                        {
-                        if( data && pos < size ) data[ pos ] = n[ i ];
-                        ++pos;
-                        }
-                    if( data && pos < size ) data[ pos ] = '=';
+                    if( data && pos < size ) data[ pos ] = n[ i ];
                     ++pos;
-                    n = ini->properties[ p ].value_large ? ini->properties[ p ].value_large : ini->properties[ p ].value;
-                    l = (int) INI_STRLEN( n );
-                    for( i = 0; i < l; ++i )
-                        {
-                        if( data && pos < size ) data[ pos ] = n[ i ];
-                        ++pos;
-                        }
-                    if( data && pos < size ) data[ pos ] = '\n';
+                    }
+                if( data && pos < size ) data[ pos ] = '=';
+                ++pos;
+                n = ini->properties[ p ].value_large ? ini->properties[ p ].value_large : ini->properties[ p ].value;
+                l = (int) INI_STRLEN( n );
+                for( i = 0; i < l; ++i )
+                    {
+                    if( data && pos < size ) data[ pos ] = n[ i ];
                     ++pos;
                     }
+                if( data && pos < size ) data[ pos ] = '\n';
+                ++pos;
                 }
 
             if( pos > 0 )
@@ -870,6 +1449,162 @@ int ini_save( ini_t const* ini, char* data, int size )
     }
 
 
+/* Desktop+: snapshot format
+   Compact binary form of the parsed file so it can be restored without tokenizing the text again. Layout is the section 
+   count and names (excluding the global section) followed by the property count and section/name/value of each property 
+   in section order. All integers are 32-bit in native byte order and strings are stored without terminator. */
+
+static void ini_internal_snapshot_write( char* data, int size, int* pos, void const* src, int count )
+    {
+    if( data && *pos + count <= size ) INI_MEMCPY( data + *pos, src, (size_t) count );
+    *pos += count;
+    }
+
+
+/* Grows section and property arrays up front so loading a snapshot doesn't have to repeatedly reallocate them */
+static void ini_internal_reserve( ini_t* ini, int section_capacity, int property_capacity )
+    {
+    struct ini_internal_section_t* new_sections;
+    struct ini_internal_property_t* new_properties;
+
+    if( section_capacity > ini->section_capacity )
+        {
+        new_sections = (struct ini_internal_section_t*) INI_MALLOC( ini->memctx, section_capacity * sizeof( ini->sections[ 0 ] ) );
+        INI_MEMCPY( new_sections, ini->sections, ini->section_count * sizeof( ini->sections[ 0 ] ) );
+        INI_FREE( ini->memctx, ini->sections );
+        ini->sections = new_sections;
+        ini->section_capacity = section_capacity;
+        }
+
+    if( property_capacity > ini->property_capacity )
+        {
+        new_properties = (struct ini_internal_property_t*) INI_MALLOC( ini->memctx, property_capacity * sizeof( ini->properties[ 0 ] ) );
+        INI_MEMCPY( new_properties, ini->properties, ini->property_count * sizeof( ini->properties[ 0 ] ) );
+        INI_FREE( ini->memctx, ini->properties );
+        ini->properties = new_properties;
+        ini->property_capacity = property_capacity;
+        }
+    }
+
+
+static int ini_internal_snapshot_read_int( char const* data, int size, int* pos, int* value )
+    {
+    if( *pos < 0 || size - *pos < (int) sizeof( *value ) ) return 0;
+    INI_MEMCPY( value, data + *pos, sizeof( *value ) );
+    *pos += (int) sizeof( *value );
+    return 1;
+    }
+
+
+static char const* ini_internal_snapshot_read_string( char const* data, int size, int* pos, int* length )
+    {
+    char const* str;
+
+    if( !ini_internal_snapshot_read_int( data, size, pos, length ) ) return NULL;
+    if( *length < 0 || size - *pos < *length ) return NULL;
+    str = data + *pos;
+    *pos += *length;
+    return str;
+    }
+
+
+int ini_save_snapshot( ini_t const* ini, char* data, int size )
+    {
+    int s;
+    int k;
+    int p;
+    int l;
+    int count;
+    char const* n;
+    int pos;
+
+    if( ini )
+        {
+        pos = 0;
+        count = ini->section_count - 1;
+        ini_internal_snapshot_write( data, size, &pos, &count, sizeof( count ) );
+        for( s = 1; s < ini->section_count; ++s )
+            {
+            n = ini_internal_section_name( ini, s );
+            l = (int) INI_STRLEN( n );
+            ini_internal_snapshot_write( data, size, &pos, &l, sizeof( l ) );
+            ini_internal_snapshot_write( data, size, &pos, n, l );
+            }
+
+        ini_internal_snapshot_write( data, size, &pos, &ini->property_count, sizeof( ini->property_count ) );
+        for( s = 0; s < ini->section_count; ++s )
+            {
+            for( k = 0; k < ini->sections[ s ].property_list_count; ++k )
+                {
+                p = ini->sections[ s ].property_list[ k ];
+                ini_internal_snapshot_write( data, size, &pos, &s, sizeof( s ) );
+                n = ini_internal_property_name( ini, p );
+                l = (int) INI_STRLEN( n );
+                ini_internal_snapshot_write( data, size, &pos, &l, sizeof( l ) );
+                ini_internal_snapshot_write( data, size, &pos, n, l );
+                n = ini->properties[ p ].value_large ? ini->properties[ p ].value_large : ini->properties[ p ].value;
+                l = (int) INI_STRLEN( n );
+                ini_internal_snapshot_write( data, size, &pos, &l, sizeof( l ) );
+                ini_internal_snapshot_write( data, size, &pos, n, l );
+                }
+            }
+
+        return pos;
+        }
+
+    return 0;
+    }
+
+
+/* Returns NULL if the data is not a well-formed snapshot */
+ini_t* ini_load_snapshot( char const* data, int size, void* memctx )
+    {
+    ini_t* ini;
+    int pos;
+    int count;
+    int i;
+    int s;
+    char const* name;
+    char const* value;
+    int name_length;
+    int value_length;
+
+    if( !data || size <= 0 ) return NULL;
+
+    ini = ini_create( memctx );
+    pos = 0;
+
+    if( !ini_internal_snapshot_read_int( data, size, &pos, &count ) || count < 0 || count >= size ) goto fail;
+    ini_internal_reserve( ini, count + 1, 0 );
+    for( i = 0; i < count; ++i )
+        {
+        name = ini_internal_snapshot_read_string( data, size, &pos, &name_length );
+        if( !name ) goto fail;
+        ini_section_add( ini, name_length > 0 ? name : "", name_length ); /* length 0 would make it read up to the next null byte */
+        }
+
+    if( !ini_internal_snapshot_read_int( data, size, &pos, &count ) || count < 0 || count >= size ) goto fail;
+    ini_internal_reserve( ini, 0, count );
+    for( i = 0; i < count; ++i )
+        {
+        if( !ini_internal_snapshot_read_int( data, size, &pos, &s ) || s < 0 || s >= ini->section_count ) goto fail;
+        name = ini_internal_snapshot_read_string( data, size, &pos, &name_length );
+        if( !name ) goto fail;
+        value = ini_internal_snapshot_read_string( data, size, &pos, &value_length );
+        if( !value ) goto fail;
+        ini_property_add( ini, s, name_length > 0 ? name : "", name_length, value, value_length );
+        }
+
+    if( pos != size ) goto fail;
+
+    return ini;
+
+fail:
+    ini_destroy( ini );
+    return NULL;
+    }
+
+
 void ini_destroy( ini_t* ini )
     {
     int i;
@@ -882,7 +1617,11 @@ void ini_destroy( ini_t* ini )
             if( ini->properties[ i ].name_large ) INI_FREE( ini->memctx, ini->properties[ i ].name_large );
             }
         for( i = 0; i < ini->section_count; ++i )
+            {
             if( ini->sections[ i ].name_large ) INI_FREE( ini->memctx, ini->sections[ i ].name_large );
+            ini_internal_section_index_free( ini, &ini->sections[ i ] );
+            }
+        if( ini->section_hash ) INI_FREE( ini->memctx, ini->section_hash );
         INI_FREE( ini->memctx, ini->properties );
         INI_FREE( ini->memctx, ini->sections );
         INI_FREE( ini->memctx, ini );
@@ -908,18 +1647,8 @@ char const* ini_section_name( ini_t const* ini, int section )
 
 int ini_property_count( ini_t const* ini, int section )
     {
-    int i;
-    int count;
-
-    if( ini )
-        {
-        count = 0;
-        for( i = 0; i < ini->property_count; ++i )
-            {
-            if( ini->properties[ i ].section == section ) ++count;
-            }
-        return count;
-        }
+    if( ini && section >= 0 && section < ini->section_count )
+        return ini->sections[ section ].property_list_count;
 
     return 0;
     }
@@ -957,17 +1686,20 @@ char const* ini_property_value( ini_t const* ini, int section, int property )
 
 int ini_find_section( ini_t const* ini, char const* name, int name_length )
     {
-    int i;
+    unsigned int mask;
+    unsigned int slot;
 
-    if( ini && name )
+    if( ini && name && ini->section_hash )
         {
         if( name_length <= 0 ) name_length = (int) INI_STRLEN( name );
-        for( i = 0; i < ini->section_count; ++i )
+        mask = (unsigned int) ini->section_hash_capacity - 1;
+        slot = ini_internal_hash( name, name_length ) & mask;
+        while( ini->section_hash[ slot ] != 0 )
             {
-            char const* const other = 
-                ini->sections[ i ].name_large ? ini->sections[ i ].name_large : ini->sections[ i ].name;
-            if( ( INI_STRNICMP( name, other, name_length ) == 0 ) && ( other[name_length] == '\0' ) )
-                return i;
+            if( ini_internal_name_equals( name, name_length, ini_internal_section_name( ini, ini->section_hash[ slot ] - 1 ) ) )
+                return ini->section_hash[ slot ] - 1;
+
+            slot = ( slot + 1 ) & mask;
             }
         }
 
@@ -977,23 +1709,24 @@ int ini_find_section( ini_t const* ini, char const* name, int name_length )
 
 int ini_find_property( ini_t const* ini, int section, char const* name, int name_length )
     {
-    int i;
-    int c;
+    struct ini_internal_section_t const* sec;
+    unsigned int mask;
+    unsigned int slot;
 
     if( ini && name && section >= 0 && section < ini->section_count)
         {
+        sec = &ini->sections[ section ];
+        if( !sec->property_hash ) return INI_NOT_FOUND;
+
         if( name_length <= 0 ) name_length = (int) INI_STRLEN( name );
-        c = 0;
-        for( i = 0; i < ini->property_count; ++i )
+        mask = (unsigned int) sec->property_hash_capacity - 1;
+        slot = ini_internal_hash( name, name_length ) & mask;
+        while( sec->property_hash[ slot ] != 0 )
             {
-            if( ini->properties[ i ].section == section )
-                {
-                char const* const other = 
-                    ini->properties[ i ].name_large ? ini->properties[ i ].name_large : ini->properties[ i ].name;
-                if( ( INI_STRNICMP( name, other, name_length ) == 0 ) && ( other[name_length] == '\0' ) )
-                    return c;
-                ++c;
-                }
+            if( ini_internal_name_equals( name, name_length, ini_internal_property_name( ini, sec->property_list[ sec->property_hash[ slot ] - 1 ] ) ) )
+                return sec->property_hash[ slot ] - 1;
+
+            slot = ( slot + 1 ) & mask;
             }
         }
 
@@ -1031,6 +1764,18 @@ int ini_section_add( ini_t* ini, char const* name, int length )
             ini->sections[ ini->section_count ].name[ length ] = '\0';
             }
 
+        ini_internal_section_index_init( &ini->sections[ ini->section_count ] );
+
+        /* Desktop+: keep section table up to date, growing it if needed */
+        if( ini_internal_hash_reserve( ini, &ini->section_hash, &ini->section_hash_capacity, ini->section_count + 1 ) )
+            {
+            ++ini->section_count;
+            ini_internal_section_hash_rebuild( ini );
+            return ini->section_count - 1;
+            }
+
+        ini_internal_section_hash_insert( ini, ini->section_count );
+
         return ini->section_count++;
         }
     return INI_NOT_FOUND;
@@ -1085,6 +1830,18 @@ void ini_property_add( ini_t* ini, int section, char const* name, int name_lengt
             ini->properties[ ini->property_count ].value[ value_length ] = '\0';
             }
 
+        /* Desktop+: append to the section's property list and table */
+        ini_internal_property_list_push( ini, section, ini->property_count );
+        if( ini_internal_hash_reserve( ini, &ini->sections[ section ].property_hash, &ini->sections[ section ].property_hash_capacity, 
+                                       ini->sections[ section ].property_list_count ) )
+            {
+            ++ini->property_count;
+            ini_internal_property_hash_rebuild( ini, section );
+            return;
+            }
+
+        ini_internal_property_hash_insert( ini, section, ini->sections[ section ].property_list_count - 1 );
+
         ++ini->property_count;
         }
     }
@@ -1097,6 +1854,7 @@ void ini_section_remove( ini_t* ini, int section )
     if( ini && section >= 0 && section < ini->section_count )
         {
         if( ini->sections[ section ].name_large ) INI_FREE( ini->memctx, ini->sections[ section ].name_large );
+        ini_internal_section_index_free( ini, &ini->sections[ section ] );
         for( p = ini->property_count - 1; p >= 0; --p ) 
             {
             if( ini->properties[ p ].section == section )
@@ -1114,6 +1872,9 @@ void ini_section_remove( ini_t* ini, int section )
             if( ini->properties[ p ].section == ini->section_count )
                 ini->properties[ p ].section = section;
             }
+
+        /* Desktop+: properties of any section may have been moved around, so rebuild everything */
+        ini_internal_index_rebuild( ini );
         }
     }
 
@@ -1121,6 +1882,7 @@ void ini_section_remove( ini_t* ini, int section )
 void ini_property_remove( ini_t* ini, int section, int property )
     {
     int p;
+    int section_moved;
 
     if( ini && section >= 0 && section < ini->section_count )
         {
@@ -1130,6 +1892,10 @@ void ini_property_remove( ini_t* ini, int section, int property )
             if( ini->properties[ p ].value_large ) INI_FREE( ini->memctx, ini->properties[ p ].value_large );
             if( ini->properties[ p ].name_large ) INI_FREE( ini->memctx, ini->properties[ p ].name_large );
             ini->properties[ p ] = ini->properties[ --ini->property_count  ];
+
+            /* Desktop+: only this section and the one of the moved property are affected */
+            section_moved = ( p < ini->property_count ) ? ini->properties[ p ].section : INI_NOT_FOUND;
+            ini_internal_property_index_rebuild( ini, section, section_moved );
             return;
             }
         }
@@ -1155,6 +1921,8 @@ void ini_section_name_set( ini_t* ini, int section, char const* name, int length
             INI_MEMCPY( ini->sections[ section ].name, name, (size_t) length );
             ini->sections[ section ].name[ length ] = '\0';
             }
+
+        ini_internal_section_hash_rebuild( ini );
         }
     }
 
@@ -1183,6 +1951,8 @@ void ini_property_name_set( ini_t* ini, int section, int property, char const* n
                 INI_MEMCPY( ini->properties[ p ].name, name, (size_t) length );
                 ini->properties[ p ].name[ length ] = '\0';
                 }
+
+            ini_internal_property_hash_rebuild( ini, section );
             }
         }
     }
@@ -3,25 +3,62 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 typedef struct ini_t ini_t;
 
+//Walks all key/value pairs of a single section in file order without any allocations
+//Views returned by this are only valid until the Ini they were taken from is modified or destroyed
+class IniSectionCursor
+{
+    friend class Ini;
+
+    private:
+        const ini_t* m_IniPtr;
+        int m_SectionID;
+        int m_PropertyID;
+        int m_PropertyCount;
+
+        IniSectionCursor(const ini_t* ini_ptr, int section_id);
+
+    public:
+        bool IsValid() const;                                       //False if the section doesn't exist
+        bool Next();                                                //Advances to the next pair, returns false if there are none left. Call before first access
+        std::string_view GetKey() const;
+        std::string_view GetValue() const;
+        bool KeyEquals(const char* key) const;                      //Case-insensitive like regular key lookups
+        int GetValueInt() const;
+        bool GetValueBool() const;
+};
+
 class Ini
 {
     private:
         std::wstring m_WFileName;
         ini_t* m_IniPtr;
+        bool m_UseSnapshotCache;
+
+        const char* FindValue(const char* section, const char* key) const;     //Returns nullptr if the key doesn't exist
+
+        bool LoadSnapshot();
+        void SaveSnapshot(const std::wstring& filename, const char* source_data, size_t source_size) const;
+        bool WriteContents(const std::wstring& filename, const std::string& contents) const;
 
     public:
-        Ini(const std::wstring& filename, bool replace_contents = false);
+        //With use_snapshot_cache, a binary snapshot of the parsed file is kept next to it and used instead of the text while it's up-to-date
+        Ini(const std::wstring& filename, bool replace_contents = false, bool use_snapshot_cache = false);
         Ini(const Ini&) = delete;
         ~Ini();
 
-        bool Save();
+        bool Save();                                    //Writes to a temporary file first and swaps it in, so the file is never left partially written
         bool Save(const std::wstring& filename);
+        bool SaveIfChanged(std::string& last_contents); //Skips writing if the contents are the same as last_contents, which is updated after writing
+        std::string GetContents() const;                //Text the file would be saved as
+        const std::wstring& GetFileName() const;
 
         std::string ReadString(const char* section, const char* key, const char* default_value = "") const;
+        std::string_view ReadStringView(const char* section, const char* key, std::string_view default_value = {}) const; //View is valid until the Ini is modified
         int ReadInt(const char* section, const char* key, int default_value = -1) const;
         bool ReadBool(const char* section, const char* key, bool default_value = false) const;
         void WriteString(const char* section, const char* key, const char* value);
@@ -35,4 +72,11 @@ class Ini
         void RemoveKey(const char* section, const char* key);
 
         std::vector<std::string> GetSectionList();
+        IniSectionCursor GetSectionCursor(const char* section) const;
+
+        static std::wstring GetSnapshotFileName(const std::wstring& filename);
+        static void DeleteSnapshot(const std::wstring& filename);
+
+        static int ParseInt(std::string_view str);      //Same results as atoi()
+        static bool ParseBool(std::string_view str);    //"true" and "false" or anything atoi() turns into non-zero
 };
\ No newline at end of file
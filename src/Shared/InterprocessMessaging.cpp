@@ -1,16 +1,142 @@
 #include "InterprocessMessaging.h"
 
+#include <algorithm>
+#include <fstream>
+
 #include "Util.h"
+#include "Logging.h"
+#include "ConfigDelta.h"
+#include "IPCStats.h"
+#include "IPCRingBenchmark.h"
 #include "DPBrowserAPIClient.h"
 
 static IPCManager g_IPCManager;
 
-IPCManager::IPCManager()
+static const uint32_t k_IPCRingCapacity     = 256 * 1024;   //Fits about as many messages as a window message queue (10000 by default)
+static const uint32_t k_IPCRingTypeCopyData = 0x10000;      //Record type of WM_COPYDATA data, outside of the IPCMsgID range
+
+//Payload of ring buffer records, record type is the IPCMsgID
+struct IPCRingMessage
+{
+    uint64_t WParam;
+    int64_t LParam;
+    int64_t Timestamp;      //IPCStats::GetTimestamp() when sent or 0 if stats are disabled
+};
+
+//Payload header of k_IPCRingTypeCopyData records, followed by the data
+struct IPCRingCopyData
+{
+    uint64_t DataID;        //COPYDATASTRUCT::dwData
+    uint64_t SourceWindow;  //wParam of WM_COPYDATA
+    int64_t Timestamp;      //IPCStats::GetTimestamp() when sent or 0 if stats are disabled
+    uint32_t StatsChannel;
+    uint32_t StatsID;
+};
+
+static IPCStatsChannel IPCManagerGetStatsChannel(IPCMsgID IPC_id)
+{
+    return (IPC_id == ipcmsg_set_config) ? ipcstats_config : (IPC_id == ipcmsg_elevated_action) ? ipcstats_elevated_action : ipcstats_action;
+}
+
+enum IPCManagerQueueMode
+{
+    ipcmanager_queue_none,          //Sent right away, after any queued messages
+    ipcmanager_queue_replace,       //Queued, replacing a queued message with the same IPCMsgID and wParam
+    ipcmanager_queue_accumulate     //Queued, merged with the last queued message if it's the same adjustment
+};
+
+static IPCManagerQueueMode IPCManagerGetQueueMode(IPCMsgID IPC_id, WPARAM w_param)
+{
+    switch (IPC_id)
+    {
+        case ipcmsg_action:
+        {
+            return (w_param == ipcact_overlay_position_adjust) ? ipcmanager_queue_accumulate : ipcmanager_queue_none;
+        }
+        case ipcmsg_set_config:
+        {
+            //Float values are only ever set, while other types are also used to trigger things on change
+            return ( (w_param >= configid_bool_MAX + configid_int_MAX) && (w_param < configid_bool_MAX + configid_int_MAX + configid_float_MAX) ) ? ipcmanager_queue_replace :
+                                                                                                                                               ipcmanager_queue_none;
+        }
+        case ipcmsg_elevated_action:
+        {
+            return ( (w_param == ipceact_mouse_move) || (w_param == ipceact_pen_move) ) ? ipcmanager_queue_replace : ipcmanager_queue_none;
+        }
+        default: return ipcmanager_queue_none;
+    }
+}
+
+static IPCMessageLane IPCManagerGetMessageLane(IPCMsgID IPC_id, WPARAM w_param)
+{
+    switch (IPC_id)
+    {
+        case ipcmsg_action:
+        {
+            switch (w_param)
+            {
+                case ipcact_keyboard_vkey:
+                case ipcact_keyboard_wchar:
+                case ipcact_lpointer_trigger_haptics:
+                {
+                    return ipclane_input;
+                }
+                case ipcact_overlay_profile_load:
+                case ipcact_overlay_transform_sync:
+                case ipcact_action_delete:
+                case ipcact_app_profile_remove:
+                case ipcact_global_shortcut_set:
+                case ipcact_hotkey_set:
+                case ipcact_sync_config_state:
+                case ipcact_config_delta_apply:
+                {
+                    return ipclane_bulk;
+                }
+                default: return ipclane_default;
+            }
+        }
+        case ipcmsg_elevated_action:
+        {
+            //Almost everything sent to the elevated mode process is input. Launching applications depends on the strings sent before, which aren't in the input lane
+            return ( (w_param == ipceact_launch_application) || (w_param == ipceact_window_topmost_set) ) ? ipclane_default : ipclane_input;
+        }
+        default: return ipclane_default;
+    }
+}
+
+static IPCMessageLane IPCManagerGetCopyDataLane(IPCStatsChannel stats_channel, size_t stats_id)
+{
+    switch (stats_channel)
+    {
+        case ipcstats_elevated_string:
+        {
+            //Keyboard text and input batches need to stay in order with other elevated mode input
+            return ( (stats_id == ipcestrid_launch_application_path) || (stats_id == ipcestrid_launch_application_arg) ) ? ipclane_default : ipclane_input;
+        }
+        case ipcstats_config_string:
+        {
+            //VR keyboard text needs to stay in order with the keyboard key messages in the input lane
+            return (stats_id == configid_str_state_keyboard_string) ? ipclane_input : ipclane_default;
+        }
+        case ipcstats_config_delta: return ipclane_bulk;
+        default:                    return ipclane_default;
+    }
+}
+
+static std::string IPCManagerGetRingName(IPCPeerID sender_id, IPCPeerID receiver_id)
+{
+    static const char* const peer_names[ipcpeer_MAX] = {"Dashboard", "UI", "Elevated"};
+
+    return std::string("DesktopPlusIPCRing_") + peer_names[sender_id] + "_" + peer_names[receiver_id];
+}
+
+IPCManager::IPCManager() : m_TransportPeerID(ipcpeer_MAX), m_TransportThreadID(0), m_ReceiveBudgetUs(0), m_ReceiveBudgetUsedUs(0)
 {
     //Register messages
     m_RegisteredMessages[ipcmsg_action]          = ::RegisterWindowMessage(L"WMIPC_DPLUS_Action");
     m_RegisteredMessages[ipcmsg_set_config]      = ::RegisterWindowMessage(L"WMIPC_DPLUS_SetConfig");
     m_RegisteredMessages[ipcmsg_elevated_action] = ::RegisterWindowMessage(L"WMIPC_DPLUS_ElevatedAction");
+    m_RegisteredMessages[ipcmsg_ring_doorbell]   = ::RegisterWindowMessage(L"WMIPC_DPLUS_RingDoorbell");
 }
 
 IPCManager& IPCManager::Get()
@@ -67,24 +193,24 @@ bool IPCManager::GetAllMesssagesRegistered() const
 
 bool IPCManager::IsDashboardAppRunning()
 {
-    return (::FindWindow(g_WindowClassNameDashboardApp, nullptr) != 0);
+    return (Get().GetPeerWindow(ipcpeer_dashboard_app) != nullptr);
 }
 
 bool IPCManager::IsUIAppRunning()
 {
-    return (::FindWindow(g_WindowClassNameUIApp, nullptr) != 0);
+    return (Get().GetPeerWindow(ipcpeer_ui_app) != nullptr);
 }
 
 bool IPCManager::IsElevatedModeProcessRunning()
 {
-    return (::FindWindow(g_WindowClassNameElevatedMode, nullptr) != 0);
+    return (Get().GetPeerWindow(ipcpeer_elevated_mode) != nullptr);
 }
 
 DWORD IPCManager::GetDashboardAppProcessID()
 {
     DWORD pid = 0;
 
-    if (HWND window = ::FindWindow(g_WindowClassNameDashboardApp, nullptr))
+    if (HWND window = Get().GetPeerWindow(ipcpeer_dashboard_app))
     {
         ::GetWindowThreadProcessId(window, &pid);
     }
@@ -96,7 +222,7 @@ DWORD IPCManager::GetUIAppProcessID()
 {
     DWORD pid = 0;
 
-    if (HWND window = ::FindWindow(g_WindowClassNameUIApp, nullptr))
+    if (HWND window = Get().GetPeerWindow(ipcpeer_ui_app))
     {
         ::GetWindowThreadProcessId(window, &pid);
     }
@@ -104,15 +230,616 @@ DWORD IPCManager::GetUIAppProcessID()
     return pid;
 }
 
-void IPCManager::PostMessageToDashboardApp(IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const
+HWND IPCManager::GetPeerWindow(IPCPeerID peer_id) const
+{
+    if (m_IsIsolatedFromPeers.load(std::memory_order_relaxed))
+        return nullptr;
+
+    PeerWindowCacheEntry& entry = m_PeerWindowCache[peer_id];
+    HWND window = entry.Window.load(std::memory_order_acquire);
+
+    //Revalidate cached window. A window handle can be reused by a restarted peer or an unrelated process, so the owning process has to match as well
+    if (window != nullptr)
+    {
+        DWORD pid = 0;
+
+        if ( (::IsWindow(window)) && (::GetWindowThreadProcessId(window, &pid) != 0) && (pid == entry.ProcessID.load(std::memory_order_acquire)) )
+        {
+            m_PeerWindowCacheHits.fetch_add(1, std::memory_order_relaxed);
+            return window;
+        }
+
+        m_PeerWindowCacheInvalidations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    LPCWSTR class_name = nullptr;
+
+    switch (peer_id)
+    {
+        case ipcpeer_dashboard_app: class_name = g_WindowClassNameDashboardApp; break;
+        case ipcpeer_ui_app:        class_name = g_WindowClassNameUIApp;        break;
+        case ipcpeer_elevated_mode: class_name = g_WindowClassNameElevatedMode; break;
+        default:                    return nullptr;
+    }
+
+    m_PeerWindowCacheLookups.fetch_add(1, std::memory_order_relaxed);
+    window = ::FindWindow(class_name, nullptr);
+
+    //Not finding the window isn't cached so a newly started peer is picked up right away
+    DWORD pid = 0;
+
+    if (window != nullptr)
+    {
+        ::GetWindowThreadProcessId(window, &pid);
+    }
+
+    //Racing threads may store a mismatching pair here, which only results in another lookup on next use
+    entry.ProcessID.store(pid, std::memory_order_release);
+    entry.Window.store(window, std::memory_order_release);
+
+    return window;
+}
+
+void IPCManager::InvalidatePeerWindow(IPCPeerID peer_id) const
+{
+    m_PeerWindowCache[peer_id].Window.store(nullptr, std::memory_order_release);
+}
+
+IPCPeerWindowCacheStats IPCManager::GetPeerWindowCacheStats() const
+{
+    IPCPeerWindowCacheStats stats;
+    stats.Hits          = m_PeerWindowCacheHits.load(std::memory_order_relaxed);
+    stats.Lookups       = m_PeerWindowCacheLookups.load(std::memory_order_relaxed);
+    stats.Invalidations = m_PeerWindowCacheInvalidations.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+void IPCManager::SetIsolatedFromPeers(bool is_isolated)
+{
+    m_IsIsolatedFromPeers.store(is_isolated, std::memory_order_relaxed);
+}
+
+void IPCManager::InitTransport(IPCPeerID own_peer_id)
+{
+    m_TransportPeerID   = own_peer_id;
+    m_TransportThreadID = ::GetCurrentThreadId();
+
+    //The elevated mode process doesn't create any ring buffers, as processes with lower integrity level could not write to them
+    //Lower privileged processes create the ones used to communicate with it instead, the others are created by the receiving process
+    const bool is_elevated_mode = (own_peer_id == ipcpeer_elevated_mode);
+
+    for (int i = 0; i < ipcpeer_MAX; ++i)
+    {
+        const IPCPeerID peer_id = (IPCPeerID)i;
+
+        if (peer_id == own_peer_id)
+            continue;
+
+        //Drop messages meant for a previous instance of this process and make sure the sender posts a doorbell for the next one
+        if (OpenRingChannel(m_RingsInbound[peer_id], peer_id, own_peer_id, !is_elevated_mode))
+        {
+            m_RingsInbound[peer_id].Ring.Discard();
+            m_RingsInbound[peer_id].Ring.ClearNotifyPending();
+        }
+
+        OpenRingChannel(m_RingsOutbound[peer_id], own_peer_id, peer_id, (peer_id == ipcpeer_elevated_mode));
+    }
+}
+
+void IPCManager::ReceiveRingMessages(const MSG& doorbell_msg, const std::function<void(const MSG&)>& handler, bool ignore_budget)
+{
+    if ( (m_TransportPeerID == ipcpeer_MAX) || (doorbell_msg.wParam >= ipcpeer_MAX) || (doorbell_msg.wParam == m_TransportPeerID) )
+        return;
+
+    const IPCPeerID sender_id = (IPCPeerID)doorbell_msg.wParam;
+    RingChannel& channel = m_RingsInbound[sender_id];
+    ReceiveQueue& queue = m_ReceiveQueues[sender_id];
+    queue.Window = doorbell_msg.hwnd;
+
+    //Ring buffers not created by this process may not have existed during InitTransport()
+    if (!channel.Ring.IsAttached())
+    {
+        const ULONGLONG tick = ::GetTickCount64();
+
+        if ( (tick < channel.NextOpenTick) || (!OpenRingChannel(channel, sender_id, m_TransportPeerID, false)) )
+        {
+            if (tick >= channel.NextOpenTick)
+            {
+                LOG_IF_F(WARNING, (channel.NextOpenTick == 0), "Failed to open IPC ring buffer from peer %d, retrying", sender_id);
+                channel.NextOpenTick = tick + 100;
+            }
+
+            //The sender doesn't post another doorbell until NotifyPending is cleared, which needs the ring buffer. Treat it as deferred so ResumeDeferredMessages() tries again
+            queue.IsDeferred = true;
+            return;
+        }
+    }
+
+    queue.IsDeferred = false;
+
+    PullRingMessages(sender_id, channel, doorbell_msg);
+
+    //Messages are removed from the lanes before calling the handler, as it may end up receiving ring messages again
+    for (;;)
+    {
+        while ( (!queue.IsInConfigTransaction) && (!queue.InputLane.empty()) )
+        {
+            ReceivedMessage received = std::move(queue.InputLane.front());
+            queue.InputLane.pop_front();
+
+            DispatchReceivedMessage(received, handler);
+        }
+
+        if (queue.OrderedLane.empty())
+            break;
+
+        //Leave the rest for the next frame if this one's budget is used up. ResumeDeferredMessages() posts another doorbell for them
+        //Open config transactions are finished first, so the overlay ID override doesn't stay active into the next frame
+        if ( (!ignore_budget) && (!queue.IsInConfigTransaction) && (m_ReceiveBudgetUs != 0) && (m_ReceiveBudgetUsedUs >= m_ReceiveBudgetUs) )
+        {
+            queue.IsDeferred = true;
+            break;
+        }
+
+        ReceivedMessage received = std::move(queue.OrderedLane.front());
+        queue.OrderedLane.pop_front();
+
+        if ( (received.Msg.message == m_RegisteredMessages[ipcmsg_action]) &&
+             ( (received.Msg.wParam == ipcact_config_transaction_begin) || (received.Msg.wParam == ipcact_config_transaction_commit) ) )
+        {
+            queue.IsInConfigTransaction = (received.Msg.wParam == ipcact_config_transaction_begin);
+        }
+
+        const int64_t handle_start = IPCStats::GetTimestamp();
+
+        DispatchReceivedMessage(received, handler);
+
+        m_ReceiveBudgetUsedUs += IPCStats::Get().GetMicrosecondsSince(handle_start);
+
+        //Pick up messages sent while this one was handled, so input doesn't wait for the rest of the ordered lane
+        PullRingMessages(sender_id, channel, doorbell_msg);
+    }
+}
+
+void IPCManager::ReceiveAllRingMessages(HWND window, const std::function<void(const MSG&)>& handler)
+{
+    if (m_TransportPeerID == ipcpeer_MAX)
+        return;
+
+    for (int i = 0; i < ipcpeer_MAX; ++i)
+    {
+        //Senders push to the ring buffer before posting the doorbell, so one that isn't open yet can't have anything sent before the WM_COPYDATA
+        if ( (i == m_TransportPeerID) || (!m_RingsInbound[i].Ring.IsAttached()) )
+            continue;
+
+        MSG doorbell_msg = {0};
+        doorbell_msg.hwnd    = window;
+        doorbell_msg.message = GetWin32MessageID(ipcmsg_ring_doorbell);
+        doorbell_msg.wParam  = i;
+        doorbell_msg.time    = ::GetMessageTime();
+
+        ReceiveRingMessages(doorbell_msg, handler, true);
+    }
+}
+
+void IPCManager::SetReceiveTimeBudget(uint64_t budget_us)
+{
+    m_ReceiveBudgetUs = budget_us;
+}
+
+bool IPCManager::HasDeferredMessages() const
+{
+    return std::any_of(std::begin(m_ReceiveQueues), std::end(m_ReceiveQueues), [](const ReceiveQueue& queue){ return queue.IsDeferred; });
+}
+
+void IPCManager::ResumeDeferredMessages()
+{
+    m_ReceiveBudgetUsedUs = 0;
+
+    for (int i = 0; i < ipcpeer_MAX; ++i)
+    {
+        ReceiveQueue& queue = m_ReceiveQueues[i];
+
+        //Stays deferred if posting fails, so it's tried again next frame
+        if ( (queue.IsDeferred) && (::PostMessage(queue.Window, m_RegisteredMessages[ipcmsg_ring_doorbell], i, 0)) )
+        {
+            queue.IsDeferred = false;
+        }
+    }
+}
+
+bool IPCManager::RunRingBenchmark(const char* process_name)
+{
+    std::ofstream file(std::string(process_name) + "_ipc_ring_benchmark.txt", std::ios::trunc);
+
+    if (!file.good())
+        return false;
+
+    //Posted messages, short strings and larger data
+    const uint32_t payload_sizes[] = {sizeof(IPCRingMessage), sizeof(IPCRingCopyData) + 64, sizeof(IPCRingCopyData) + 4096};
+
+    file << "IPC ring buffer checks of " << process_name << "\n";
+    const bool checks_passed = IPCRingBenchmark::RunChecks(file);
+
+    file << "\nIPC ring buffer throughput of " << process_name << ", " << k_IPCRingCapacity / 1024 << " KB capacity\n";
+    const bool benchmark_done = IPCRingBenchmark::Run(file, k_IPCRingCapacity, payload_sizes, sizeof(payload_sizes) / sizeof(payload_sizes[0]));
+
+    return ( (checks_passed) && (benchmark_done) );
+}
+
+void IPCManager::PullRingMessages(IPCPeerID sender_id, RingChannel& channel, const MSG& doorbell_msg)
+{
+    ReceiveQueue& queue = m_ReceiveQueues[sender_id];
+    const bool stats_enabled = IPCStats::Get().IsEnabled();
+
+    //Clear before reading so messages pushed from here on result in another doorbell
+    channel.Ring.ClearNotifyPending();
+
+    uint32_t type = 0, size = 0;
+    const void* data = nullptr;
+
+    while ((data = channel.Ring.Peek(type, size)) != nullptr)
+    {
+        ReceivedMessage received;
+        received.Msg = {0};
+        received.Msg.hwnd       = doorbell_msg.hwnd;
+        received.Msg.time       = doorbell_msg.time;
+        received.DataID         = 0;
+        received.QueueTimestamp = (stats_enabled) ? IPCStats::GetTimestamp() : 0;
+
+        if (type == k_IPCRingTypeCopyData)
+        {
+            IPCRingCopyData ring_copydata = {0};
+            const bool is_valid = (size >= sizeof(ring_copydata));
+
+            //The payload is overwritten by the sender once consumed, so copy it out first
+            if (is_valid)
+            {
+                memcpy(&ring_copydata, data, sizeof(ring_copydata));
+                received.Data.assign((const char*)data + sizeof(ring_copydata), size - sizeof(ring_copydata));
+            }
+
+            channel.Ring.Consume();
+
+            if (is_valid)
+            {
+                received.Msg.message   = WM_COPYDATA;
+                received.Msg.wParam    = (WPARAM)ring_copydata.SourceWindow;
+                received.DataID        = (ULONG_PTR)ring_copydata.DataID;
+                received.StatsChannel  = (IPCStatsChannel)ring_copydata.StatsChannel;
+                received.StatsID       = ring_copydata.StatsID;
+                received.SendTimestamp = ring_copydata.Timestamp;
+                received.Lane          = IPCManagerGetCopyDataLane(received.StatsChannel, received.StatsID);
+
+                ((received.Lane == ipclane_input) ? queue.InputLane : queue.OrderedLane).push_back(std::move(received));
+            }
+
+            continue;
+        }
+
+        IPCRingMessage ring_msg = {0};
+        const bool is_valid = ( (type < ipcmsg_MAX) && (type != ipcmsg_ring_doorbell) && (size == sizeof(ring_msg)) );
+
+        if (is_valid)
+        {
+            memcpy(&ring_msg, data, sizeof(ring_msg));
+        }
+
+        channel.Ring.Consume();
+
+        if (is_valid)
+        {
+            received.Msg.message   = GetWin32MessageID((IPCMsgID)type);
+            received.Msg.wParam    = (WPARAM)ring_msg.WParam;
+            received.Msg.lParam    = (LPARAM)ring_msg.LParam;
+            received.StatsChannel  = IPCManagerGetStatsChannel((IPCMsgID)type);
+            received.StatsID       = received.Msg.wParam;
+            received.SendTimestamp = ring_msg.Timestamp;
+            received.Lane          = IPCManagerGetMessageLane((IPCMsgID)type, received.Msg.wParam);
+
+            ((received.Lane == ipclane_input) ? queue.InputLane : queue.OrderedLane).push_back(std::move(received));
+        }
+    }
+}
+
+void IPCManager::DispatchReceivedMessage(ReceivedMessage& received, const std::function<void(const MSG&)>& handler)
+{
+    COPYDATASTRUCT cds;
+
+    if (received.Msg.message == WM_COPYDATA)
+    {
+        cds.dwData = received.DataID;
+        cds.cbData = (DWORD)received.Data.length();
+        cds.lpData = (void*)received.Data.data();
+
+        received.Msg.lParam = (LPARAM)&cds;
+    }
+
+    if (IPCStats::Get().IsEnabled())
+    {
+        if (received.SendTimestamp != 0)
+        {
+            IPCStats::Get().RecordLatency(received.StatsChannel, received.StatsID, IPCStats::Get().GetMicrosecondsSince(received.SendTimestamp));
+        }
+
+        if (received.QueueTimestamp != 0)
+        {
+            IPCStats::Get().RecordLatency(ipcstats_lane_delay, received.Lane, IPCStats::Get().GetMicrosecondsSince(received.QueueTimestamp));
+        }
+    }
+
+    handler(received.Msg);
+}
+
+bool IPCManager::OpenRingChannel(RingChannel& channel, IPCPeerID sender_id, IPCPeerID receiver_id, bool allow_create) const
+{
+    const std::string name = IPCManagerGetRingName(sender_id, receiver_id);
+    const size_t memory_size = IPCRingBuffer::GetMemorySize(k_IPCRingCapacity);
+
+    bool is_open = (allow_create) ? channel.SharedMemory.Create(name.c_str(), memory_size) : channel.SharedMemory.Open(name.c_str(), memory_size);
+
+    if (is_open)
+    {
+        is_open = channel.Ring.Attach(channel.SharedMemory.GetData(), channel.SharedMemory.GetSize(), k_IPCRingCapacity, channel.SharedMemory.IsCreator());
+    }
+
+    if (!is_open)
+    {
+        channel.Ring.Detach();
+        channel.SharedMemory.Close();
+    }
+
+    return is_open;
+}
+
+IPCManager::RingChannel* IPCManager::GetOutboundRingChannel(IPCPeerID peer_id) const
+{
+    //Ring buffers have a single producer, so only the thread that set up the transport may use them
+    if ( (m_TransportPeerID == ipcpeer_MAX) || (peer_id == m_TransportPeerID) || (::GetCurrentThreadId() != m_TransportThreadID) )
+        return nullptr;
+
+    RingChannel& channel = m_RingsOutbound[peer_id];
+
+    if (!channel.Ring.IsAttached())
+    {
+        const ULONGLONG tick = ::GetTickCount64();
+
+        if (tick < channel.NextOpenTick)
+            return nullptr;
+
+        if (!OpenRingChannel(channel, m_TransportPeerID, peer_id, false))
+        {
+            channel.NextOpenTick = tick + 1000;
+            return nullptr;
+        }
+    }
+
+    return &channel;
+}
+
+bool IPCManager::PostMessageToPeerRing(IPCPeerID peer_id, HWND window, IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const
+{
+    RingChannel* channel = GetOutboundRingChannel(peer_id);
+
+    if (channel == nullptr)
+        return false;
+
+    IPCRingMessage ring_msg;
+    ring_msg.WParam    = w_param;
+    ring_msg.LParam    = l_param;
+    ring_msg.Timestamp = (IPCStats::Get().IsEnabled()) ? IPCStats::GetTimestamp() : 0;
+
+    if (!channel->Ring.Push(IPC_id, &ring_msg, sizeof(ring_msg)))
+    {
+        //Receiver isn't keeping up. Drop the message like a full window message queue would, as sending it as window message instead would break the order
+        if (IPCStats::Get().IsEnabled())
+        {
+            IPCStats::Get().RecordSend(ipcstats_ring_full, peer_id, sizeof(ring_msg));
+        }
+
+        if (!channel->IsFull)
+        {
+            LOG_F(WARNING, "IPC ring buffer to peer %d is full, dropping messages", peer_id);
+            channel->IsFull = true;
+        }
+
+        return true;
+    }
+
+    channel->IsFull = false;
+    NotifyPeerRing(peer_id, window, *channel);
+
+    return true;
+}
+
+bool IPCManager::SendCopyDataToPeerRing(IPCPeerID peer_id, HWND window, IPCStatsChannel stats_channel, size_t stats_id, ULONG_PTR data_id, const void* data, DWORD data_size,
+                                        HWND source_window) const
+{
+    RingChannel* channel = GetOutboundRingChannel(peer_id);
+
+    if ( (channel == nullptr) || (data_size > channel->Ring.GetMaxRecordSize() - sizeof(IPCRingCopyData)) )
+        return false;
+
+    IPCRingCopyData ring_copydata;
+    ring_copydata.DataID       = data_id;
+    ring_copydata.SourceWindow = (uint64_t)source_window;
+    ring_copydata.Timestamp    = (IPCStats::Get().IsEnabled()) ? IPCStats::GetTimestamp() : 0;
+    ring_copydata.StatsChannel = stats_channel;
+    ring_copydata.StatsID      = (uint32_t)stats_id;
+
+    //Unlike posted messages, data isn't dropped when the ring buffer is full. The caller falls back to WM_COPYDATA instead
+    //Receivers call ReceiveAllRingMessages() before handling WM_COPYDATA, so it doesn't overtake messages still in the ring buffer or waiting in a lane
+    if (!channel->Ring.Push(k_IPCRingTypeCopyData, &ring_copydata, sizeof(ring_copydata), data, data_size))
+    {
+        if (IPCStats::Get().IsEnabled())
+        {
+            IPCStats::Get().RecordSend(ipcstats_ring_full, peer_id, data_size);
+        }
+
+        return false;
+    }
+
+    NotifyPeerRing(peer_id, window, *channel);
+
+    return true;
+}
+
+void IPCManager::NotifyPeerRing(IPCPeerID peer_id, HWND window, RingChannel& channel) const
+{
+    //Only notify if the receiver hasn't been notified since it last started reading
+    if (channel.Ring.SetNotifyPending())
+    {
+        if (!::PostMessage(window, GetWin32MessageID(ipcmsg_ring_doorbell), m_TransportPeerID, 0))
+        {
+            channel.Ring.ClearNotifyPending();
+
+            if (::GetLastError() == ERROR_INVALID_WINDOW_HANDLE)
+            {
+                InvalidatePeerWindow(peer_id);
+            }
+        }
+    }
+}
+
+bool IPCManager::QueueMessageToPeer(IPCPeerID peer_id, IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const
+{
+    //Queues are only flushed by the transport thread
+    if ( (m_TransportPeerID == ipcpeer_MAX) || (::GetCurrentThreadId() != m_TransportThreadID) )
+        return false;
+
+    const IPCManagerQueueMode queue_mode = IPCManagerGetQueueMode(IPC_id, w_param);
+
+    if (queue_mode == ipcmanager_queue_none)
+        return false;
+
+    std::vector<QueuedMessage>& queue = m_OutboundQueues[peer_id];
+
+    if (queue_mode == ipcmanager_queue_replace)
+    {
+        //The queue only ever contains queueable messages, so updating the value in place doesn't reorder anything that depends on it
+        for (QueuedMessage& queued_msg : queue)
+        {
+            if ( (queued_msg.IPCID == IPC_id) && (queued_msg.WParam == w_param) )
+            {
+                queued_msg.LParam = l_param;
+                return true;
+            }
+        }
+    }
+    else if (!queue.empty())
+    {
+        //Adjustments don't commute with other adjustments, so only merge with the last one and only if it's the same target and direction
+        QueuedMessage& queued_msg = queue.back();
+        const LPARAM steps = (queued_msg.LParam >> 8) & 0xFF;
+
+        if ( (queued_msg.IPCID == IPC_id) && (queued_msg.WParam == w_param) && ((queued_msg.LParam & 0xFF) == (l_param & 0xFF)) && (steps < 0xFF) )
+        {
+            queued_msg.LParam = (queued_msg.LParam & 0xFF) | ((steps + 1) << 8);
+            return true;
+        }
+    }
+
+    queue.push_back({IPC_id, w_param, l_param});
+    return true;
+}
+
+void IPCManager::FlushQueuedMessagesToPeer(IPCPeerID peer_id) const
+{
+    if ( (m_TransportPeerID == ipcpeer_MAX) || (::GetCurrentThreadId() != m_TransportThreadID) )
+        return;
+
+    std::vector<QueuedMessage>& queue = m_OutboundQueues[peer_id];
+
+    for (const QueuedMessage& queued_msg : queue)
+    {
+        PostMessageToPeerDirect(peer_id, queued_msg.IPCID, queued_msg.WParam, queued_msg.LParam);
+    }
+
+    queue.clear();
+}
+
+void IPCManager::FlushQueuedMessages() const
 {
-    //We take the cost of finding the window for every message (which isn't frequent anyways) so we don't have to worry about the process going anywhere
-    if (HWND window = ::FindWindow(g_WindowClassNameDashboardApp, nullptr))
+    for (int i = 0; i < ipcpeer_MAX; ++i)
+    {
+        FlushQueuedMessagesToPeer((IPCPeerID)i);
+    }
+}
+
+void IPCManager::PostMessageToPeerDirect(IPCPeerID peer_id, IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const
+{
+    if (HWND window = GetPeerWindow(peer_id))
+    {
+        if (IPCStats::Get().IsEnabled())
+        {
+            IPCStats::Get().RecordSend(IPCManagerGetStatsChannel(IPC_id), w_param, sizeof(w_param) + sizeof(l_param));
+        }
+
+        if (PostMessageToPeerRing(peer_id, window, IPC_id, w_param, l_param))
+            return;
+
+        //Window may have been destroyed since revalidation. Drop it from the cache so the next message finds the new one right away
+        if ( (!::PostMessage(window, GetWin32MessageID(IPC_id), w_param, l_param)) && (::GetLastError() == ERROR_INVALID_WINDOW_HANDLE) )
+        {
+            InvalidatePeerWindow(peer_id);
+        }
+    }
+}
+
+void IPCManager::PostMessageToPeer(IPCPeerID peer_id, IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const
+{
+    if (QueueMessageToPeer(peer_id, IPC_id, w_param, l_param))
+        return;
+
+    //Don't overtake queued messages
+    FlushQueuedMessagesToPeer(peer_id);
+    PostMessageToPeerDirect(peer_id, IPC_id, w_param, l_param);
+}
+
+void IPCManager::SendCopyDataToPeer(IPCPeerID peer_id, IPCStatsChannel stats_channel, ULONG_PTR data_id, const void* data, DWORD data_size, HWND source_window) const
+{
+    FlushQueuedMessagesToPeer(peer_id);
+
+    if (HWND window = GetPeerWindow(peer_id))
     {
-        ::PostMessage(window, GetWin32MessageID(IPC_id), w_param, l_param);
+        const bool is_stats_enabled = IPCStats::Get().IsEnabled();
+        const size_t stats_id = ( (stats_channel == ipcstats_config_delta) || (stats_channel == ipcstats_ui_mask) ) ? 0 : data_id;
+
+        //Written to the ring buffer without waiting for the receiver when possible. Latency is recorded by the receiver in that case
+        if (SendCopyDataToPeerRing(peer_id, window, stats_channel, stats_id, data_id, data, data_size, source_window))
+        {
+            if (is_stats_enabled)
+            {
+                IPCStats::Get().RecordSend(stats_channel, stats_id, data_size);
+            }
+
+            return;
+        }
+
+        COPYDATASTRUCT cds;
+        cds.dwData = data_id;
+        cds.cbData = data_size;
+        cds.lpData = (void*)data;
+
+        //SendMessage() returns once the receiver handled the message, so the time spent in it is the latency
+        const int64_t send_timestamp = (is_stats_enabled) ? IPCStats::GetTimestamp() : 0;
+
+        ::SendMessage(window, WM_COPYDATA, (WPARAM)source_window, (LPARAM)(LPVOID)&cds);
+
+        if (is_stats_enabled)
+        {
+            IPCStats::Get().RecordSend(stats_channel, stats_id, data_size);
+            IPCStats::Get().RecordLatency(stats_channel, stats_id, IPCStats::Get().GetMicrosecondsSince(send_timestamp));
+        }
     }
 }
 
+void IPCManager::PostMessageToDashboardApp(IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const
+{
+    PostMessageToPeer(ipcpeer_dashboard_app, IPC_id, w_param, l_param);
+}
+
 void IPCManager::PostConfigMessageToDashboardApp(ConfigID_Bool configid, LPARAM l_param) const
 {
     PostMessageToDashboardApp(ipcmsg_set_config, ConfigManager::Get().GetWParamForConfigID(configid), l_param);
@@ -135,10 +862,7 @@ void IPCManager::PostConfigMessageToDashboardApp(ConfigID_Handle configid, LPARA
 
 void IPCManager::PostMessageToUIApp(IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const
 {
-    if (HWND window = ::FindWindow(g_WindowClassNameUIApp, nullptr))
-    {
-        ::PostMessage(window, GetWin32MessageID(IPC_id), w_param, l_param);
-    }
+    PostMessageToPeer(ipcpeer_ui_app, IPC_id, w_param, l_param);
 }
 
 void IPCManager::PostConfigMessageToUIApp(ConfigID_Bool configid, LPARAM l_param) const
@@ -163,44 +887,49 @@ void IPCManager::PostConfigMessageToUIApp(ConfigID_Handle configid, LPARAM l_par
 
 void IPCManager::PostMessageToElevatedModeProcess(IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const
 {
-    if (HWND window = ::FindWindow(g_WindowClassNameElevatedMode, nullptr))
-    {
-        ::PostMessage(window, GetWin32MessageID(IPC_id), w_param, l_param);
-    }
+    PostMessageToPeer(ipcpeer_elevated_mode, IPC_id, w_param, l_param);
 }
 
 void IPCManager::SendStringToDashboardApp(ConfigID_String config_id, const std::string& str, HWND source_window) const
 {
-    if (HWND window = ::FindWindow(g_WindowClassNameDashboardApp, nullptr))
-    {
-        COPYDATASTRUCT cds;
-        cds.dwData = config_id;
-        cds.cbData = (DWORD)str.length();  //We do not include the NUL byte
-        cds.lpData = (void*)str.c_str();
-        ::SendMessage(window, WM_COPYDATA, (WPARAM)source_window, (LPARAM)(LPVOID)&cds);
-    }
+    //We do not include the NUL byte
+    SendCopyDataToPeer(ipcpeer_dashboard_app, ipcstats_config_string, config_id, str.c_str(), (DWORD)str.length(), source_window);
 }
 
 void IPCManager::SendStringToUIApp(ConfigID_String config_id, const std::string& str, HWND source_window) const
 {
-    if (HWND window = ::FindWindow(g_WindowClassNameUIApp, nullptr))
+    SendCopyDataToPeer(ipcpeer_ui_app, ipcstats_config_string, config_id, str.c_str(), (DWORD)str.length(), source_window);
+}
+
+void IPCManager::SendConfigDeltaToUIApp(const ConfigDelta& delta, HWND source_window) const
+{
+    if (delta.IsEmpty())
+        return;
+
+    if (GetPeerWindow(ipcpeer_ui_app) != nullptr)
     {
-        COPYDATASTRUCT cds;
-        cds.dwData = config_id;
-        cds.cbData = (DWORD)str.length();  //We do not include the NUL byte
-        cds.lpData = (void*)str.c_str();
-        ::SendMessage(window, WM_COPYDATA, (WPARAM)source_window, (LPARAM)(LPVOID)&cds);
+        const std::string str = delta.Serialize();
+        SendCopyDataToPeer(ipcpeer_ui_app, ipcstats_config_delta, g_IPCCopyDataIDConfigDelta, str.data(), (DWORD)str.length(), source_window);
+
+        //The receiver queues the delta until this arrives, as WM_COPYDATA sent as fallback is handled before already posted messages
+        PostMessageToPeer(ipcpeer_ui_app, ipcmsg_action, ipcact_config_delta_apply, 0);
     }
 }
 
 void IPCManager::SendStringToElevatedModeProcess(IPCElevatedStringID elevated_str_id, const std::string& str, HWND source_window) const
 {
-    if (HWND window = ::FindWindow(g_WindowClassNameElevatedMode, nullptr))
-    {
-        COPYDATASTRUCT cds;
-        cds.dwData = elevated_str_id;
-        cds.cbData = (DWORD)str.length();  //We do not include the NUL byte
-        cds.lpData = (void*)str.c_str();
-        ::SendMessage(window, WM_COPYDATA, (WPARAM)source_window, (LPARAM)(LPVOID)&cds);
-    }
+    SendCopyDataToPeer(ipcpeer_elevated_mode, ipcstats_elevated_string, elevated_str_id, str.c_str(), (DWORD)str.length(), source_window);
+}
+
+void IPCManager::SendInputBatchToElevatedModeProcess(const std::vector<IPCElevatedInputRecord>& records, HWND source_window) const
+{
+    if (records.empty())
+        return;
+
+    SendCopyDataToPeer(ipcpeer_elevated_mode, ipcstats_elevated_string, ipcestrid_input_batch, records.data(), (DWORD)(records.size() * sizeof(IPCElevatedInputRecord)), source_window);
+}
+
+void IPCManager::SendUIIntersectionMaskUpdateToDashboardApp(const std::string& update, HWND source_window) const
+{
+    SendCopyDataToPeer(ipcpeer_dashboard_app, ipcstats_ui_mask, g_IPCCopyDataIDUIMask, update.data(), (DWORD)update.length(), source_window);
 }
@@ -2,22 +2,38 @@
 //It's generally expected to use matching builds of the dashboard overlay and UI application, as the UI is launched by the dashboard process
 //Due to that, there's no version checking or similar, just some raw messages to get things done
 //This header and its implemenation is shared between both applications' code
-//The IPCManager class doesn't write to any variables after construction, so calling it from other threads is safe
+//The IPCManager class only writes to atomic variables (peer window cache and its counters) after construction, so calling it from other threads is safe
+//Exceptions are the ring buffers, outbound and receive queues set up by InitTransport(), which are only ever touched by the thread that called it
 
 #pragma once
 
 #include <string>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <functional>
 #define NOMINMAX
 #include <windows.h>
 
 #include "ConfigManager.h"
+#include "IPCSharedMemory.h"
+#include "IPCRingBuffer.h"
+#include "IPCStats.h"
 
 LPCWSTR const g_WindowClassNameDashboardApp = L"elvdesktop";
 LPCWSTR const g_WindowClassNameUIApp        = L"elvdesktopUI";
 LPCWSTR const g_WindowClassNameElevatedMode = L"elvdesktopelevated";
+LPCWSTR const g_WindowClassNameIPCReplay    = L"elvdesktopipcreplay";                    //Used by processes replaying IPC recordings so peers don't find them
 const char* const g_AppKeyDashboardApp      = "steam.overlay.1494460";                  //1494460 is the appid on Steam, but we just use this for all builds
 const char* const g_AppKeyUIApp             = "elvissteinjr.DesktopPlusUI";
 const char* const g_AppKeyTheaterScreen     = "elvissteinjr.DesktopPlusTheaterScreen";  //We need an app with "starts_theater_mode", but we can't add that to the app manifest written by Steam
+const ULONG_PTR g_IPCCopyDataIDConfigDelta  = 2000;                                     //WM_COPYDATA ID of ConfigDelta data. Above config string and DPBrowser string IDs
+const DWORD g_IPCConfigDeltaSizeMax         = 4 * 1024 * 1024;                          //Size limit for received ConfigDelta data
+const ULONG_PTR g_IPCCopyDataIDUIMask       = 2001;                                     //WM_COPYDATA ID of UIIntersectionMask updates
+const DWORD g_IPCUIMaskSizeMax              = 128 * 1024;                               //Size limit for received UIIntersectionMask updates
+const uint64_t g_IPCReceiveFrameBudgetUs    = 4000;                                     //Time per frame the dashboard and UI application spend on non-input ring messages before deferring the rest
+
+class ConfigDelta;
 
 enum IPCMsgID
 {
@@ -25,6 +41,7 @@ enum IPCMsgID
     ipcmsg_set_config,        //wParam = ConfigID, lParam = Value. Generic ConfigIDs are derived from their specific ID + predecending *_MAX values.
                               //e.g. configid_float_stuff is configid_bool_MAX + configid_int_MAX + configid_float_stuff. Strings are handled separately
     ipcmsg_elevated_action,   //wParam = IPCElevatedActionID, lParam = Action-specific value. Actions sent to the elevated mode process
+    ipcmsg_ring_doorbell,     //wParam = IPCPeerID of the sender. Posted when messages were written to the shared memory ring buffer of the sender. See IPCManager::ReceiveRingMessages()
     ipcmsg_MAX
 };
 
@@ -74,15 +91,20 @@ enum IPCActionID
     ipcact_keyboard_ovrl_focus_enter,   //Sent by UI application in response to a VREvent_FocusEnter on the keyboard overlay. No data in lParam
     ipcact_keyboard_ovrl_focus_leave,   //Sent by UI application in response to a VREvent_FocusLeave on the keyboard overlay. No data in lParam
     ipcact_lpointer_trigger_haptics,    //Sent by UI application to trigger laser pointer haptics (short UI interaction burst). lParam is tracked device index
-    ipcact_lpointer_ui_mask_rect,       //Sent by UI application to update the UI intersection mask for the dplus laser pointer. lParam is DPRect packed with DPRect::Pack16() or -1 to finish the mask
+    ipcact_lpointer_ui_mask_resend,     //Sent by dashboard application when it couldn't apply a UI intersection mask update, so the next one contains the full mask. No data in lParam
     ipcact_lpointer_ui_drag,            //Sent by dashboard application to start or finish an overlay drag of an UI laser pointer target overlay. lParam is 1 for start or 0 to finish
     ipcact_app_profile_remove,          //Sent by UI application to remove an app profile. No data in lParam, uses app key stored in configid_str_state_app_profile_key beforehand
     ipcact_global_shortcut_set,         //Sent by UI application to set a global shortcut. lParam is shortcut ID, uses Action UID stored in configid_handle_state_action_uid beforehand
     ipcact_hotkey_set,                  //Sent by UI application to set a hotkey. lParam is hotkey ID (out of range ID to create new), uses configid_str_state_hotkey_data as source (blank to delete)
+    ipcact_config_delta_apply,          //Sent by dashboard application after sending a ConfigDelta as WM_COPYDATA, so it's applied in order with posted messages. No data in lParam
+    ipcact_config_transaction_begin,    //Sent by either application to group config changes. lParam is ID of overlay the changes apply to (-1 for current), replacing configid_int_state_overlay_current_id_override
+                                        //The dashboard application applies all changes of the group at once after ipcact_config_transaction_commit. Transactions can't be nested
+    ipcact_config_transaction_commit,   //Sent by either application to end a config change group started with ipcact_config_transaction_begin. No data in lParam
     ipcact_MAX
 };
 
 //lParam for ipcact_overlay_position_adjust. First 4 bits are target, 5th bit sets increase operation
+//Bits 8 to 15 are the number of steps minus one, which is set when the outbound queue merges consecutive adjustments (see IPCManager::FlushQueuedMessages())
 enum IPCActionOverlayPosAdjustTarget 
 {
     ipcactv_ovrl_pos_adjust_updown = 0x0,
@@ -142,14 +164,116 @@ enum IPCElevatedStringID
     ipcestrid_keyboard_text,
     ipcestrid_keyboard_text_force_unicode,
     ipcestrid_launch_application_path,            //This also resets ipcestrid_launch_application_arg so sending that can be avoided
-    ipcestrid_launch_application_arg
+    ipcestrid_launch_application_arg,
+    ipcestrid_input_batch,                        //Array of IPCElevatedInputRecord, replayed on arrival. Not a string, but sent the same way
+    ipcestrid_MAX
+};
+
+//Input forwarded to the elevated mode process by InputSimulator, collected during a frame and sent as ipcestrid_input_batch
+//Each record is handled like an ipcmsg_elevated_action message, but the resulting input events of the whole batch are sent with a single SendInput() call
+struct IPCElevatedInputRecord
+{
+    DWORD Time;                         //GetTickCount() when the input was made, used as time stamp of the resulting input events
+    uint32_t ActionID;                  //IPCElevatedActionID
+    int64_t Value;                      //lParam of the action
+};
+
+const size_t g_IPCElevatedInputBatchRecordMax = 256;                                    //Batches are sent early when reaching this. Keeps them within the 4 KB elevated mode data limit
+
+enum IPCPeerID
+{
+    ipcpeer_dashboard_app,
+    ipcpeer_ui_app,
+    ipcpeer_elevated_mode,
+    ipcpeer_MAX
+};
+
+//Classes of messages received through the shared memory transport, see IPCManager::ReceiveRingMessages()
+enum IPCMessageLane
+{
+    ipclane_input,          //Latency-critical input (VR keyboard keys and text, laser pointer haptics, elevated mode input). Handled before anything else
+    ipclane_default,        //Everything not in the other lanes
+    ipclane_bulk,           //Messages which typically trigger a lot of work or come in bursts (profile loads, action edits, full config syncs)
+    ipclane_MAX
 };
 
 class IPCManager
 {
     private:
+        struct PeerWindowCacheEntry
+        {
+            std::atomic<HWND> Window{nullptr};
+            std::atomic<DWORD> ProcessID{0};
+        };
+
+        struct QueuedMessage
+        {
+            IPCMsgID IPCID;
+            WPARAM WParam;
+            LPARAM LParam;
+        };
+
+        //Message received through a ring buffer, waiting in its lane to be handled
+        struct ReceivedMessage
+        {
+            MSG Msg;                            //lParam is set to a COPYDATASTRUCT pointing to Data right before handling WM_COPYDATA messages
+            ULONG_PTR DataID;
+            std::string Data;
+            IPCMessageLane Lane;
+            IPCStatsChannel StatsChannel;
+            size_t StatsID;
+            int64_t SendTimestamp;              //0 if stats are disabled
+            int64_t QueueTimestamp;             //0 if stats are disabled
+        };
+
+        struct ReceiveQueue
+        {
+            std::deque<ReceivedMessage> InputLane;
+            std::deque<ReceivedMessage> OrderedLane;    //Default and bulk lane messages. Their handlers depend on each other, so they stay in the order they were sent
+            HWND Window = nullptr;                      //Own window the last doorbell was posted to
+            bool IsDeferred = false;                    //Set when messages were left in OrderedLane because the frame's time budget was used up or the ring buffer couldn't be opened
+            bool IsInConfigTransaction = false;         //Set between handling ipcact_config_transaction_begin and ipcact_config_transaction_commit from this sender
+        };
+
+        struct RingChannel
+        {
+            IPCSharedMemory SharedMemory;
+            IPCRingBuffer Ring;
+            ULONGLONG NextOpenTick = 0;         //Channels not created by this process are opened on demand, but not retried on every message if that fails
+            bool IsFull = false;                //Only used to avoid spamming the log
+        };
+
         UINT m_RegisteredMessages[ipcmsg_MAX];
 
+        mutable PeerWindowCacheEntry m_PeerWindowCache[ipcpeer_MAX];
+        mutable std::atomic<uint64_t> m_PeerWindowCacheHits{0};
+        mutable std::atomic<uint64_t> m_PeerWindowCacheLookups{0};
+        mutable std::atomic<uint64_t> m_PeerWindowCacheInvalidations{0};
+        std::atomic<bool> m_IsIsolatedFromPeers{false};
+
+        IPCPeerID m_TransportPeerID;
+        DWORD m_TransportThreadID;
+        mutable RingChannel m_RingsOutbound[ipcpeer_MAX];
+        RingChannel m_RingsInbound[ipcpeer_MAX];
+        mutable std::vector<QueuedMessage> m_OutboundQueues[ipcpeer_MAX];
+        ReceiveQueue m_ReceiveQueues[ipcpeer_MAX];
+        uint64_t m_ReceiveBudgetUs;
+        uint64_t m_ReceiveBudgetUsedUs;
+
+        bool OpenRingChannel(RingChannel& channel, IPCPeerID sender_id, IPCPeerID receiver_id, bool allow_create) const;
+        RingChannel* GetOutboundRingChannel(IPCPeerID peer_id) const;  //Returns nullptr if the ring buffer can't be used from the calling thread or isn't open
+        bool PostMessageToPeerRing(IPCPeerID peer_id, HWND window, IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const;
+        bool SendCopyDataToPeerRing(IPCPeerID peer_id, HWND window, IPCStatsChannel stats_channel, size_t stats_id, ULONG_PTR data_id, const void* data, DWORD data_size,
+                                    HWND source_window) const;
+        void NotifyPeerRing(IPCPeerID peer_id, HWND window, RingChannel& channel) const;
+        void PullRingMessages(IPCPeerID sender_id, RingChannel& channel, const MSG& doorbell_msg);    //Moves all messages from the ring buffer into the lanes of the sender's ReceiveQueue
+        void DispatchReceivedMessage(ReceivedMessage& received, const std::function<void(const MSG&)>& handler);
+        bool QueueMessageToPeer(IPCPeerID peer_id, IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const;
+        void FlushQueuedMessagesToPeer(IPCPeerID peer_id) const;
+        void PostMessageToPeerDirect(IPCPeerID peer_id, IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const;
+        void PostMessageToPeer(IPCPeerID peer_id, IPCMsgID IPC_id, WPARAM w_param, LPARAM l_param) const;
+        void SendCopyDataToPeer(IPCPeerID peer_id, IPCStatsChannel stats_channel, ULONG_PTR data_id, const void* data, DWORD data_size, HWND source_window) const;
+
     public:
         IPCManager();
         static IPCManager& Get();
@@ -163,6 +287,46 @@ class IPCManager
         static DWORD GetDashboardAppProcessID();
         static DWORD GetUIAppProcessID();
 
+        //Returns the window of the peer process or nullptr if it's not running
+        //Windows are cached and only looked up again if the cached window no longer exists or belongs to a different process than when it was found
+        HWND GetPeerWindow(IPCPeerID peer_id) const;
+        void InvalidatePeerWindow(IPCPeerID peer_id) const;    //Forces a lookup on next use, e.g. when the peer is known to have restarted
+        IPCPeerWindowCacheStats GetPeerWindowCacheStats() const;
+        //Treats all peers as not running, so nothing is sent to them and IsDashboardAppRunning() etc. return false. Used while replaying IPC recordings
+        void SetIsolatedFromPeers(bool is_isolated);
+
+        //Sets up the shared memory transport. Should be called once before creating the process' window, so peers find the ring buffers as soon as the window exists
+        //Afterwards, messages posted from the calling thread are written to a ring buffer shared with the receiving process, with ipcmsg_ring_doorbell posted as notification
+        //Messages posted from other threads, to the own process or to peers without transport set up still use plain window messages
+        //The same goes for strings sent from the calling thread, which only fall back to a blocking WM_COPYDATA if they don't fit into the ring buffer
+        void InitTransport(IPCPeerID own_peer_id);
+        //Calls handler with each message received from the sender of an ipcmsg_ring_doorbell message
+        //Messages are sorted into lanes (see IPCMessageLane). Input lane messages are handled first, even if they were sent after messages still waiting in the other lanes
+        //The others are handled in the order they were posted, checking for new input messages after each one. Once the receive time budget is used up, they're deferred to the next frame
+        //Strings and other data sent through the ring buffer are passed as WM_COPYDATA message, with lParam pointing to a COPYDATASTRUCT only valid during the handler call
+        //ignore_budget handles all of them right away, even if the receive time budget is used up
+        //Config transactions are handled as a whole. The budget isn't checked and input lane messages wait while one is open, as their handlers would otherwise see its overlay ID override
+        void ReceiveRingMessages(const MSG& doorbell_msg, const std::function<void(const MSG&)>& handler, bool ignore_budget = false);
+        //Handles all messages waiting in the inbound ring buffers, ignoring the receive time budget. window is the own window the messages are passed with
+        //Must be called before handling WM_COPYDATA sent by peers, as it may have been sent as fallback when the ring buffer was full and would overtake the messages still in it otherwise
+        void ReceiveAllRingMessages(HWND window, const std::function<void(const MSG&)>& handler);
+        //Sets the time per frame spent handling non-input ring messages. 0 (default) doesn't limit it. Only use with ResumeDeferredMessages() called once per frame
+        //Messages that don't go through the ring buffer are handled as they arrive, so they can overtake deferred ones. For WM_COPYDATA sent as fallback when the ring buffer
+        //was full, ReceiveAllRingMessages() takes care of that. Plain window messages are only used for messages from other threads, to the own process or to peers
+        //without ring buffer, none of which were ever ordered with the sender's ring messages
+        void SetReceiveTimeBudget(uint64_t budget_us);
+        //Starts a new receive time budget and reposts the doorbells of senders with deferred messages. Should be called by the transport thread once per frame
+        //Messages are also deferred if the sender's ring buffer couldn't be opened, so processes without a frame loop should call it periodically while HasDeferredMessages() is true
+        void ResumeDeferredMessages();
+        bool HasDeferredMessages() const;
+        //Runs IPCRingBenchmark with the message sizes and ring buffer capacity used here and writes the results to "<process_name>_ipc_ring_benchmark.txt"
+        //Uses its own ring buffer and doesn't need InitTransport(), so it can be run without the other Desktop+ processes. Returns false if a check failed
+        static bool RunRingBenchmark(const char* process_name);
+        //Messages that only carry the latest value of something (float config values, mouse movement, etc.) are queued per receiver when posted from the transport thread
+        //Queued messages with the same ID replace each other instead of piling up. Any other message to the same receiver sends the queue first, so the order stays intact
+        //Should be called by the transport thread once per frame and before it goes idle
+        void FlushQueuedMessages() const;
+
         void PostMessageToDashboardApp(IPCMsgID IPC_id, WPARAM w_param = 0, LPARAM l_param = 0) const;
         void PostConfigMessageToDashboardApp(ConfigID_Bool   configid, LPARAM l_param = 0) const;
         void PostConfigMessageToDashboardApp(ConfigID_Int    configid, LPARAM l_param = 0) const;
@@ -179,5 +343,8 @@ class IPCManager
 
         void SendStringToDashboardApp(ConfigID_String config_id, const std::string& str, HWND source_window) const;
         void SendStringToUIApp(ConfigID_String config_id, const std::string& str, HWND source_window) const;
+        void SendConfigDeltaToUIApp(const ConfigDelta& delta, HWND source_window) const;    //Sends delta and posts ipcact_config_delta_apply. Does nothing for empty deltas
         void SendStringToElevatedModeProcess(IPCElevatedStringID elevated_str_id, const std::string& str, HWND source_window) const;
+        void SendInputBatchToElevatedModeProcess(const std::vector<IPCElevatedInputRecord>& records, HWND source_window) const;
+        void SendUIIntersectionMaskUpdateToDashboardApp(const std::string& update, HWND source_window) const;  //update as created by UIIntersectionMask::Update()
 };
\ No newline at end of file
@@ -0,0 +1,463 @@
+#include "OverlayConfigSchema.h"
+
+#include <cfloat>
+#include <cstring>
+#include <iterator>
+
+#include "ConfigManager.h"
+#include "Ini.h"
+#include "Util.h"
+
+static constexpr OverlayConfigSchemaEntry SchemaEntry(OverlayConfigSchemaType type, int config_id, const char* key, int default_value = 0,
+                                                      float clamp_min = -FLT_MAX, float clamp_max = FLT_MAX)
+{
+    return {type, config_id, key, default_value, clamp_min, clamp_max, OverlayConfigSchema::HashKey(key)};
+}
+
+//Entries are in the order they're written to profiles
+static constexpr OverlayConfigSchemaEntry g_OverlayConfigSchema[] =
+{
+    SchemaEntry(ovrl_schema_name,         -1,                                                 "Name"),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_name_custom,                  "NameIsCustom",              false),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_enabled,                      "Enabled",                   true),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_desktop_id,                    "DesktopID",                 0),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_capture_source,                "CaptureSource",             ovrl_capsource_desktop_duplication),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_duplication_id,                "DuplicationID",             -1),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_width,                       "Width",                     165, 0.00001f, 1000.0f),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_curvature,                   "Curvature",                 17,  0.0f,     1.0f),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_opacity,                     "Opacity",                   100),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_brightness,                  "Brightness",                100),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_browser_zoom,                "BrowserZoom",               100),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_offset_right,                "OffsetRight",               0),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_offset_up,                   "OffsetUp",                  0),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_offset_forward,              "OffsetForward",             0),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_user_width,                    "UserWidth",                 1280),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_user_height,                   "UserHeight",                720),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_display_mode,                  "DisplayMode",               ovrl_dispmode_always),
+    SchemaEntry(ovrl_schema_origin,       configid_int_overlay_origin,                        "Origin",                    ovrl_origin_room),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_origin_hmd_floor_use_turning, "OriginHMDFloorTurning",     false),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_transform_locked,             "TransformLocked",           false),
+
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_crop_enabled,                 "CroppingEnabled",           false),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_crop_x,                        "CroppingX",                 0),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_crop_y,                        "CroppingY",                 0),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_crop_width,                    "CroppingWidth",             -1),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_crop_height,                   "CroppingHeight",            -1),
+
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_3D_enabled,                   "3DEnabled",                 false),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_3D_mode,                       "3DMode",                    ovrl_3Dmode_hsbs),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_3D_swapped,                   "3DSwapped",                 false),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_gazefade_enabled,             "GazeFade",                  false),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_gazefade_distance,           "GazeFadeDistance",          0),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_gazefade_rate,               "GazeFadeRate",              100),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_gazefade_opacity,            "GazeFadeOpacity",           0),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_update_limit_override_mode,    "UpdateLimitModeOverride",   update_limit_mode_off),
+    SchemaEntry(ovrl_schema_float,        configid_float_overlay_update_limit_override_ms,    "UpdateLimitMS",             0),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_update_limit_override_fps,     "UpdateLimitFPS",            update_limit_fps_30),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_browser_max_fps_override,      "BrowserMaxFPSOverride",     -1),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_input_enabled,                "InputEnabled",              true),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_input_dplus_lp_enabled,       "InputDPlusLPEnabled",       true),
+    SchemaEntry(ovrl_schema_str,          configid_str_overlay_tags,                          "Tags"),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_update_invisible,             "UpdateInvisible",           false),
+
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_floatingui_enabled,           "ShowFloatingUI",            true),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_floatingui_desktops_enabled,  "ShowDesktopButtons",        false),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_floatingui_extras_enabled,    "ShowExtraButtons",          true),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_actionbar_enabled,            "ShowActionBar",             false),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_actionbar_order_use_global,   "ActionBarOrderUseGlobal",   true),
+    SchemaEntry(ovrl_schema_action_order, -1,                                                 "ActionBarOrderCustom"),
+
+    SchemaEntry(ovrl_schema_transform,    -1,                                                 "Transform"),
+
+    SchemaEntry(ovrl_schema_str,          configid_str_overlay_winrt_last_window_title,       "WinRTLastWindowTitle"),
+    SchemaEntry(ovrl_schema_str,          configid_str_overlay_winrt_last_window_class_name,  "WinRTLastWindowClassName"),
+    SchemaEntry(ovrl_schema_str,          configid_str_overlay_winrt_last_window_exe_name,    "WinRTLastWindowExeName"),
+    SchemaEntry(ovrl_schema_int,          configid_int_overlay_winrt_desktop_id,              "WinRTDesktopID",            -2),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_winrt_window_matching_strict, "WinRTWindowMatchingStrict", false),
+
+    SchemaEntry(ovrl_schema_str,          configid_str_overlay_browser_url,                   "BrowserURL"),
+    SchemaEntry(ovrl_schema_str,          configid_str_overlay_browser_url_user_last,         "BrowserURLUserLast"),
+    SchemaEntry(ovrl_schema_str,          configid_str_overlay_browser_title,                 "BrowserTitle"),
+    SchemaEntry(ovrl_schema_bool,         configid_bool_overlay_browser_allow_transparency,   "BrowserAllowTransparency",  false),
+};
+
+static constexpr size_t k_OverlayConfigSchemaCount = std::size(g_OverlayConfigSchema);
+
+static constexpr bool OverlayConfigSchemaIsValid()
+{
+    for (size_t i = 0; i < k_OverlayConfigSchemaCount; ++i)
+    {
+        const OverlayConfigSchemaEntry& entry = g_OverlayConfigSchema[i];
+
+        //Key hashes are used for lookups and in the binary form, so they need to be unique
+        for (size_t j = i + 1; j < k_OverlayConfigSchemaCount; ++j)
+        {
+            if (entry.KeyHash == g_OverlayConfigSchema[j].KeyHash)
+                return false;
+        }
+
+        //ConfigIDs have to be in range of the overlay config arrays
+        int id_max = 0;
+        switch (entry.Type)
+        {
+            case ovrl_schema_bool:   id_max = configid_bool_overlay_MAX;  break;
+            case ovrl_schema_int:    id_max = configid_int_overlay_MAX;   break;
+            case ovrl_schema_float:  id_max = configid_float_overlay_MAX; break;
+            case ovrl_schema_str:    id_max = configid_str_overlay_MAX;   break;
+            case ovrl_schema_origin: id_max = configid_int_overlay_MAX;   break;
+            default:                 id_max = 0;                          break;
+        }
+
+        if ( (id_max != 0) && ( (entry.ConfigID < 0) || (entry.ConfigID >= id_max) ) )
+            return false;
+    }
+
+    return true;
+}
+
+static_assert(OverlayConfigSchemaIsValid(), "Overlay config schema has duplicate keys or ConfigIDs out of range");
+
+//Binary form header, followed by entries of KeyHash (uint32), Type (uint8) and the type-specific value
+static const uint32_t k_OverlayConfigSchemaBinaryMagic   = 0x434F5044;    //"DPOC"
+static const uint32_t k_OverlayConfigSchemaBinaryVersion = 1;
+
+static size_t OverlayConfigSchemaFindIndex(const IniSectionCursor& cursor)
+{
+    const uint32_t hash = OverlayConfigSchema::HashKey(cursor.GetKey());
+
+    for (size_t i = 0; i < k_OverlayConfigSchemaCount; ++i)
+    {
+        if ( (g_OverlayConfigSchema[i].KeyHash == hash) && (cursor.KeyEquals(g_OverlayConfigSchema[i].Key)) )
+            return i;
+    }
+
+    return k_OverlayConfigSchemaCount;
+}
+
+static void OverlayConfigSchemaSetDefault(OverlayConfigData& data, const OverlayConfigSchemaEntry& entry)
+{
+    switch (entry.Type)
+    {
+        case ovrl_schema_bool:         data.ConfigBool[entry.ConfigID]  = (entry.DefaultValue != 0);                                            break;
+        case ovrl_schema_int:          data.ConfigInt[entry.ConfigID]   = entry.DefaultValue;                                                   break;
+        case ovrl_schema_float:        data.ConfigFloat[entry.ConfigID] = clamp(entry.DefaultValue / 100.0f, entry.ClampMin, entry.ClampMax);   break;
+        case ovrl_schema_str:          data.ConfigStr[entry.ConfigID].clear();                                                                  break;
+        case ovrl_schema_name:         data.ConfigNameStr.clear();                                                                              break;
+        case ovrl_schema_origin:       data.ConfigInt[entry.ConfigID]   = entry.DefaultValue;                                                   break;
+        case ovrl_schema_action_order: data.ConfigActionBarOrder.clear();                                                                       break;
+        case ovrl_schema_transform:
+        {
+            //Default the transform matrix to zero as an indicator to reset it when possible later
+            float matrix_zero[16] = { 0.0f };
+            data.ConfigTransform = matrix_zero;
+            break;
+        }
+    }
+}
+
+static void OverlayConfigSchemaSetFromString(OverlayConfigData& data, const OverlayConfigSchemaEntry& entry, std::string_view value)
+{
+    switch (entry.Type)
+    {
+        case ovrl_schema_bool:         data.ConfigBool[entry.ConfigID]  = Ini::ParseBool(value);                                                   break;
+        case ovrl_schema_int:          data.ConfigInt[entry.ConfigID]   = Ini::ParseInt(value);                                                    break;
+        case ovrl_schema_float:        data.ConfigFloat[entry.ConfigID] = clamp(Ini::ParseInt(value) / 100.0f, entry.ClampMin, entry.ClampMax);    break;
+        case ovrl_schema_str:          data.ConfigStr[entry.ConfigID]   = value;                                                                   break;
+        case ovrl_schema_name:         data.ConfigNameStr               = value;                                                                   break;
+        case ovrl_schema_origin:       data.ConfigInt[entry.ConfigID]   = ConfigManager::GetOverlayOriginFromConfigString(value);                  break;
+        case ovrl_schema_action_order: data.ConfigActionBarOrder        = ActionManager::ActionOrderListFromString(std::string(value));            break;
+        case ovrl_schema_transform:
+        {
+            //Only set when there's something in the file, or else it defaults to identity instead of zero
+            if (!value.empty())
+            {
+                data.ConfigTransform = Matrix4(std::string(value));
+            }
+            else
+            {
+                OverlayConfigSchemaSetDefault(data, entry);
+            }
+            break;
+        }
+    }
+}
+
+template <typename T>
+static void OverlayConfigSchemaWriteValue(std::string& str, const T& value)
+{
+    str.append((const char*)&value, sizeof(T));
+}
+
+template <typename T>
+static bool OverlayConfigSchemaReadValue(const std::string& str, size_t& pos, T& value)
+{
+    if (str.size() - pos < sizeof(T))
+        return false;
+
+    memcpy(&value, str.data() + pos, sizeof(T));
+    pos += sizeof(T);
+
+    return true;
+}
+
+static void OverlayConfigSchemaWriteString(std::string& str, const std::string& value)
+{
+    OverlayConfigSchemaWriteValue(str, (uint32_t)value.size());
+    str.append(value);
+}
+
+static bool OverlayConfigSchemaReadString(const std::string& str, size_t& pos, std::string_view& value)
+{
+    uint32_t length = 0;
+
+    if ( (!OverlayConfigSchemaReadValue(str, pos, length)) || (str.size() - pos < length) )
+        return false;
+
+    value = std::string_view(str.data() + pos, length);
+    pos += length;
+
+    return true;
+}
+
+//Reads all entries from binary data. Only validates the data if data_ptr is nullptr
+static bool OverlayConfigSchemaReadEntries(OverlayConfigData* data_ptr, const std::string& str)
+{
+    size_t pos = 0;
+    uint32_t magic = 0, version = 0, entry_count = 0;
+
+    if ( (!OverlayConfigSchemaReadValue(str, pos, magic)) || (!OverlayConfigSchemaReadValue(str, pos, version)) || (!OverlayConfigSchemaReadValue(str, pos, entry_count)) )
+        return false;
+
+    if ( (magic != k_OverlayConfigSchemaBinaryMagic) || (version != k_OverlayConfigSchemaBinaryVersion) )
+        return false;
+
+    for (uint32_t i = 0; i < entry_count; ++i)
+    {
+        uint32_t key_hash = 0;
+        uint8_t type = 0;
+
+        if ( (!OverlayConfigSchemaReadValue(str, pos, key_hash)) || (!OverlayConfigSchemaReadValue(str, pos, type)) )
+            return false;
+
+        //Find matching entry. Entries with unknown keys or a different type are read but not applied
+        const OverlayConfigSchemaEntry* entry = nullptr;
+        for (const OverlayConfigSchemaEntry& schema_entry : g_OverlayConfigSchema)
+        {
+            if ( (schema_entry.KeyHash == key_hash) && (schema_entry.Type == type) )
+            {
+                entry = &schema_entry;
+                break;
+            }
+        }
+
+        OverlayConfigData* data = (entry != nullptr) ? data_ptr : nullptr;
+
+        switch (type)
+        {
+            case ovrl_schema_bool:
+            {
+                uint8_t value = 0;
+                if (!OverlayConfigSchemaReadValue(str, pos, value))
+                    return false;
+
+                if (data != nullptr)
+                    data->ConfigBool[entry->ConfigID] = (value != 0);
+                break;
+            }
+            case ovrl_schema_int:
+            case ovrl_schema_origin:
+            {
+                int32_t value = 0;
+                if (!OverlayConfigSchemaReadValue(str, pos, value))
+                    return false;
+
+                if (data != nullptr)
+                    data->ConfigInt[entry->ConfigID] = value;
+                break;
+            }
+            case ovrl_schema_float:
+            {
+                float value = 0.0f;
+                if (!OverlayConfigSchemaReadValue(str, pos, value))
+                    return false;
+
+                if (data != nullptr)
+                    data->ConfigFloat[entry->ConfigID] = clamp(value, entry->ClampMin, entry->ClampMax);
+                break;
+            }
+            case ovrl_schema_str:
+            case ovrl_schema_name:
+            {
+                std::string_view value;
+                if (!OverlayConfigSchemaReadString(str, pos, value))
+                    return false;
+
+                if (data != nullptr)
+                {
+                    if (type == ovrl_schema_name)
+                        data->ConfigNameStr = value;
+                    else
+                        data->ConfigStr[entry->ConfigID] = value;
+                }
+                break;
+            }
+            case ovrl_schema_action_order:
+            {
+                uint32_t count = 0;
+                if ( (!OverlayConfigSchemaReadValue(str, pos, count)) || ( (str.size() - pos) / sizeof(ActionUID) < count ) )
+                    return false;
+
+                if (data != nullptr)
+                {
+                    data->ConfigActionBarOrder.resize(count);
+                    memcpy(data->ConfigActionBarOrder.data(), str.data() + pos, count * sizeof(ActionUID));
+                }
+
+                pos += count * sizeof(ActionUID);
+                break;
+            }
+            case ovrl_schema_transform:
+            {
+                float matrix[16];
+                if (!OverlayConfigSchemaReadValue(str, pos, matrix))
+                    return false;
+
+                if (data != nullptr)
+                    data->ConfigTransform = matrix;
+                break;
+            }
+            default: return false;  //Unknown type, can't know how to skip it
+        }
+    }
+
+    return true;
+}
+
+const OverlayConfigSchemaEntry* OverlayConfigSchema::GetEntries()
+{
+    return g_OverlayConfigSchema;
+}
+
+size_t OverlayConfigSchema::GetEntryCount()
+{
+    return k_OverlayConfigSchemaCount;
+}
+
+const OverlayConfigSchemaEntry* OverlayConfigSchema::FindEntry(const char* key)
+{
+    const uint32_t hash = HashKey(key);
+
+    for (const OverlayConfigSchemaEntry& entry : g_OverlayConfigSchema)
+    {
+        if ( (entry.KeyHash == hash) && (_stricmp(entry.Key, key) == 0) )
+            return &entry;
+    }
+
+    return nullptr;
+}
+
+void OverlayConfigSchema::LoadSection(OverlayConfigData& data, const Ini& config, const char* section)
+{
+    bool is_loaded[k_OverlayConfigSchemaCount] = { false };
+
+    IniSectionCursor cursor = config.GetSectionCursor(section);
+
+    while (cursor.Next())
+    {
+        const size_t index = OverlayConfigSchemaFindIndex(cursor);
+
+        //Skip unknown keys and duplicates. The first one wins, same as with regular key lookups
+        if ( (index == k_OverlayConfigSchemaCount) || (is_loaded[index]) )
+            continue;
+
+        OverlayConfigSchemaSetFromString(data, g_OverlayConfigSchema[index], cursor.GetValue());
+        is_loaded[index] = true;
+    }
+
+    for (size_t i = 0; i < k_OverlayConfigSchemaCount; ++i)
+    {
+        if (!is_loaded[i])
+        {
+            OverlayConfigSchemaSetDefault(data, g_OverlayConfigSchema[i]);
+        }
+    }
+}
+
+void OverlayConfigSchema::SaveSection(const OverlayConfigData& data, Ini& config, const char* section)
+{
+    for (const OverlayConfigSchemaEntry& entry : g_OverlayConfigSchema)
+    {
+        switch (entry.Type)
+        {
+            case ovrl_schema_bool:         config.WriteBool(section,   entry.Key, data.ConfigBool[entry.ConfigID]);                                                          break;
+            case ovrl_schema_int:          config.WriteInt(section,    entry.Key, data.ConfigInt[entry.ConfigID]);                                                           break;
+            case ovrl_schema_float:        config.WriteInt(section,    entry.Key, int(data.ConfigFloat[entry.ConfigID] * 100.0f));                                           break;
+            case ovrl_schema_str:          config.WriteString(section, entry.Key, data.ConfigStr[entry.ConfigID].c_str());                                                   break;
+            case ovrl_schema_name:         config.WriteString(section, entry.Key, data.ConfigNameStr.c_str());                                                               break;
+            case ovrl_schema_origin:       config.WriteString(section, entry.Key, ConfigManager::GetConfigStringForOverlayOrigin((OverlayOrigin)data.ConfigInt[entry.ConfigID])); break;
+            case ovrl_schema_action_order: config.WriteString(section, entry.Key, ActionManager::ActionOrderListToString(data.ConfigActionBarOrder).c_str());                break;
+            case ovrl_schema_transform:    config.WriteString(section, entry.Key, data.ConfigTransform.toString().c_str());                                                  break;
+        }
+    }
+}
+
+void OverlayConfigSchema::CopyValues(const OverlayConfigData& source, OverlayConfigData& target)
+{
+    for (const OverlayConfigSchemaEntry& entry : g_OverlayConfigSchema)
+    {
+        switch (entry.Type)
+        {
+            case ovrl_schema_bool:         target.ConfigBool[entry.ConfigID]  = source.ConfigBool[entry.ConfigID];  break;
+            case ovrl_schema_int:
+            case ovrl_schema_origin:       target.ConfigInt[entry.ConfigID]   = source.ConfigInt[entry.ConfigID];   break;
+            case ovrl_schema_float:        target.ConfigFloat[entry.ConfigID] = source.ConfigFloat[entry.ConfigID]; break;
+            case ovrl_schema_str:          target.ConfigStr[entry.ConfigID]   = source.ConfigStr[entry.ConfigID];   break;
+            case ovrl_schema_name:         target.ConfigNameStr               = source.ConfigNameStr;               break;
+            case ovrl_schema_action_order: target.ConfigActionBarOrder        = source.ConfigActionBarOrder;        break;
+            case ovrl_schema_transform:    target.ConfigTransform             = source.ConfigTransform;             break;
+        }
+    }
+}
+
+std::string OverlayConfigSchema::Serialize(const OverlayConfigData& data)
+{
+    std::string str;
+
+    OverlayConfigSchemaWriteValue(str, k_OverlayConfigSchemaBinaryMagic);
+    OverlayConfigSchemaWriteValue(str, k_OverlayConfigSchemaBinaryVersion);
+    OverlayConfigSchemaWriteValue(str, (uint32_t)k_OverlayConfigSchemaCount);
+
+    for (const OverlayConfigSchemaEntry& entry : g_OverlayConfigSchema)
+    {
+        OverlayConfigSchemaWriteValue(str, entry.KeyHash);
+        OverlayConfigSchemaWriteValue(str, (uint8_t)entry.Type);
+
+        switch (entry.Type)
+        {
+            case ovrl_schema_bool:         OverlayConfigSchemaWriteValue(str, (uint8_t)data.ConfigBool[entry.ConfigID]);  break;
+            case ovrl_schema_int:
+            case ovrl_schema_origin:       OverlayConfigSchemaWriteValue(str, (int32_t)data.ConfigInt[entry.ConfigID]);   break;
+            case ovrl_schema_float:        OverlayConfigSchemaWriteValue(str, data.ConfigFloat[entry.ConfigID]);          break;
+            case ovrl_schema_str:          OverlayConfigSchemaWriteString(str, data.ConfigStr[entry.ConfigID]);           break;
+            case ovrl_schema_name:         OverlayConfigSchemaWriteString(str, data.ConfigNameStr);                       break;
+            case ovrl_schema_action_order:
+            {
+                OverlayConfigSchemaWriteValue(str, (uint32_t)data.ConfigActionBarOrder.size());
+                str.append((const char*)data.ConfigActionBarOrder.data(), data.ConfigActionBarOrder.size() * sizeof(ActionUID));
+                break;
+            }
+            case ovrl_schema_transform:    str.append((const char*)data.ConfigTransform.get(), sizeof(float) * 16);       break;
+        }
+    }
+
+    return str;
+}
+
+bool OverlayConfigSchema::Deserialize(OverlayConfigData& data, const std::string& str)
+{
+    //Validate everything first so data is never left partially changed
+    if (!OverlayConfigSchemaReadEntries(nullptr, str))
+        return false;
+
+    return OverlayConfigSchemaReadEntries(&data, str);
+}
@@ -0,0 +1,70 @@
+//Schema of the overlay config values stored in overlay profiles
+//Loading and saving a profile section is driven by a single compile-time table, so both directions always use the same keys and defaults
+//The binary form stores the same values tagged by key hash instead of ConfigID, so it stays readable when ConfigIDs are added or reordered
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+class Ini;
+class OverlayConfigData;
+
+enum OverlayConfigSchemaType : uint8_t
+{
+    ovrl_schema_bool,
+    ovrl_schema_int,
+    ovrl_schema_float,          //Stored as int * 100 in the ini
+    ovrl_schema_str,
+    ovrl_schema_name,           //ConfigNameStr
+    ovrl_schema_origin,         //ConfigInt[configid_int_overlay_origin], stored as origin name
+    ovrl_schema_action_order,   //ConfigActionBarOrder
+    ovrl_schema_transform       //ConfigTransform, zero matrix if missing
+};
+
+struct OverlayConfigSchemaEntry
+{
+    OverlayConfigSchemaType Type;
+    int ConfigID;               //-1 for types not stored in a config array
+    const char* Key;
+    int DefaultValue;           //Value as it's stored in the ini, so floats are * 100
+    float ClampMin;
+    float ClampMax;
+    uint32_t KeyHash;           //Case-insensitive hash of Key
+};
+
+class OverlayConfigSchema
+{
+    public:
+        static const OverlayConfigSchemaEntry* GetEntries();
+        static size_t GetEntryCount();
+        static const OverlayConfigSchemaEntry* FindEntry(const char* key);     //Case-insensitive, returns nullptr if key isn't part of the schema
+
+        //Reads all schema values from the section in a single pass. Values missing from the section are set to their default
+        static void LoadSection(OverlayConfigData& data, const Ini& config, const char* section);
+        //Writes all schema values to the section in table order
+        static void SaveSection(const OverlayConfigData& data, Ini& config, const char* section);
+        //Copies only the schema values, leaving state values of target as they are
+        static void CopyValues(const OverlayConfigData& source, OverlayConfigData& target);
+
+        //Serializes into binary data stored as string (contains NUL bytes). Only schema values are written, not state values
+        static std::string Serialize(const OverlayConfigData& data);
+        //Deserializes from strings created by above function. Unknown entries are skipped and values missing from the data are left unchanged
+        //Returns false and leaves data untouched if the data is malformed
+        static bool Deserialize(OverlayConfigData& data, const std::string& str);
+
+        static constexpr uint32_t HashKey(std::string_view key)
+        {
+            //FNV-1a on the lowercase key
+            uint32_t hash = 2166136261u;
+
+            for (const char c : key)
+            {
+                const char c_lower = ( (c >= 'A') && (c <= 'Z') ) ? c - 'A' + 'a' : c;
+                hash = (hash ^ (uint8_t)c_lower) * 16777619u;
+            }
+
+            return hash;
+        }
+};
@@ -671,9 +671,9 @@ float OverlayDragger::DragAddWidth(float width)
 
         #ifndef DPLUS_UI
             //Send adjusted width to the UI app
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)m_DragModeOverlayID);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)m_DragModeOverlayID);
             IPCManager::Get().PostConfigMessageToUIApp(configid_float_overlay_width, overlay_width);
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
         #endif
     }
 
@@ -812,9 +812,9 @@ void OverlayDragger::DragGestureUpdate()
 
                     #ifndef DPLUS_UI
                     //Send adjusted width to the UI app
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)m_DragModeOverlayID);
+                    IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)m_DragModeOverlayID);
                     IPCManager::Get().PostConfigMessageToUIApp(configid_float_overlay_width, width);
-                    IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+                    IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
                     #endif
                 }
             }
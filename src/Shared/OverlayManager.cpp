@@ -28,7 +28,7 @@ OverlayManager& OverlayManager::Get()
 #ifndef DPLUS_UI
     OverlayManager::OverlayManager() : m_CurrentOverlayID(0), m_OverlayNull(k_ulOverlayID_None), m_TheaterOverlayHandle(vr::k_ulOverlayHandleInvalid),
                                        m_TheaterOverlayReferenceHandle(vr::k_ulOverlayHandleInvalid), m_CurrentTheaterOverlayOrigHandle(vr::k_ulOverlayHandleInvalid), 
-                                       m_CurrentTheaterOverlayID(k_ulOverlayID_None)
+                                       m_CurrentTheaterOverlayID(k_ulOverlayID_None), m_IsHandleSyncDeferred(false)
 #else
     OverlayManager::OverlayManager() : m_CurrentOverlayID(0)
 #endif
@@ -238,9 +238,12 @@ unsigned int OverlayManager::DuplicateOverlay(const OverlayConfigData& data, uns
     #ifndef DPLUS_UI
         new_data.ConfigHandle[configid_handle_overlay_state_overlay_handle] = m_Overlays.back().GetHandle();
 
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)id);
-        IPCManager::Get().PostConfigMessageToUIApp(configid_handle_overlay_state_overlay_handle, new_data.ConfigHandle[configid_handle_overlay_state_overlay_handle]);
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+        if (!m_IsHandleSyncDeferred)
+        {
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)id);
+            IPCManager::Get().PostConfigMessageToUIApp(configid_handle_overlay_state_overlay_handle, new_data.ConfigHandle[configid_handle_overlay_state_overlay_handle]);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
+        }
     #endif
 
     return id;
@@ -312,9 +315,9 @@ unsigned int OverlayManager::AddOverlay(OverlayCaptureSource capture_source, int
     #ifndef DPLUS_UI
         data.ConfigHandle[configid_handle_overlay_state_overlay_handle] = m_Overlays.back().GetHandle();
 
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)id);
+        IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)id);
         IPCManager::Get().PostConfigMessageToUIApp(configid_handle_overlay_state_overlay_handle, data.ConfigHandle[configid_handle_overlay_state_overlay_handle]);
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+        IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
     #endif
 
     return id;
@@ -471,9 +474,9 @@ void OverlayManager::SetTheaterOverlayID(unsigned int id)
         ConfigManager::SetValue(configid_handle_state_theater_orig_overlay_handle, vr::k_ulOverlayHandleInvalid);
 
         //Send handle change over to UI
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)m_CurrentTheaterOverlayID);
+        IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)m_CurrentTheaterOverlayID);
         IPCManager::Get().PostConfigMessageToUIApp(configid_handle_overlay_state_overlay_handle, m_CurrentTheaterOverlayOrigHandle);
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+        IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
 
         IPCManager::Get().PostConfigMessageToUIApp(configid_handle_state_theater_orig_overlay_handle, vr::k_ulOverlayHandleInvalid);
 
@@ -493,9 +496,9 @@ void OverlayManager::SetTheaterOverlayID(unsigned int id)
         ConfigManager::SetValue(configid_handle_state_theater_orig_overlay_handle, m_CurrentTheaterOverlayOrigHandle);
 
         //Send handle change over to UI
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)m_CurrentTheaterOverlayID);
+        IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)m_CurrentTheaterOverlayID);
         IPCManager::Get().PostConfigMessageToUIApp(configid_handle_overlay_state_overlay_handle, m_TheaterOverlayHandle);
-        IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+        IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
 
         IPCManager::Get().PostConfigMessageToUIApp(configid_handle_state_theater_orig_overlay_handle, m_CurrentTheaterOverlayOrigHandle);
 
@@ -525,9 +528,9 @@ void OverlayManager::ClearTheaterOverlay(bool no_ui_update)
         //Send handle change over to UI (this should be skipped when the current theater overlay is in the process of being removed)
         if (!no_ui_update)
         {
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, (int)m_CurrentTheaterOverlayID);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_begin, (int)m_CurrentTheaterOverlayID);
             IPCManager::Get().PostConfigMessageToUIApp(configid_handle_overlay_state_overlay_handle, m_CurrentTheaterOverlayOrigHandle);
-            IPCManager::Get().PostConfigMessageToUIApp(configid_int_state_overlay_current_id_override, -1);
+            IPCManager::Get().PostMessageToUIApp(ipcmsg_action, ipcact_config_transaction_commit);
 
             IPCManager::Get().PostConfigMessageToUIApp(configid_handle_state_theater_orig_overlay_handle, vr::k_ulOverlayHandleInvalid);
         }
@@ -557,6 +560,11 @@ void OverlayManager::ClearTheaterOverlay(bool no_ui_update)
     }
 }
 
+void OverlayManager::SetHandleSyncDeferred(bool is_deferred)
+{
+    m_IsHandleSyncDeferred = is_deferred;
+}
+
 #endif
 
 OverlayConfigData& OverlayManager::GetConfigData(unsigned int id)
@@ -680,6 +688,11 @@ void OverlayManager::SwapOverlays(unsigned int id, unsigned int id2)
 
         //Fixup theater overlay ID if needed
         m_CurrentTheaterOverlayID = (m_CurrentTheaterOverlayID == id) ? id2 : (m_CurrentTheaterOverlayID == id2) ? id : m_CurrentTheaterOverlayID;
+
+        if (OutputManager* outmgr = OutputManager::Get())
+        {
+            outmgr->SwapPendingApplyStages(id, id2);
+        }
     #endif
 
     #ifdef DPLUS_UI
@@ -770,10 +783,11 @@ void OverlayManager::RemoveOverlay(unsigned int id)
                 m_CurrentTheaterOverlayID--;
             }
 
-            //Keep active count correct
+            //Keep active count and pending apply stages correct
             if (OutputManager* outmgr = OutputManager::Get())
             {
                 outmgr->ResetOverlayActiveCount();
+                outmgr->RemovePendingApplyStages(id);
             }
         #else
             //Remove assigned keyboard overlay ID or fix it up if it was higher than the removed one
@@ -846,6 +860,7 @@ void OverlayManager::RemoveAllOverlays()
         if (OutputManager* outmgr = OutputManager::Get())
         {
             outmgr->ResetOverlayActiveCount();
+            outmgr->RemovePendingApplyStages(k_ulOverlayID_None);
         }
     #endif
 }
@@ -939,7 +954,7 @@ OverlayIDList OverlayManager::FindInactiveOverlaysForWindow(const WindowInfo& wi
             //Check if class/exe name matches and search title can be found in the last stored window title (but just skip if overlay uses strict matching)
             if ( (!data.ConfigBool[configid_bool_overlay_winrt_window_matching_strict]) &&
                  (window_info.IsClassNameMatching(overlay_class_name_wstr[i])) && (data.ConfigStr[configid_str_overlay_winrt_last_window_exe_name] == window_info.GetExeName()) &&
-                 (data.ConfigStr[configid_str_overlay_winrt_last_window_title].find(title_search) != std::string::npos) )
+                 (data.ConfigStr[configid_str_overlay_winrt_last_window_title].str().find(title_search) != std::string::npos) )
             {
                 matching_overlay_ids.push_back(i);
             }
@@ -1105,10 +1120,17 @@ std::vector<OverlayManager::TagListEntry> OverlayManager::GetKnownOverlayTagList
         }
     }
 
-    //Add tags referenced by overlays
+    //Add tags referenced by overlays. Overlays with identical tags share the same interned string, so each one only needs to be parsed once
+    std::vector<InternedString> tags_parsed;
     for (const auto& data : m_OverlayConfigData)
     {
-        add_tags_from_tags_string(data.ConfigStr[configid_str_overlay_tags], list, list_unique_tags);
+        const InternedString& tags = data.ConfigStr[configid_str_overlay_tags];
+
+        if ( (tags.empty()) || (std::find(tags_parsed.begin(), tags_parsed.end(), tags) != tags_parsed.end()) )
+            continue;
+
+        add_tags_from_tags_string(tags, list, list_unique_tags);
+        tags_parsed.push_back(tags);
     }
 
     return list;
@@ -1129,12 +1151,12 @@ void OverlayManager::SetOverlayNameAuto(unsigned int id, const WindowInfo* windo
         if (data.ConfigBool[configid_bool_overlay_name_custom])
             return;
 
-        data.ConfigNameStr = "";
+        std::string name;
 
         //If override window info passed, use that
         if (window_info != nullptr)
         {
-            data.ConfigNameStr += StringConvertFromUTF16(window_info->GetTitle().c_str());
+            data.ConfigNameStr = StringConvertFromUTF16(window_info->GetTitle().c_str());
             return;
         }
 
@@ -1142,28 +1164,28 @@ void OverlayManager::SetOverlayNameAuto(unsigned int id, const WindowInfo* windo
         {
             case ovrl_capsource_desktop_duplication:
             {
-                data.ConfigNameStr += TranslationManager::Get().GetDesktopIDString(data.ConfigInt[configid_int_overlay_desktop_id]);
+                name = TranslationManager::Get().GetDesktopIDString(data.ConfigInt[configid_int_overlay_desktop_id]);
                 break;
             }
             case ovrl_capsource_winrt_capture:
             {
                 if (data.ConfigHandle[configid_handle_overlay_state_winrt_hwnd] != 0)
                 {
-                    data.ConfigNameStr += data.ConfigStr[configid_str_overlay_winrt_last_window_title];
+                    name = data.ConfigStr[configid_str_overlay_winrt_last_window_title];
                 }
                 else if (data.ConfigInt[configid_int_overlay_winrt_desktop_id] != -2)
                 {
-                    data.ConfigNameStr += TranslationManager::Get().GetDesktopIDString(data.ConfigInt[configid_int_overlay_winrt_desktop_id]);
+                    name = TranslationManager::Get().GetDesktopIDString(data.ConfigInt[configid_int_overlay_winrt_desktop_id]);
                 }
                 else
                 {
-                    data.ConfigNameStr += TranslationManager::GetString(tstr_SourceWinRTNone);
+                    name = TranslationManager::GetString(tstr_SourceWinRTNone);
                 }
                 break;
             }
             case ovrl_capsource_ui:
             {
-                data.ConfigNameStr += TranslationManager::GetString(tstr_SourcePerformanceMonitor); //So far all UI overlays are just that
+                name = TranslationManager::GetString(tstr_SourcePerformanceMonitor); //So far all UI overlays are just that
                 break;
             }
             case ovrl_capsource_browser:
@@ -1175,15 +1197,17 @@ void OverlayManager::SetOverlayNameAuto(unsigned int id, const WindowInfo* windo
 
                 if (!title.empty())
                 {
-                    data.ConfigNameStr += title;
+                    name = title;
                 }
                 else
                 {
-                    data.ConfigNameStr += TranslationManager::GetString(tstr_SourceBrowserNoPage);
+                    name = TranslationManager::GetString(tstr_SourceBrowserNoPage);
                 }
                 break;
             }
         }
+
+        data.ConfigNameStr = name;
     }
 }
 
@@ -34,6 +34,7 @@ class OverlayManager
             vr::VROverlayHandle_t m_TheaterOverlayReferenceHandle;      //Handle of the cursor overlay used as theater overlay reference transform
             vr::VROverlayHandle_t m_CurrentTheaterOverlayOrigHandle;    //Handle of the overlay originally held by current theater overlay
             unsigned int m_CurrentTheaterOverlayID;                     //ID of overlay the theater overlay duplicates
+            bool m_IsHandleSyncDeferred;                                //DuplicateOverlay() doesn't send new overlay handles to the UI while set
         #endif
         std::vector<OverlayConfigData> m_OverlayConfigData;
 
@@ -64,6 +65,9 @@ class OverlayManager
             unsigned int GetTheaterOverlayID() const;
             void SetTheaterOverlayID(unsigned int id);
             void ClearTheaterOverlay(bool no_ui_update = false);
+
+            //While set, DuplicateOverlay() skips sending new overlay handles to the UI so the caller can send them in a single ConfigDelta instead
+            void SetHandleSyncDeferred(bool is_deferred);
         #endif
         OverlayConfigData& GetConfigData(unsigned int id);
         const OverlayConfigData& GetConfigData(unsigned int id) const;
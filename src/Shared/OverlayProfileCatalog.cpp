@@ -0,0 +1,250 @@
+#include "OverlayProfileCatalog.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "Ini.h"
+#include "Util.h"
+
+static uint64_t FileTimeToUInt64(const FILETIME& file_time)
+{
+    return ((uint64_t)file_time.dwHighDateTime << 32) | file_time.dwLowDateTime;
+}
+
+OverlayProfileChangeNotifierPolling::OverlayProfileChangeNotifierPolling(unsigned int interval_ms) : m_IntervalMS(interval_ms)
+{
+}
+
+bool OverlayProfileChangeNotifierPolling::HasChanged(const std::wstring& directory)
+{
+    const ULONGLONG tick = ::GetTickCount64();
+
+    if ( (m_LastPollTick != 0) && (tick - m_LastPollTick < m_IntervalMS) )
+        return false;
+
+    m_LastPollTick = tick;
+
+    WIN32_FILE_ATTRIBUTE_DATA attr_data;
+    const uint64_t write_time = (::GetFileAttributesExW(directory.c_str(), GetFileExInfoStandard, &attr_data) != 0) ? FileTimeToUInt64(attr_data.ftLastWriteTime) : 0;
+
+    if (write_time != m_LastWriteTime)
+    {
+        m_LastWriteTime = write_time;
+        return true;
+    }
+
+    return false;
+}
+
+
+OverlayProfileCatalog::OverlayProfileCatalog() : m_Notifier(std::make_unique<OverlayProfileChangeNotifierPolling>())
+{
+}
+
+void OverlayProfileCatalog::Update()
+{
+    //Always ask the notifier so it stays in sync, even if a scan is pending anyways
+    const bool has_changed = ( (m_Notifier != nullptr) && (m_Notifier->HasChanged(m_Directory)) );
+
+    if ( (m_IsScanPending) || (has_changed) )
+    {
+        Scan();
+    }
+}
+
+void OverlayProfileCatalog::Scan()
+{
+    std::vector<OverlayProfileCatalogEntry> entries;
+
+    WIN32_FIND_DATA find_data;
+    HANDLE handle_find = ::FindFirstFileW((m_Directory + L"*.ini").c_str(), &find_data);
+
+    if (handle_find != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                continue;
+
+            std::string name = StringConvertFromUTF16(find_data.cFileName);
+            name = name.substr(0, name.length() - 4);   //Remove extension
+
+            const uint64_t file_size  = ((uint64_t)find_data.nFileSizeHigh << 32) | find_data.nFileSizeLow;
+            const uint64_t write_time = FileTimeToUInt64(find_data.ftLastWriteTime);
+
+            //Keep what we know about unchanged files
+            OverlayProfileCatalogEntry* entry_prev = FindEntry(name);
+
+            if ( (entry_prev != nullptr) && (entry_prev->FileSize == file_size) && (entry_prev->WriteTime == write_time) )
+            {
+                entries.push_back(std::move(*entry_prev));
+            }
+            else
+            {
+                OverlayProfileCatalogEntry entry;
+                entry.Name      = name;
+                entry.FileSize  = file_size;
+                entry.WriteTime = write_time;
+                AddGlyphs(entry.GlyphString, entry.Name);
+
+                entries.push_back(std::move(entry));
+            }
+        }
+        while (::FindNextFileW(handle_find, &find_data) != 0);
+
+        ::FindClose(handle_find);
+    }
+
+    m_Entries = std::move(entries);
+
+    m_NameList.clear();
+    for (const OverlayProfileCatalogEntry& entry : m_Entries)
+    {
+        m_NameList.push_back(entry.Name);
+    }
+
+    m_IsScanPending = false;
+    m_IsGlyphStringPending = true;
+}
+
+void OverlayProfileCatalog::LoadOverlayList(OverlayProfileCatalogEntry& entry)
+{
+    entry.OverlayList.clear();
+    entry.GlyphString.clear();
+    AddGlyphs(entry.GlyphString, entry.Name);
+
+    Ini config(m_Directory + WStringConvertFromUTF8(std::string(entry.Name + ".ini").c_str()), false, true);
+    unsigned int overlay_id = 0;
+
+    std::stringstream ss;
+    ss << "Overlay" << overlay_id;
+
+    //Get names and origin from all sequential overlay sections that exist
+    while (config.SectionExists(ss.str().c_str()))
+    {
+        overlay_id++;
+
+        std::string name(config.ReadString(ss.str().c_str(), "Name"));
+        OverlayOrigin origin = ConfigManager::GetOverlayOriginFromConfigString(config.ReadStringView(ss.str().c_str(), "Origin"));
+
+        entry.OverlayList.push_back( std::make_pair(name.empty() ? ss.str() : name, origin) );   //Name should never be blank with compatible profiles, but offer alternative just in case
+        AddGlyphs(entry.GlyphString, entry.OverlayList.back().first);
+
+        ss = std::stringstream();
+        ss << "Overlay" << overlay_id;
+    }
+
+    entry.IsOverlayListLoaded = true;
+    m_IsGlyphStringPending = true;
+}
+
+OverlayProfileCatalogEntry* OverlayProfileCatalog::FindEntry(const std::string& name)
+{
+    auto it = std::find_if(m_Entries.begin(), m_Entries.end(), [&](const auto& entry){ return (entry.Name == name); });
+
+    return (it != m_Entries.end()) ? &*it : nullptr;
+}
+
+void OverlayProfileCatalog::AddGlyphs(std::string& glyph_string, const std::string& str)
+{
+    //Append each non-ASCII UTF-8 sequence that isn't in the string yet
+    size_t pos = 0;
+    while (pos < str.length())
+    {
+        const unsigned char c = (unsigned char)str[pos];
+        const size_t length = (c < 0x80) ? 1 : (c < 0xE0) ? 2 : (c < 0xF0) ? 3 : 4;
+
+        if (c >= 0x80)
+        {
+            const std::string sequence = str.substr(pos, length);
+
+            if (glyph_string.find(sequence) == std::string::npos)
+            {
+                glyph_string += sequence;
+            }
+        }
+
+        pos += length;
+    }
+}
+
+void OverlayProfileCatalog::SetDirectory(const std::wstring& directory)
+{
+    m_Directory = directory;
+    m_Entries.clear();
+    Invalidate();
+}
+
+void OverlayProfileCatalog::SetChangeNotifier(std::unique_ptr<OverlayProfileChangeNotifier> notifier)
+{
+    m_Notifier = std::move(notifier);
+    Invalidate();
+}
+
+void OverlayProfileCatalog::Invalidate()
+{
+    m_IsScanPending = true;
+}
+
+const std::vector<std::string>& OverlayProfileCatalog::GetProfileNameList()
+{
+    Update();
+
+    return m_NameList;
+}
+
+const std::vector< std::pair<std::string, OverlayOrigin> >& OverlayProfileCatalog::GetOverlayList(const std::string& name)
+{
+    static const std::vector< std::pair<std::string, OverlayOrigin> > empty_list;
+
+    Update();
+
+    OverlayProfileCatalogEntry* entry = FindEntry(name);
+    if (entry == nullptr)
+        return empty_list;
+
+    //Check if the file changed since we last looked at it. Cheap compared to parsing it again
+    WIN32_FILE_ATTRIBUTE_DATA attr_data;
+    if (::GetFileAttributesExW((m_Directory + WStringConvertFromUTF8(std::string(name + ".ini").c_str())).c_str(), GetFileExInfoStandard, &attr_data) == 0)
+    {
+        //File is gone, rescan next time
+        Invalidate();
+        return empty_list;
+    }
+
+    const uint64_t file_size  = ((uint64_t)attr_data.nFileSizeHigh << 32) | attr_data.nFileSizeLow;
+    const uint64_t write_time = FileTimeToUInt64(attr_data.ftLastWriteTime);
+
+    if ( (!entry->IsOverlayListLoaded) || (entry->FileSize != file_size) || (entry->WriteTime != write_time) )
+    {
+        entry->FileSize  = file_size;
+        entry->WriteTime = write_time;
+        LoadOverlayList(*entry);
+    }
+
+    return entry->OverlayList;
+}
+
+size_t OverlayProfileCatalog::GetOverlayCount(const std::string& name)
+{
+    return GetOverlayList(name).size();
+}
+
+const std::string& OverlayProfileCatalog::GetGlyphString()
+{
+    Update();
+
+    if (m_IsGlyphStringPending)
+    {
+        m_GlyphString.clear();
+
+        for (const OverlayProfileCatalogEntry& entry : m_Entries)
+        {
+            AddGlyphs(m_GlyphString, entry.GlyphString);
+        }
+
+        m_IsGlyphStringPending = false;
+    }
+
+    return m_GlyphString;
+}
@@ -0,0 +1,75 @@
+//Cached listing of the overlay profiles in the profiles directory
+//Profile names come from the directory listing, overlay names and origins are read from a profile when first requested and kept until its file changes
+//Changes to the directory are picked up through an OverlayProfileChangeNotifier. Profiles written by Desktop+ itself invalidate the catalog directly
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+
+#include "ConfigManager.h"
+
+class OverlayProfileChangeNotifier
+{
+    public:
+        virtual ~OverlayProfileChangeNotifier() = default;
+        virtual bool HasChanged(const std::wstring& directory) = 0;     //Returns true if the directory may have changed since the last call
+};
+
+//Stand-in notifier checking the directory's write time at most once per interval
+//The write time of a directory changes when files are added, removed or renamed. Changes to file contents are caught by the per-file check
+class OverlayProfileChangeNotifierPolling : public OverlayProfileChangeNotifier
+{
+    private:
+        unsigned int m_IntervalMS;
+        ULONGLONG m_LastPollTick = 0;
+        uint64_t m_LastWriteTime = 0;
+
+    public:
+        OverlayProfileChangeNotifierPolling(unsigned int interval_ms = 1000);
+        virtual bool HasChanged(const std::wstring& directory) override;
+};
+
+struct OverlayProfileCatalogEntry
+{
+    std::string Name;                                                   //File name without extension
+    uint64_t FileSize  = 0;
+    uint64_t WriteTime = 0;
+    bool IsOverlayListLoaded = false;
+    std::vector< std::pair<std::string, OverlayOrigin> > OverlayList;   //Names and origins, only valid if IsOverlayListLoaded is true
+    std::string GlyphString;                                            //Non-ASCII characters used by the profile and overlay names (once loaded)
+};
+
+class OverlayProfileCatalog
+{
+    private:
+        std::wstring m_Directory;
+        std::unique_ptr<OverlayProfileChangeNotifier> m_Notifier;
+        std::vector<OverlayProfileCatalogEntry> m_Entries;
+        std::vector<std::string> m_NameList;
+        std::string m_GlyphString;
+        bool m_IsScanPending = true;
+        bool m_IsGlyphStringPending = true;
+
+        void Update();
+        void Scan();
+        void LoadOverlayList(OverlayProfileCatalogEntry& entry);
+        OverlayProfileCatalogEntry* FindEntry(const std::string& name);
+
+        static void AddGlyphs(std::string& glyph_string, const std::string& str);
+
+    public:
+        OverlayProfileCatalog();
+
+        void SetDirectory(const std::wstring& directory);
+        void SetChangeNotifier(std::unique_ptr<OverlayProfileChangeNotifier> notifier);
+        void Invalidate();                                                                              //Rescans the directory on next access
+
+        const std::vector<std::string>& GetProfileNameList();                                          //Profile names in directory order
+        const std::vector< std::pair<std::string, OverlayOrigin> >& GetOverlayList(const std::string& name);
+        size_t GetOverlayCount(const std::string& name);
+        const std::string& GetGlyphString();                                                            //Non-ASCII characters used by all known profile and overlay names
+};
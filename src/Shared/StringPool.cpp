@@ -0,0 +1,215 @@
+#include "StringPool.h"
+
+static const std::string g_EmptyString;
+
+StringPool& StringPool::Get()
+{
+    //Intentionally never destroyed, as global objects holding strings may be destroyed after it otherwise
+    static StringPool* pool = new StringPool();
+    return *pool;
+}
+
+StringPool::Shard& StringPool::GetShard(size_t hash)
+{
+    return m_Shards[hash % k_ShardCount];
+}
+
+InternedStringEntry* StringPool::Acquire(std::string_view str)
+{
+    const size_t hash = std::hash<std::string_view>()(str);
+    Shard& shard = GetShard(hash);
+
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+
+    auto it = shard.Entries.find(str);
+
+    if (it != shard.Entries.end())
+    {
+        it->second->RefCount.fetch_add(1, std::memory_order_relaxed);
+        return it->second.get();
+    }
+
+    std::unique_ptr<InternedStringEntry> entry = std::make_unique<InternedStringEntry>();
+    entry->Str  = str;
+    entry->Hash = hash;
+    entry->RefCount.store(1, std::memory_order_relaxed);
+
+    InternedStringEntry* entry_ptr = entry.get();
+    shard.Entries.emplace(std::string_view(entry_ptr->Str), std::move(entry));
+
+    return entry_ptr;
+}
+
+void StringPool::Release(InternedStringEntry* entry)
+{
+    //Drop the reference without locking unless it might be the last one. Acquire() can only add references while holding the shard's mutex, so the count can't go back up once it's 0
+    unsigned int ref_count = entry->RefCount.load(std::memory_order_relaxed);
+
+    while (ref_count > 1)
+    {
+        if (entry->RefCount.compare_exchange_weak(ref_count, ref_count - 1, std::memory_order_acq_rel))
+            return;
+    }
+
+    Shard& shard = GetShard(entry->Hash);
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+
+    if (entry->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        shard.Entries.erase(std::string_view(entry->Str));
+    }
+}
+
+size_t StringPool::GetEntryCount()
+{
+    size_t count = 0;
+
+    for (Shard& shard : m_Shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        count += shard.Entries.size();
+    }
+
+    return count;
+}
+
+
+InternedString::InternedString(std::string_view str) : m_Entry( (str.empty()) ? nullptr : StringPool::Get().Acquire(str) )
+{
+}
+
+InternedString::InternedString(const std::string& str) : InternedString(std::string_view(str))
+{
+}
+
+InternedString::InternedString(const char* str) : InternedString(std::string_view(str))
+{
+}
+
+InternedString::InternedString(const InternedString& other) : m_Entry(other.m_Entry)
+{
+    //Other handle holds a reference already, so no need to go through the pool
+    if (m_Entry != nullptr)
+    {
+        m_Entry->RefCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+InternedString::InternedString(InternedString&& other) noexcept : m_Entry(other.m_Entry)
+{
+    other.m_Entry = nullptr;
+}
+
+InternedString::~InternedString()
+{
+    Release();
+}
+
+void InternedString::Release()
+{
+    if (m_Entry != nullptr)
+    {
+        StringPool::Get().Release(m_Entry);
+        m_Entry = nullptr;
+    }
+}
+
+InternedString& InternedString::operator=(const InternedString& other)
+{
+    if (m_Entry != other.m_Entry)
+    {
+        InternedString copy(other);
+        std::swap(m_Entry, copy.m_Entry);
+    }
+
+    return *this;
+}
+
+InternedString& InternedString::operator=(InternedString&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        m_Entry = other.m_Entry;
+        other.m_Entry = nullptr;
+    }
+
+    return *this;
+}
+
+InternedString& InternedString::operator=(std::string_view str)
+{
+    //Skip the pool if the string doesn't change
+    if ( (m_Entry != nullptr) ? (m_Entry->Str == str) : (str.empty()) )
+        return *this;
+
+    InternedString new_str(str);
+    std::swap(m_Entry, new_str.m_Entry);
+
+    return *this;
+}
+
+InternedString& InternedString::operator=(const std::string& str)
+{
+    return (*this = std::string_view(str));
+}
+
+InternedString& InternedString::operator=(const char* str)
+{
+    return (*this = std::string_view(str));
+}
+
+void InternedString::clear()
+{
+    Release();
+}
+
+const std::string& InternedString::str() const
+{
+    return (m_Entry != nullptr) ? m_Entry->Str : g_EmptyString;
+}
+
+InternedString::operator const std::string&() const
+{
+    return str();
+}
+
+const char* InternedString::c_str() const
+{
+    return str().c_str();
+}
+
+bool InternedString::empty() const
+{
+    return (m_Entry == nullptr);
+}
+
+size_t InternedString::size() const
+{
+    return str().size();
+}
+
+size_t InternedString::GetHash() const
+{
+    return (m_Entry != nullptr) ? m_Entry->Hash : std::hash<std::string_view>()(std::string_view());
+}
+
+bool InternedString::operator==(const InternedString& other) const
+{
+    return (m_Entry == other.m_Entry);
+}
+
+bool InternedString::operator!=(const InternedString& other) const
+{
+    return (m_Entry != other.m_Entry);
+}
+
+bool InternedString::operator==(const std::string& str) const
+{
+    return (this->str() == str);
+}
+
+bool InternedString::operator!=(const std::string& str) const
+{
+    return (this->str() != str);
+}
@@ -0,0 +1,82 @@
+//Pool of interned, reference-counted strings
+//Equal strings share a single pool entry, so copying an InternedString only copies a pointer and comparing two is a pointer comparison
+//Used for OverlayConfigData strings, which are mostly identical between overlays or rarely change but get copied around a lot
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+struct InternedStringEntry
+{
+    std::string Str;
+    size_t Hash = 0;
+    std::atomic<unsigned int> RefCount {0};
+};
+
+class InternedString
+{
+    private:
+        InternedStringEntry* m_Entry = nullptr;     //nullptr for empty strings, which don't need a pool entry
+
+        void Release();
+
+    public:
+        InternedString() = default;
+        InternedString(std::string_view str);
+        InternedString(const std::string& str);
+        InternedString(const char* str);
+        InternedString(const InternedString& other);
+        InternedString(InternedString&& other) noexcept;
+        ~InternedString();
+
+        InternedString& operator=(const InternedString& other);
+        InternedString& operator=(InternedString&& other) noexcept;
+        InternedString& operator=(std::string_view str);
+        InternedString& operator=(const std::string& str);
+        InternedString& operator=(const char* str);
+
+        void clear();
+
+        const std::string& str() const;
+        operator const std::string&() const;
+        const char* c_str() const;
+        bool empty() const;
+        size_t size() const;
+        size_t GetHash() const;                     //Same as std::hash<std::string_view> of the string
+
+        bool operator==(const InternedString& other) const;     //Pointer comparison only
+        bool operator!=(const InternedString& other) const;
+        bool operator==(const std::string& str) const;
+        bool operator!=(const std::string& str) const;
+};
+
+class StringPool
+{
+    friend class InternedString;
+
+    private:
+        //Entries are split over shards by hash so threads interning different strings rarely wait on each other
+        struct Shard
+        {
+            //Keys are views of the entry's string
+            std::mutex Mutex;
+            std::unordered_map<std::string_view, std::unique_ptr<InternedStringEntry>> Entries;
+        };
+
+        static const size_t k_ShardCount = 16;
+        Shard m_Shards[k_ShardCount];
+
+        Shard& GetShard(size_t hash);
+        InternedStringEntry* Acquire(std::string_view str);
+        void Release(InternedStringEntry* entry);
+
+    public:
+        static StringPool& Get();
+
+        size_t GetEntryCount();
+};
@@ -0,0 +1,227 @@
+#include "UIIntersectionMask.h"
+
+#include <cstring>
+
+static const uint32_t k_UIIntersectionMaskBinaryMagic   = 0x4D495044;    //"DPIM"
+static const uint32_t k_UIIntersectionMaskBinaryVersion = 1;
+static const uint32_t k_UIIntersectionMaskRectCountMax  = 4096;          //Way more than there'll ever be, but keeps bad data from allocating a lot
+
+template <typename T>
+static void UIIntersectionMaskWriteValue(std::string& str, const T& value)
+{
+    str.append((const char*)&value, sizeof(T));
+}
+
+template <typename T>
+static bool UIIntersectionMaskReadValue(const std::string& str, size_t& pos, T& value)
+{
+    if (str.size() - pos < sizeof(T))
+        return false;
+
+    memcpy(&value, str.data() + pos, sizeof(T));
+    pos += sizeof(T);
+
+    return true;
+}
+
+static void UIIntersectionMaskWriteRect(std::string& str, const DPRect& rect)
+{
+    UIIntersectionMaskWriteValue(str, (int32_t)rect.Min.x);
+    UIIntersectionMaskWriteValue(str, (int32_t)rect.Min.y);
+    UIIntersectionMaskWriteValue(str, (int32_t)rect.Max.x);
+    UIIntersectionMaskWriteValue(str, (int32_t)rect.Max.y);
+}
+
+static bool UIIntersectionMaskReadRect(const std::string& str, size_t& pos, DPRect& rect)
+{
+    int32_t min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+
+    if ( (!UIIntersectionMaskReadValue(str, pos, min_x)) || (!UIIntersectionMaskReadValue(str, pos, min_y)) ||
+         (!UIIntersectionMaskReadValue(str, pos, max_x)) || (!UIIntersectionMaskReadValue(str, pos, max_y)) )
+    {
+        return false;
+    }
+
+    rect = DPRect(min_x, min_y, max_x, max_y);
+
+    return true;
+}
+
+uint32_t UIIntersectionMask::ComputeHash(const std::vector<DPRect>& rects)
+{
+    //FNV-1a over the coordinates
+    uint32_t hash = 2166136261u;
+
+    auto hash_value = [&](int value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            hash ^= (uint32_t)(value >> (i * 8)) & 0xFF;
+            hash *= 16777619u;
+        }
+    };
+
+    for (const DPRect& rect : rects)
+    {
+        hash_value(rect.Min.x);
+        hash_value(rect.Min.y);
+        hash_value(rect.Max.x);
+        hash_value(rect.Max.y);
+    }
+
+    hash_value((int)rects.size());
+
+    return hash;
+}
+
+UIIntersectionMask::UIIntersectionMask() : m_Hash(ComputeHash({}))
+{
+}
+
+const std::vector<DPRect>& UIIntersectionMask::GetRects() const
+{
+    return m_Rects;
+}
+
+uint32_t UIIntersectionMask::GetHash() const
+{
+    return m_Hash;
+}
+
+void UIIntersectionMask::Clear()
+{
+    m_Rects.clear();
+    m_Hash = ComputeHash(m_Rects);
+}
+
+std::string UIIntersectionMask::Update(const std::vector<DPRect>& rects, bool force_full)
+{
+    if ( (!force_full) && (rects == m_Rects) )
+        return "";
+
+    const uint32_t hash_new = ComputeHash(rects);
+
+    //Collect changed rects and use them if that's smaller than the full mask. Window movement typically only changes a few of them
+    std::vector<uint32_t> changed_ids;
+
+    if (!force_full)
+    {
+        for (size_t i = 0; i < rects.size(); ++i)
+        {
+            if ( (i >= m_Rects.size()) || (!(rects[i] == m_Rects[i])) )
+            {
+                changed_ids.push_back((uint32_t)i);
+            }
+        }
+    }
+
+    const bool is_delta = ( (!force_full) && (changed_ids.size() * (sizeof(uint32_t) + 4 * sizeof(int32_t)) < rects.size() * 4 * sizeof(int32_t)) );
+
+    std::string str;
+
+    UIIntersectionMaskWriteValue(str, k_UIIntersectionMaskBinaryMagic);
+    UIIntersectionMaskWriteValue(str, k_UIIntersectionMaskBinaryVersion);
+    UIIntersectionMaskWriteValue(str, (uint8_t)is_delta);
+    UIIntersectionMaskWriteValue(str, m_Hash);
+    UIIntersectionMaskWriteValue(str, hash_new);
+    UIIntersectionMaskWriteValue(str, (uint32_t)rects.size());
+
+    if (is_delta)
+    {
+        UIIntersectionMaskWriteValue(str, (uint32_t)changed_ids.size());
+
+        for (uint32_t id : changed_ids)
+        {
+            UIIntersectionMaskWriteValue(str, id);
+            UIIntersectionMaskWriteRect(str, rects[id]);
+        }
+    }
+    else
+    {
+        for (const DPRect& rect : rects)
+        {
+            UIIntersectionMaskWriteRect(str, rect);
+        }
+    }
+
+    m_Rects = rects;
+    m_Hash  = hash_new;
+
+    return str;
+}
+
+bool UIIntersectionMask::ApplyUpdate(const std::string& str)
+{
+    size_t pos = 0;
+    uint32_t magic = 0, version = 0, hash_base = 0, hash_new = 0, rect_count = 0;
+    uint8_t is_delta = 0;
+
+    if ( (!UIIntersectionMaskReadValue(str, pos, magic))     || (!UIIntersectionMaskReadValue(str, pos, version))  || (!UIIntersectionMaskReadValue(str, pos, is_delta)) ||
+         (!UIIntersectionMaskReadValue(str, pos, hash_base)) || (!UIIntersectionMaskReadValue(str, pos, hash_new)) || (!UIIntersectionMaskReadValue(str, pos, rect_count)) )
+    {
+        Clear();
+        return false;
+    }
+
+    if ( (magic != k_UIIntersectionMaskBinaryMagic) || (version != k_UIIntersectionMaskBinaryVersion) || (rect_count > k_UIIntersectionMaskRectCountMax) ||
+         ( (is_delta != 0) && (hash_base != m_Hash) ) )
+    {
+        Clear();
+        return false;
+    }
+
+    std::vector<DPRect> rects;
+
+    if (is_delta != 0)
+    {
+        uint32_t changed_count = 0;
+
+        if ( (!UIIntersectionMaskReadValue(str, pos, changed_count)) || (changed_count > rect_count) )
+        {
+            Clear();
+            return false;
+        }
+
+        rects = m_Rects;
+        rects.resize(rect_count);
+
+        for (uint32_t i = 0; i < changed_count; ++i)
+        {
+            uint32_t id = 0;
+            DPRect rect;
+
+            if ( (!UIIntersectionMaskReadValue(str, pos, id)) || (id >= rect_count) || (!UIIntersectionMaskReadRect(str, pos, rect)) )
+            {
+                Clear();
+                return false;
+            }
+
+            rects[id] = rect;
+        }
+    }
+    else
+    {
+        rects.resize(rect_count);
+
+        for (DPRect& rect : rects)
+        {
+            if (!UIIntersectionMaskReadRect(str, pos, rect))
+            {
+                Clear();
+                return false;
+            }
+        }
+    }
+
+    //Catches deltas which didn't fill in all new rects or were based on a mask with a colliding hash
+    if (ComputeHash(rects) != hash_new)
+    {
+        Clear();
+        return false;
+    }
+
+    m_Rects = std::move(rects);
+    m_Hash  = hash_new;
+
+    return true;
+}
@@ -0,0 +1,34 @@
+//Laser pointer intersection mask of the UI overlays, sent by the UI application to the dashboard application as a single binary payload
+//Updates are only created when the mask changed and only carry the changed rectangles if that's smaller than sending all of them
+//Deltas carry the hash of the mask they're based on, so a receiver that missed an update or restarted can tell and request the full mask again
+//Coordinates are stored as 32-bit values
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "DPRect.h"
+
+class UIIntersectionMask
+{
+    private:
+        std::vector<DPRect> m_Rects;
+        uint32_t m_Hash;
+
+        static uint32_t ComputeHash(const std::vector<DPRect>& rects);
+
+    public:
+        UIIntersectionMask();
+
+        const std::vector<DPRect>& GetRects() const;
+        uint32_t GetHash() const;
+        void Clear();
+
+        //Sender: Sets the mask and returns an update from the previous one serialized into binary data stored as string (contains NUL bytes)
+        //Returns an empty string if the mask didn't change, unless force_full is true, in which case the update always contains the full mask
+        std::string Update(const std::vector<DPRect>& rects, bool force_full = false);
+        //Receiver: Applies an update created by above function. Returns false and clears the mask if the data is malformed or a delta based on a different mask
+        bool ApplyUpdate(const std::string& str);
+};
@@ -17,6 +17,7 @@
 #define VECTORS_H_DEF
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include "openvr.h"
 
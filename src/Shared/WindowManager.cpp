@@ -315,6 +315,7 @@ HWND WindowInfo::FindClosestWindowForTitle(const std::string& title_str, const s
 
 #define WM_WINDOWMANAGER_UPDATE_DATA            WM_APP   //Sent to WindowManager thread to update the local thread data
 #define WM_WINDOWMANAGER_TEXT_INPUT_MOUSE_CLICK WM_APP+1 //Sent to WindowManager thread to indicate a left mouse click happening
+#define WM_WINDOWMANAGER_UPDATE_CONFIG          WM_APP+2 //Sent to WindowManager thread to have it pick up a new config snapshot
 
 WindowManager& WindowManager::Get()
 {
@@ -323,13 +324,16 @@ WindowManager& WindowManager::Get()
 
 void WindowManager::UpdateConfigState()
 {
+    //Make sure the thread sees the config changes made so far
+    ConfigManager::Get().PublishSnapshot();
+
     WindowManagerThreadData thread_data_new;
-    thread_data_new.BlockDrag       = ((m_IsOverlayActive) && (ConfigManager::GetValue(configid_int_windows_winrt_dragging_mode) != window_dragging_none));
-    thread_data_new.DoOverlayDrag   = ((m_IsOverlayActive) && (ConfigManager::GetValue(configid_int_windows_winrt_dragging_mode) == window_dragging_overlay));
-    thread_data_new.KeepOnScreen    = ((m_IsOverlayActive) && (ConfigManager::GetValue(configid_bool_windows_winrt_keep_on_screen)));
+    thread_data_new.IsOverlayActive = m_IsOverlayActive;
     thread_data_new.TargetWindow    = m_TargetWindow;
     thread_data_new.TargetOverlayID = m_TargetOverlayID;
 
+    const uint64_t config_version = ConfigManager::GetSnapshot()->Version;
+
     if (m_IsActive)
     {
         //Create WindowManager thread if there is none
@@ -338,6 +342,7 @@ void WindowManager::UpdateConfigState()
             WindowListInit();
 
             m_ThreadData = thread_data_new; //No need to lock since no other thread exists to race with
+            m_ThreadConfigVersion = config_version;
             m_ThreadHandle = ::CreateThread(nullptr, 0, WindowManagerThreadEntry, nullptr, 0, &m_ThreadID);
         }
         else if (m_ThreadData != thread_data_new) //If just data has changed, update existing thread
@@ -360,6 +365,13 @@ void WindowManager::UpdateConfigState()
                 std::unique_lock<std::mutex> lock(m_UpdateDoneMutex);
                 m_UpdateDoneCV.wait_for(lock, std::chrono::milliseconds(500), [&]{ return m_UpdateDoneFlag; });
             }
+
+            m_ThreadConfigVersion = config_version;     //Picked up the snapshot during the update
+        }
+        else if (m_ThreadConfigVersion != config_version) //If only config has changed, let the thread pick it up on its own without waiting for it
+        {
+            ::PostThreadMessage(m_ThreadID, WM_WINDOWMANAGER_UPDATE_CONFIG, 0, 0);
+            m_ThreadConfigVersion = config_version;
         }
     }
     else //If thread is no longer needed, remove it
@@ -1026,6 +1038,16 @@ void WindowManager::WindowManager::WinEventProc(HWINEVENTHOOK /*event_hook_handl
     Get().HandleWinEvent(win_event, hwnd, id_object, id_child, event_thread, event_time);
 }
 
+void WindowManager::ApplyConfigSnapshot()
+{
+    std::shared_ptr<const ConfigSnapshot> config = ConfigManager::GetSnapshot();
+    const bool is_overlay_active = m_ThreadLocalData.IsOverlayActive;
+
+    m_ThreadLocalData.BlockDrag     = ((is_overlay_active) && (config->GetValue(configid_int_windows_winrt_dragging_mode) != window_dragging_none));
+    m_ThreadLocalData.DoOverlayDrag = ((is_overlay_active) && (config->GetValue(configid_int_windows_winrt_dragging_mode) == window_dragging_overlay));
+    m_ThreadLocalData.KeepOnScreen  = ((is_overlay_active) && (config->GetValue(configid_bool_windows_winrt_keep_on_screen)));
+}
+
 void WindowManager::ManageEventHooks(HWINEVENTHOOK& hook_handle_move_size, HWINEVENTHOOK& hook_handle_location_change, HWINEVENTHOOK& hook_handle_foreground, HWINEVENTHOOK& hook_handle_destroy_show,
                                      HWINEVENTHOOK& hook_handle_caret)
 {
@@ -1096,6 +1118,8 @@ DWORD WindowManager::WindowManagerThreadEntry(void* /*param*/)
         wman.m_ThreadLocalData = wman.m_ThreadData;
     }
 
+    Get().ApplyConfigSnapshot();
+
     //Create event hooks
     HWINEVENTHOOK hook_handle_move_size       = nullptr;
     HWINEVENTHOOK hook_handle_location_change = nullptr;
@@ -1129,6 +1153,7 @@ DWORD WindowManager::WindowManagerThreadEntry(void* /*param*/)
                 wman.m_ThreadLocalData = wman.m_ThreadData;
             }
 
+            wman.ApplyConfigSnapshot();
             wman.ManageEventHooks(hook_handle_move_size, hook_handle_location_change, hook_handle_foreground, hook_handle_destroy_show, hook_handle_caret);
 
             //Notify main thread we're done
@@ -1142,6 +1167,13 @@ DWORD WindowManager::WindowManagerThreadEntry(void* /*param*/)
         {
             Get().HandleTextInputMouseClick();
         }
+        else if (msg.message == WM_WINDOWMANAGER_UPDATE_CONFIG)
+        {
+            WindowManager& wman = Get();
+
+            wman.ApplyConfigSnapshot();
+            wman.ManageEventHooks(hook_handle_move_size, hook_handle_location_change, hook_handle_foreground, hook_handle_destroy_show, hook_handle_caret);
+        }
     }
 
     ::UnhookWinEvent(hook_handle_move_size);
@@ -40,18 +40,19 @@ class WindowInfo
 
 struct WindowManagerThreadData
 {
+    bool IsOverlayActive = false;
+    HWND TargetWindow = nullptr;
+    unsigned int TargetOverlayID = UINT_MAX;
+
+    //Set by the WindowManager thread from the current config snapshot, not compared
     bool BlockDrag = false;
     bool DoOverlayDrag = false;
     bool KeepOnScreen = false;
-    HWND TargetWindow = nullptr;
-    unsigned int TargetOverlayID = UINT_MAX;
 
     bool operator==(const WindowManagerThreadData b)
     {
-        return ( (BlockDrag       == b.BlockDrag)     &&
-                 (DoOverlayDrag   == b.DoOverlayDrag) &&
-                 (KeepOnScreen    == b.KeepOnScreen)  &&
-                 (TargetWindow    == b.TargetWindow)  &&
+        return ( (IsOverlayActive == b.IsOverlayActive) &&
+                 (TargetWindow    == b.TargetWindow)    &&
                  (TargetOverlayID == b.TargetOverlayID) );
     }
     bool operator!=(const WindowManagerThreadData b)
@@ -70,7 +71,7 @@ class WindowManager
         static WindowManager& Get();
 
         //- Only called by main thread
-        void UpdateConfigState();                                                                //Updates config state from ConfigManager for the WindowManager thread
+        void UpdateConfigState();                                                                //Publishes config changes and updates state for the WindowManager thread. Only blocks if target window or overlay state changed
         void SetTargetWindow(HWND window, unsigned int overlay_id = UINT_MAX);                   //Sets target window and overlay id for the WindowManager thread
         HWND GetTargetWindow() const;
         void SetActive(bool is_active);                                                          //Set active state for the window manager. Threads are destroyed when it's inactive
@@ -102,6 +103,7 @@ class WindowManager
         DWORD m_ThreadID               = 0;
         HWND m_TargetWindow            = nullptr;
         unsigned int m_TargetOverlayID = UINT_MAX;
+        uint64_t m_ThreadConfigVersion = 0;         //Version of the last config snapshot the WindowManager thread was told about
 
         bool m_IsActive        = false;
         bool m_IsOverlayActive = false;
@@ -144,6 +146,7 @@ class WindowManager
         void HandleWinEvent(DWORD win_event, HWND hwnd, LONG id_object, LONG id_child, DWORD event_thread, DWORD event_time);
         void HandleCaretWinEvent(DWORD win_event, HWND hwnd);
         void HandleTextInputMouseClick();
+        void ApplyConfigSnapshot();                                                             //Updates config-dependent parts of m_ThreadLocalData from the current snapshot
 
         static void CALLBACK WinEventProc(HWINEVENTHOOK event_hook_handle, DWORD win_event, HWND hwnd, LONG id_object, LONG id_child, DWORD event_thread, DWORD event_time);
         void ManageEventHooks(HWINEVENTHOOK& hook_handle_move_size, HWINEVENTHOOK& hook_handle_location_change, HWINEVENTHOOK& hook_handle_foreground, HWINEVENTHOOK& hook_handle_destroy_show,